@@ -1,5 +1,8 @@
 // SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+#include <chrono>
 #include <fstream>
+#include <limits>
 
 #include "kompute/Algorithm.hpp"
 
@@ -15,9 +18,13 @@ Algorithm::~Algorithm()
 bool
 Algorithm::isInit()
 {
+    this->finishBuild();
+
+    // Descriptor sets of a descriptor allocator have no pool of their own
     return this->mPipeline && this->mPipelineCache && this->mPipelineLayout &&
-           this->mDescriptorPool && this->mDescriptorSet &&
-           this->mDescriptorSetLayout && this->mShaderModule;
+           (this->mDescriptorPool || this->mDescriptorAllocator) &&
+           this->mDescriptorSet && this->mDescriptorSetLayout &&
+           this->mShaderModule;
 }
 
 void
@@ -31,12 +38,29 @@ Algorithm::destroy()
     //     free(this->mSpecializationConstantsData);
     // }
 
+    this->finishBuild();
+
     if (!this->mDevice) {
         KP_LOG_WARN("Kompute Algorithm destroy function reached with null "
                     "Device pointer");
         return;
     }
 
+    // Shared pipeline resources are destroyed with the last algorithm that
+    // uses these
+    if (this->mSharedPipeline) {
+        KP_LOG_DEBUG("Kompute Algorithm releasing shared pipeline");
+        this->mPipeline = nullptr;
+        this->mPipelineLayout = nullptr;
+        this->mShaderModule = nullptr;
+        // The layout is owned when the shared pipeline was created by an
+        // algorithm that took its layout from a descriptor allocator
+        if (!this->mFreeDescriptorSetLayout) {
+            this->mDescriptorSetLayout = nullptr;
+        }
+        this->mSharedPipeline = nullptr;
+    }
+
     if (this->mFreePipeline && this->mPipeline) {
         KP_LOG_DEBUG("Kompute Algorithm Destroying pipeline");
         if (!this->mPipeline) {
@@ -85,6 +109,24 @@ Algorithm::destroy()
         this->mShaderModule = nullptr;
     }
 
+    // Descriptor sets of the allocator are recycled for the next algorithms
+    if (this->mDescriptorSet && !this->mDescriptorPool &&
+        this->mDescriptorAllocator) {
+        KP_LOG_DEBUG("Kompute Algorithm releasing descriptor set");
+        this->mDescriptorAllocator->release(this->mTensorDescriptorCounts,
+                                            *this->mDescriptorSet);
+        this->mDescriptorSet = nullptr;
+    }
+    {
+        std::lock_guard<std::mutex> lock(this->mSubmissionMutex);
+        for (const auto& retired : this->mRetiredDescriptorSets) {
+            this->mDescriptorAllocator->release(this->mTensorDescriptorCounts,
+                                                retired.second);
+        }
+        this->mRetiredDescriptorSets.clear();
+        this->mPendingSubmissions.clear();
+    }
+
     // We don't call freeDescriptorSet as the descriptor pool is not created
     // with VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT more at
     // (https://www.khronos.org/registry/vulkan/specs/1.0/html/vkspec.html#VUID-vkFreeDescriptorSets-descriptorPool-00312))
@@ -124,36 +166,141 @@ Algorithm::destroy()
     }
 }
 
+bool
+Algorithm::isBuilt()
+{
+    return !this->mBuild.valid() ||
+           this->mBuild.wait_for(std::chrono::seconds(0)) ==
+             std::future_status::ready;
+}
+
 void
-Algorithm::createParameters()
+Algorithm::wait()
 {
-    KP_LOG_DEBUG("Kompute Algorithm createParameters started");
+    if (this->mBuild.valid()) {
+        this->mBuild.get();
+    }
+}
 
-    std::vector<vk::DescriptorPoolSize> descriptorPoolSizes = {
-        vk::DescriptorPoolSize(
-          vk::DescriptorType::eStorageBuffer,
-          static_cast<uint32_t>(this->mTensors.size()) // Descriptor count
-          )
+void
+Algorithm::finishBuild()
+{
+    if (this->mBuild.valid()) {
+        this->mBuild.wait();
+    }
+}
+
+void
+Algorithm::createPipelineResources()
+{
+    KP_LOG_DEBUG("Kompute Algorithm createPipelineResources started");
+
+    // Tensors larger than the maxStorageBufferRange are bound as an array of
+    // descriptors
+    this->mTensorDescriptorCounts.clear();
+    for (const std::shared_ptr<Tensor>& tensor : this->mTensors) {
+        this->mTensorDescriptorCounts.push_back(tensor->descriptorCount());
+    }
+
+    if (!this->mSharedPipelineCache ||
+        !this->mSharedPipelineCache->getVkPipelineCache()) {
+        this->createDescriptorSetLayout();
+        this->createShaderModule();
+        this->createPipeline();
+        return;
+    }
+
+    std::string key = this->pipelineKey();
+    std::shared_ptr<PipelineCache::SharedPipeline> sharedPipeline =
+      this->mSharedPipelineCache->findPipeline(key);
+
+    if (!sharedPipeline) {
+        this->createDescriptorSetLayout();
+        this->createShaderModule();
+        this->createPipeline();
+
+        // The shared pipeline takes ownership of the resources, which are
+        // discarded if another thread created the same pipeline meanwhile.
+        // Layouts of the descriptor allocator are destroyed with it instead
+        sharedPipeline = this->mSharedPipelineCache->addPipeline(
+          key,
+          std::make_shared<PipelineCache::SharedPipeline>(
+            this->mDevice,
+            this->mFreeDescriptorSetLayout ? this->mDescriptorSetLayout
+                                           : nullptr,
+            this->mShaderModule,
+            this->mPipelineLayout,
+            this->mPipeline));
+    } else {
+        KP_LOG_DEBUG("Kompute Algorithm reusing shared pipeline");
+    }
+
+    this->mSharedPipeline = sharedPipeline;
+    if (sharedPipeline->descriptorSetLayout) {
+        this->mDescriptorSetLayout = sharedPipeline->descriptorSetLayout;
+        this->mFreeDescriptorSetLayout = false;
+    } else {
+        this->createDescriptorSetLayout();
+    }
+    this->mShaderModule = sharedPipeline->shaderModule;
+    this->mFreeShaderModule = false;
+    this->mPipelineLayout = sharedPipeline->pipelineLayout;
+    this->mFreePipelineLayout = false;
+    this->mPipeline = sharedPipeline->pipeline;
+    this->mFreePipeline = false;
+    this->mPipelineCache = this->mSharedPipelineCache->getVkPipelineCache();
+    this->mFreePipelineCache = false;
+}
+
+std::string
+Algorithm::pipelineKey()
+{
+    // The bytes of everything the pipeline and its layouts are created from
+    std::string key;
+    key.append((const char*)this->mSpirv.data(),
+               this->mSpirv.size() * sizeof(uint32_t));
+
+    uint32_t specializationConstantsMemorySize =
+      this->mSpecializationConstantsDataTypeMemorySize *
+      this->mSpecializationConstantsSize;
+    uint32_t pushConstantsMemorySize =
+      this->mPushConstantsDataTypeMemorySize * this->mPushConstantsSize;
+    uint32_t bindingCount = this->mTensorDescriptorCounts.size();
+    std::vector<uint32_t> sizes = {
+        this->mSpecializationConstantsDataTypeMemorySize,
+        this->mSpecializationConstantsSize,
+        pushConstantsMemorySize,
+        bindingCount
     };
+    sizes.insert(sizes.end(),
+                 this->mTensorDescriptorCounts.begin(),
+                 this->mTensorDescriptorCounts.end());
+    key.append((const char*)sizes.data(), sizes.size() * sizeof(uint32_t));
+
+    if (specializationConstantsMemorySize) {
+        key.append((const char*)this->mSpecializationConstantsData,
+                   specializationConstantsMemorySize);
+    }
 
-    vk::DescriptorPoolCreateInfo descriptorPoolInfo(
-      vk::DescriptorPoolCreateFlags(),
-      1, // Max sets
-      static_cast<uint32_t>(descriptorPoolSizes.size()),
-      descriptorPoolSizes.data());
+    return key;
+}
 
-    KP_LOG_DEBUG("Kompute Algorithm creating descriptor pool");
-    this->mDescriptorPool = std::make_shared<vk::DescriptorPool>();
-    this->mDevice->createDescriptorPool(
-      &descriptorPoolInfo, nullptr, this->mDescriptorPool.get());
-    this->mFreeDescriptorPool = true;
+void
+Algorithm::createDescriptorSetLayout()
+{
+    if (this->mDescriptorAllocator) {
+        this->mDescriptorSetLayout =
+          this->mDescriptorAllocator->layout(this->mTensorDescriptorCounts);
+        this->mFreeDescriptorSetLayout = false;
+        return;
+    }
 
     std::vector<vk::DescriptorSetLayoutBinding> descriptorSetBindings;
     for (size_t i = 0; i < this->mTensors.size(); i++) {
         descriptorSetBindings.push_back(
           vk::DescriptorSetLayoutBinding(i, // Binding index
                                          vk::DescriptorType::eStorageBuffer,
-                                         1, // Descriptor count
+                                         this->mTensorDescriptorCounts[i],
                                          vk::ShaderStageFlagBits::eCompute));
     }
 
@@ -168,6 +315,47 @@ Algorithm::createParameters()
     this->mDevice->createDescriptorSetLayout(
       &descriptorSetLayoutInfo, nullptr, this->mDescriptorSetLayout.get());
     this->mFreeDescriptorSetLayout = true;
+}
+
+void
+Algorithm::createParameters()
+{
+    KP_LOG_DEBUG("Kompute Algorithm createParameters started");
+
+    if (this->mDescriptorAllocator) {
+        KP_LOG_DEBUG("Kompute Algorithm allocating descriptor set from "
+                     "descriptor allocator");
+        this->mDescriptorSet = std::make_shared<vk::DescriptorSet>(
+          this->mDescriptorAllocator->allocate(this->mTensorDescriptorCounts));
+        this->mFreeDescriptorSet = false;
+
+        this->mTensorGenerations.clear();
+        this->updateDescriptorSets();
+        return;
+    }
+
+    uint32_t totalDescriptorCount = 0;
+    for (uint32_t descriptorCount : this->mTensorDescriptorCounts) {
+        totalDescriptorCount += descriptorCount;
+    }
+
+    std::vector<vk::DescriptorPoolSize> descriptorPoolSizes = {
+        vk::DescriptorPoolSize(vk::DescriptorType::eStorageBuffer,
+                               totalDescriptorCount // Descriptor count
+                               )
+    };
+
+    vk::DescriptorPoolCreateInfo descriptorPoolInfo(
+      vk::DescriptorPoolCreateFlags(),
+      1, // Max sets
+      static_cast<uint32_t>(descriptorPoolSizes.size()),
+      descriptorPoolSizes.data());
+
+    KP_LOG_DEBUG("Kompute Algorithm creating descriptor pool");
+    this->mDescriptorPool = std::make_shared<vk::DescriptorPool>();
+    this->mDevice->createDescriptorPool(
+      &descriptorPoolInfo, nullptr, this->mDescriptorPool.get());
+    this->mFreeDescriptorPool = true;
 
     vk::DescriptorSetAllocateInfo descriptorSetAllocateInfo(
       *this->mDescriptorPool,
@@ -180,27 +368,150 @@ Algorithm::createParameters()
                                           this->mDescriptorSet.get());
     this->mFreeDescriptorSet = true;
 
-    KP_LOG_DEBUG("Kompute Algorithm updating descriptor sets");
+    this->mTensorGenerations.clear();
+    this->updateDescriptorSets();
+
+    KP_LOG_DEBUG("Kompute Algorithm successfully run init");
+}
+
+void
+Algorithm::updateDescriptorSets()
+{
+    this->mTensorGenerations.resize(this->mTensors.size(),
+                                    std::numeric_limits<uint64_t>::max());
+
+    if (!this->requiresDescriptorUpdate()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->mSubmissionMutex);
+        if (this->mPendingSubmissions.size()) {
+            if (!this->mDescriptorAllocator) {
+                throw std::runtime_error(
+                  "Kompute Algorithm descriptor set cannot be written while a "
+                  "submission that uses it is running");
+            }
+
+            // Running submissions keep using the current set, which is
+            // released once these complete, so all the bindings of a new set
+            // are written instead
+            KP_LOG_DEBUG("Kompute Algorithm replacing descriptor set in use");
+            this->mRetiredDescriptorSets.push_back(
+              { this->mDescriptorSetVersion, *this->mDescriptorSet });
+            this->mDescriptorSet = std::make_shared<vk::DescriptorSet>(
+              this->mDescriptorAllocator->allocate(
+                this->mTensorDescriptorCounts));
+            std::fill(this->mTensorGenerations.begin(),
+                      this->mTensorGenerations.end(),
+                      std::numeric_limits<uint64_t>::max());
+        }
+    }
+
+    this->mDescriptorSetVersion++;
+
     for (size_t i = 0; i < this->mTensors.size(); i++) {
+        // Only the tensors that were rebuilt since the last update are written
+        if (this->mTensorGenerations[i] == this->mTensors[i]->generation()) {
+            continue;
+        }
+
+        KP_LOG_DEBUG("Kompute Algorithm updating descriptor set binding {}",
+                     i);
+
         std::vector<vk::WriteDescriptorSet> computeWriteDescriptorSets;
 
-        vk::DescriptorBufferInfo descriptorBufferInfo =
-          this->mTensors[i]->constructDescriptorBufferInfo();
+        std::vector<vk::DescriptorBufferInfo> descriptorBufferInfos =
+          this->mTensors[i]->constructDescriptorBufferInfos();
+
+        // The layout fixes the size of the descriptor array of each binding
+        if (descriptorBufferInfos.size() != this->mTensorDescriptorCounts[i]) {
+            throw std::runtime_error(fmt::format(
+              "Kompute Algorithm tensor at binding {} needs {} descriptors "
+              "but the algorithm was built with {}, rebuild the algorithm",
+              i,
+              descriptorBufferInfos.size(),
+              this->mTensorDescriptorCounts[i]));
+        }
 
-        computeWriteDescriptorSets.push_back(
-          vk::WriteDescriptorSet(*this->mDescriptorSet,
-                                 i, // Destination binding
-                                 0, // Destination array element
-                                 1, // Descriptor count
-                                 vk::DescriptorType::eStorageBuffer,
-                                 nullptr, // Descriptor image info
-                                 &descriptorBufferInfo));
+        computeWriteDescriptorSets.push_back(vk::WriteDescriptorSet(
+          *this->mDescriptorSet,
+          i, // Destination binding
+          0, // Destination array element
+          static_cast<uint32_t>(descriptorBufferInfos.size()),
+          vk::DescriptorType::eStorageBuffer,
+          nullptr, // Descriptor image info
+          descriptorBufferInfos.data()));
 
         this->mDevice->updateDescriptorSets(computeWriteDescriptorSets,
                                             nullptr);
+
+        this->mTensorGenerations[i] = this->mTensors[i]->generation();
     }
+}
 
-    KP_LOG_DEBUG("Kompute Algorithm successfully run init");
+bool
+Algorithm::requiresDescriptorUpdate()
+{
+    if (this->mTensorGenerations.size() != this->mTensors.size()) {
+        return true;
+    }
+    for (size_t i = 0; i < this->mTensors.size(); i++) {
+        if (this->mTensorGenerations[i] != this->mTensors[i]->generation()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t
+Algorithm::descriptorSetVersion()
+{
+    return this->mDescriptorSetVersion;
+}
+
+void
+Algorithm::beginSubmission(uint64_t descriptorSetVersion)
+{
+    std::lock_guard<std::mutex> lock(this->mSubmissionMutex);
+
+    this->mPendingSubmissions[descriptorSetVersion]++;
+}
+
+void
+Algorithm::endSubmission(uint64_t descriptorSetVersion)
+{
+    std::lock_guard<std::mutex> lock(this->mSubmissionMutex);
+
+    auto it = this->mPendingSubmissions.find(descriptorSetVersion);
+    if (it != this->mPendingSubmissions.end() && --it->second == 0) {
+        this->mPendingSubmissions.erase(it);
+    }
+
+    this->releaseRetiredDescriptorSets();
+}
+
+void
+Algorithm::releaseRetiredDescriptorSets()
+{
+    // A set is used by the submissions recorded up to the last version it
+    // was current for
+    uint64_t oldestPendingVersion = std::numeric_limits<uint64_t>::max();
+    if (this->mPendingSubmissions.size()) {
+        oldestPendingVersion = this->mPendingSubmissions.begin()->first;
+    }
+
+    auto it = this->mRetiredDescriptorSets.begin();
+    while (it != this->mRetiredDescriptorSets.end()) {
+        if (it->first < oldestPendingVersion) {
+            KP_LOG_DEBUG("Kompute Algorithm releasing replaced descriptor set");
+            this->mDescriptorAllocator->release(this->mTensorDescriptorCounts,
+                                                it->second);
+            it = this->mRetiredDescriptorSets.erase(it);
+        } else {
+            ++it;
+        }
+    }
 }
 
 void
@@ -284,12 +595,21 @@ Algorithm::createPipeline()
                                                vk::Pipeline(),
                                                0);
 
-    vk::PipelineCacheCreateInfo pipelineCacheInfo =
-      vk::PipelineCacheCreateInfo();
-    this->mPipelineCache = std::make_shared<vk::PipelineCache>();
-    this->mDevice->createPipelineCache(
-      &pipelineCacheInfo, nullptr, this->mPipelineCache.get());
-    this->mFreePipelineCache = true;
+    // Pipelines compiled into a shared cache are reused by other algorithms
+    // and rebuilds that create the same pipeline
+    if (this->mSharedPipelineCache &&
+        this->mSharedPipelineCache->getVkPipelineCache()) {
+        this->mPipelineCache =
+          this->mSharedPipelineCache->getVkPipelineCache();
+        this->mFreePipelineCache = false;
+    } else {
+        vk::PipelineCacheCreateInfo pipelineCacheInfo =
+          vk::PipelineCacheCreateInfo();
+        this->mPipelineCache = std::make_shared<vk::PipelineCache>();
+        this->mDevice->createPipelineCache(
+          &pipelineCacheInfo, nullptr, this->mPipelineCache.get());
+        this->mFreePipelineCache = true;
+    }
 
 #ifdef KOMPUTE_CREATE_PIPELINE_RESULT_VALUE
     vk::ResultValue<vk::Pipeline> pipelineResult =
@@ -323,6 +643,13 @@ Algorithm::createPipeline()
 void
 Algorithm::recordBindCore(const vk::CommandBuffer& commandBuffer)
 {
+    // Algorithms that are still being built are recorded once built
+    this->wait();
+
+    // Tensors rebuilt since the descriptors were written keep their bindings
+    // but may have a new buffer or size
+    this->updateDescriptorSets();
+
     KP_LOG_DEBUG("Kompute Algorithm binding pipeline");
 
     commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute,
@@ -365,7 +692,7 @@ Algorithm::recordDispatch(const vk::CommandBuffer& commandBuffer)
 }
 
 void
-Algorithm::setWorkgroup(const Workgroup& workgroup, uint32_t minSize)
+Algorithm::setWorkgroup(const Workgroup& workgroup, uint64_t minSize)
 {
 
     KP_LOG_INFO("Kompute OpAlgoCreate setting dispatch size");
@@ -379,7 +706,13 @@ Algorithm::setWorkgroup(const Workgroup& workgroup, uint32_t minSize)
                              workgroup[1] > 0 ? workgroup[1] : 1,
                              workgroup[2] > 0 ? workgroup[2] : 1 };
     } else {
-        this->mWorkgroup = { minSize, 1, 1 };
+        if (minSize > std::numeric_limits<uint32_t>::max()) {
+            throw std::runtime_error(fmt::format(
+              "Kompute Algorithm default workgroup of {} exceeds the maximum "
+              "dispatch size, an explicit workgroup has to be provided",
+              minSize));
+        }
+        this->mWorkgroup = { (uint32_t)minSize, 1, 1 };
     }
 
     KP_LOG_INFO("Kompute OpAlgoCreate set dispatch size X: {}, Y: {}, Z: {}",
@@ -400,4 +733,48 @@ Algorithm::getTensors()
     return this->mTensors;
 }
 
+void
+Algorithm::setTensors(const std::vector<std::shared_ptr<Tensor>>& tensors)
+{
+    KP_LOG_DEBUG("Kompute Algorithm setTensors with {} tensors",
+                 tensors.size());
+
+    if (!this->isInit()) {
+        throw std::runtime_error(
+          "Kompute Algorithm setTensors called on an algorithm that is not "
+          "initialised");
+    }
+
+    bool sameLayout = tensors.size() == this->mTensorDescriptorCounts.size();
+    for (size_t i = 0; sameLayout && i < tensors.size(); i++) {
+        sameLayout =
+          tensors[i]->descriptorCount() == this->mTensorDescriptorCounts[i];
+    }
+
+    if (!sameLayout) {
+        std::lock_guard<std::mutex> lock(this->mSubmissionMutex);
+        if (this->mPendingSubmissions.size()) {
+            throw std::runtime_error(
+              "Kompute Algorithm setTensors cannot change the bindings while a "
+              "submission that uses the algorithm is running");
+        }
+    }
+
+    this->mTensors = tensors;
+
+    if (sameLayout) {
+        // All the bindings are written on the next update
+        this->mTensorGenerations.clear();
+        this->updateDescriptorSets();
+        return;
+    }
+
+    KP_LOG_DEBUG("Kompute Algorithm setTensors bindings changed so the "
+                 "pipeline is created again");
+
+    this->destroy();
+    this->createPipelineResources();
+    this->createParameters();
+}
+
 }
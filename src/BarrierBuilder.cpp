@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "kompute/BarrierBuilder.hpp"
+
+namespace kp {
+
+BarrierBuilder&
+BarrierBuilder::addMemoryBarrier(vk::PipelineStageFlags srcStageMask,
+                                 vk::PipelineStageFlags dstStageMask,
+                                 const vk::MemoryBarrier& memoryBarrier)
+{
+    this->stageBarriers(srcStageMask, dstStageMask)
+      .memoryBarriers.push_back(memoryBarrier);
+    return *this;
+}
+
+BarrierBuilder&
+BarrierBuilder::addBufferMemoryBarrier(
+  vk::PipelineStageFlags srcStageMask,
+  vk::PipelineStageFlags dstStageMask,
+  const vk::BufferMemoryBarrier& bufferMemoryBarrier)
+{
+    this->stageBarriers(srcStageMask, dstStageMask)
+      .bufferMemoryBarriers.push_back(bufferMemoryBarrier);
+    return *this;
+}
+
+void
+BarrierBuilder::record(const vk::CommandBuffer& commandBuffer)
+{
+    for (const StageBarriers& stageBarriers : this->mStageBarriers) {
+        KP_LOG_DEBUG("Kompute BarrierBuilder recording pipeline barrier with "
+                     "{} memory and {} buffer memory barriers",
+                     stageBarriers.memoryBarriers.size(),
+                     stageBarriers.bufferMemoryBarriers.size());
+
+        commandBuffer.pipelineBarrier(stageBarriers.srcStageMask,
+                                      stageBarriers.dstStageMask,
+                                      vk::DependencyFlags(),
+                                      stageBarriers.memoryBarriers,
+                                      stageBarriers.bufferMemoryBarriers,
+                                      nullptr);
+    }
+
+    this->clear();
+}
+
+void
+BarrierBuilder::clear()
+{
+    this->mStageBarriers.clear();
+}
+
+bool
+BarrierBuilder::empty()
+{
+    return this->mStageBarriers.empty();
+}
+
+uint32_t
+BarrierBuilder::pipelineBarrierCount()
+{
+    return this->mStageBarriers.size();
+}
+
+uint32_t
+BarrierBuilder::bufferMemoryBarrierCount()
+{
+    uint32_t count = 0;
+    for (const StageBarriers& stageBarriers : this->mStageBarriers) {
+        count += stageBarriers.bufferMemoryBarriers.size();
+    }
+    return count;
+}
+
+BarrierBuilder::StageBarriers&
+BarrierBuilder::stageBarriers(vk::PipelineStageFlags srcStageMask,
+                              vk::PipelineStageFlags dstStageMask)
+{
+    for (StageBarriers& stageBarriers : this->mStageBarriers) {
+        if (stageBarriers.srcStageMask == srcStageMask &&
+            stageBarriers.dstStageMask == dstStageMask) {
+            return stageBarriers;
+        }
+    }
+
+    this->mStageBarriers.push_back({ srcStageMask, dstStageMask, {}, {} });
+    return this->mStageBarriers.back();
+}
+
+} // End namespace kp
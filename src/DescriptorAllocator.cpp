@@ -0,0 +1,235 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <numeric>
+
+#include "kompute/DescriptorAllocator.hpp"
+
+namespace kp {
+
+DescriptorAllocator::DescriptorAllocator(std::shared_ptr<vk::Device> device,
+                                         uint32_t setsPerPool,
+                                         uint32_t descriptorsPerSet)
+{
+    KP_LOG_DEBUG("Kompute DescriptorAllocator constructor with {} sets per "
+                 "pool",
+                 setsPerPool);
+
+    if (!device) {
+        throw std::runtime_error("Kompute DescriptorAllocator device is null");
+    }
+    if (setsPerPool == 0 || descriptorsPerSet == 0) {
+        throw std::runtime_error("Kompute DescriptorAllocator pools have to "
+                                 "hold at least one set and descriptor");
+    }
+
+    this->mDevice = device;
+    this->mSetsPerPool = setsPerPool;
+    this->mDescriptorsPerSet = descriptorsPerSet;
+}
+
+DescriptorAllocator::~DescriptorAllocator()
+{
+    KP_LOG_DEBUG("Kompute DescriptorAllocator destructor started");
+
+    if (this->mDevice) {
+        this->destroy();
+    }
+}
+
+std::shared_ptr<vk::DescriptorSetLayout>
+DescriptorAllocator::layout(const std::vector<uint32_t>& descriptorCounts)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    return this->findLayout(descriptorCounts);
+}
+
+std::shared_ptr<vk::DescriptorSetLayout>
+DescriptorAllocator::findLayout(const std::vector<uint32_t>& descriptorCounts)
+{
+    if (!this->mDevice) {
+        throw std::runtime_error(
+          "Kompute DescriptorAllocator attempted to use layout after destroy");
+    }
+
+    auto it = this->mLayouts.find(descriptorCounts);
+    if (it != this->mLayouts.end()) {
+        return it->second;
+    }
+
+    KP_LOG_DEBUG("Kompute DescriptorAllocator creating layout with {} "
+                 "bindings",
+                 descriptorCounts.size());
+
+    std::vector<vk::DescriptorSetLayoutBinding> descriptorSetBindings;
+    for (size_t i = 0; i < descriptorCounts.size(); i++) {
+        descriptorSetBindings.push_back(
+          vk::DescriptorSetLayoutBinding(i, // Binding index
+                                         vk::DescriptorType::eStorageBuffer,
+                                         descriptorCounts[i],
+                                         vk::ShaderStageFlagBits::eCompute));
+    }
+
+    vk::DescriptorSetLayoutCreateInfo descriptorSetLayoutInfo(
+      vk::DescriptorSetLayoutCreateFlags(),
+      static_cast<uint32_t>(descriptorSetBindings.size()),
+      descriptorSetBindings.data());
+
+    std::shared_ptr<vk::DescriptorSetLayout> descriptorSetLayout =
+      std::make_shared<vk::DescriptorSetLayout>();
+    this->mDevice->createDescriptorSetLayout(
+      &descriptorSetLayoutInfo, nullptr, descriptorSetLayout.get());
+
+    this->mLayouts[descriptorCounts] = descriptorSetLayout;
+    return descriptorSetLayout;
+}
+
+vk::DescriptorSet
+DescriptorAllocator::allocate(const std::vector<uint32_t>& descriptorCounts)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    auto available = this->mAvailableSets.find(descriptorCounts);
+    if (available != this->mAvailableSets.end() &&
+        available->second.size()) {
+        vk::DescriptorSet descriptorSet = available->second.back();
+        available->second.pop_back();
+        return descriptorSet;
+    }
+
+    std::shared_ptr<vk::DescriptorSetLayout> descriptorSetLayout =
+      this->findLayout(descriptorCounts);
+
+    uint32_t descriptorCount = std::accumulate(
+      descriptorCounts.begin(), descriptorCounts.end(), (uint32_t)0);
+
+    // Sets are recycled rather than freed, so only the last pool can have
+    // space left and a new pool is created once it is exhausted
+    for (uint32_t attempt = 0; attempt < 2; attempt++) {
+        if (this->mPools.size()) {
+            vk::DescriptorSetAllocateInfo descriptorSetAllocateInfo(
+              this->mPools.back(),
+              1, // Descriptor set layout count
+              descriptorSetLayout.get());
+
+            vk::DescriptorSet descriptorSet;
+            vk::Result result = this->mDevice->allocateDescriptorSets(
+              &descriptorSetAllocateInfo, &descriptorSet);
+
+            if (result == vk::Result::eSuccess) {
+                return descriptorSet;
+            }
+            if (result != vk::Result::eErrorOutOfPoolMemory &&
+                result != vk::Result::eErrorFragmentedPool) {
+                throw std::runtime_error(
+                  "Kompute DescriptorAllocator failed to allocate descriptor "
+                  "set: " +
+                  vk::to_string(result));
+            }
+        }
+
+        this->createPool(descriptorCount);
+    }
+
+    throw std::runtime_error(
+      "Kompute DescriptorAllocator failed to allocate descriptor set from a "
+      "new pool");
+}
+
+void
+DescriptorAllocator::release(const std::vector<uint32_t>& descriptorCounts,
+                             vk::DescriptorSet descriptorSet)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    // Sets released after destroy were freed with their pool
+    if (!this->mDevice) {
+        return;
+    }
+
+    this->mAvailableSets[descriptorCounts].push_back(descriptorSet);
+}
+
+void
+DescriptorAllocator::createPool(uint32_t descriptorCount)
+{
+    KP_LOG_DEBUG("Kompute DescriptorAllocator creating descriptor pool {}",
+                 this->mPools.size());
+
+    // Sets with more descriptors than a pool holds get a larger pool
+    std::vector<vk::DescriptorPoolSize> descriptorPoolSizes = {
+        vk::DescriptorPoolSize(
+          vk::DescriptorType::eStorageBuffer,
+          std::max(this->mSetsPerPool * this->mDescriptorsPerSet,
+                   descriptorCount))
+    };
+
+    vk::DescriptorPoolCreateInfo descriptorPoolInfo(
+      vk::DescriptorPoolCreateFlags(),
+      this->mSetsPerPool, // Max sets
+      static_cast<uint32_t>(descriptorPoolSizes.size()),
+      descriptorPoolSizes.data());
+
+    vk::DescriptorPool descriptorPool;
+    this->mDevice->createDescriptorPool(
+      &descriptorPoolInfo, nullptr, &descriptorPool);
+    this->mPools.push_back(descriptorPool);
+}
+
+void
+DescriptorAllocator::destroy()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        KP_LOG_WARN("Kompute DescriptorAllocator destroy called with null "
+                    "Device pointer");
+        return;
+    }
+
+    KP_LOG_DEBUG("Kompute DescriptorAllocator destroying {} pools and {} "
+                 "layouts",
+                 this->mPools.size(),
+                 this->mLayouts.size());
+
+    // Destroying the pools frees all the sets allocated from these
+    for (const vk::DescriptorPool& descriptorPool : this->mPools) {
+        this->mDevice->destroy(
+          descriptorPool,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    }
+    this->mPools.clear();
+    this->mAvailableSets.clear();
+
+    for (const auto& layout : this->mLayouts) {
+        this->mDevice->destroy(
+          *layout.second,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    }
+    this->mLayouts.clear();
+
+    this->mDevice = nullptr;
+}
+
+uint32_t
+DescriptorAllocator::poolCount()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    return this->mPools.size();
+}
+
+uint32_t
+DescriptorAllocator::availableSetCount()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    uint32_t count = 0;
+    for (const auto& availableSets : this->mAvailableSets) {
+        count += availableSets.second.size();
+    }
+    return count;
+}
+
+}
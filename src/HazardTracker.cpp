@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "kompute/HazardTracker.hpp"
+
+namespace kp {
+
+static const vk::AccessFlags WRITE_ACCESS_MASK =
+  vk::AccessFlagBits::eHostWrite | vk::AccessFlagBits::eShaderWrite |
+  vk::AccessFlagBits::eTransferWrite | vk::AccessFlagBits::eMemoryWrite;
+
+// Device writes that operations recorded before the tracked ones can perform
+static const vk::PipelineStageFlags PREVIOUS_WRITE_STAGE_MASK =
+  vk::PipelineStageFlagBits::eTransfer |
+  vk::PipelineStageFlagBits::eComputeShader;
+static const vk::AccessFlags PREVIOUS_WRITE_ACCESS_MASK =
+  vk::AccessFlagBits::eTransferWrite | vk::AccessFlagBits::eShaderWrite;
+
+HazardTracker::Barriers
+HazardTracker::track(const std::vector<TensorAccess>& accesses)
+{
+    Barriers barriers;
+
+    for (const TensorAccess& access : accesses) {
+        if (!access.tensor) {
+            throw std::runtime_error(
+              "Kompute HazardTracker access with null tensor");
+        }
+
+        vk::BufferMemoryBarrier bufferMemoryBarrier =
+          access.tensor->constructPrimaryBufferMemoryBarrier(
+            vk::AccessFlags(), access.accessMask);
+
+        bool isWrite = bool(access.accessMask & WRITE_ACCESS_MASK);
+        vk::AccessFlags readAccessMask =
+          access.accessMask & ~WRITE_ACCESS_MASK;
+
+        size_t index = 0;
+        while (index < this->mRegions.size() &&
+               (this->mRegions[index].buffer != bufferMemoryBarrier.buffer ||
+                this->mRegions[index].offset != bufferMemoryBarrier.offset ||
+                this->mRegions[index].size != bufferMemoryBarrier.size)) {
+            index++;
+        }
+        if (index == this->mRegions.size()) {
+            Region region;
+            region.tensor = access.tensor;
+            region.buffer = bufferMemoryBarrier.buffer;
+            region.offset = bufferMemoryBarrier.offset;
+            region.size = bufferMemoryBarrier.size;
+            region.written = false;
+            this->resetRegion(region);
+            this->mRegions.push_back(region);
+        }
+
+        // Hazards with the accesses to all the regions that overlap
+        vk::PipelineStageFlags srcStageMask;
+        for (size_t i = 0; i < this->mRegions.size(); i++) {
+            const Region& region = this->mRegions[i];
+            if (region.buffer != bufferMemoryBarrier.buffer ||
+                region.offset >= bufferMemoryBarrier.offset +
+                                   bufferMemoryBarrier.size ||
+                bufferMemoryBarrier.offset >= region.offset + region.size) {
+                continue;
+            }
+
+            bool isVisible =
+              i == index &&
+              (region.visibleStageMask & access.stageMask) ==
+                access.stageMask &&
+              (region.visibleAccessMask & readAccessMask) == readAccessMask;
+            if (isWrite && region.readStageMask) {
+                // The reads were already synchronised with the last write
+                srcStageMask |= region.readStageMask;
+            } else if (region.writeAccessMask && (isWrite || !isVisible)) {
+                srcStageMask |= region.writeStageMask;
+                bufferMemoryBarrier.srcAccessMask |= region.writeAccessMask;
+            }
+        }
+
+        if (srcStageMask) {
+            barriers.srcStageMask |= srcStageMask;
+            barriers.dstStageMask |= access.stageMask;
+            barriers.bufferMemoryBarriers.push_back(bufferMemoryBarrier);
+        }
+
+        Region& region = this->mRegions[index];
+        if (isWrite) {
+            region.written = true;
+            region.writeStageMask = access.stageMask;
+            region.writeAccessMask = access.accessMask & WRITE_ACCESS_MASK;
+            region.readStageMask = vk::PipelineStageFlags();
+            region.visibleStageMask = vk::PipelineStageFlags();
+            region.visibleAccessMask = vk::AccessFlags();
+        } else {
+            region.readStageMask |= access.stageMask;
+            region.visibleStageMask |= access.stageMask;
+            region.visibleAccessMask |= readAccessMask;
+        }
+    }
+
+    return barriers;
+}
+
+void
+HazardTracker::recordBarriers(const vk::CommandBuffer& commandBuffer,
+                              const std::vector<TensorAccess>& accesses)
+{
+    this->recordPipelineBarrier(commandBuffer, this->track(accesses));
+}
+
+void
+HazardTracker::recordHostBarriers(const vk::CommandBuffer& commandBuffer)
+{
+    std::vector<TensorAccess> accesses;
+    for (const Region& region : this->mRegions) {
+        if (region.written &&
+            (region.tensor->tensorType() == Tensor::TensorTypes::eHost ||
+             region.tensor->isUnifiedMemory())) {
+            accesses.push_back({ region.tensor,
+                                 vk::PipelineStageFlagBits::eHost,
+                                 vk::AccessFlagBits::eHostRead });
+        }
+    }
+
+    this->recordBarriers(commandBuffer, accesses);
+}
+
+void
+HazardTracker::clear()
+{
+    this->mRegions.clear();
+}
+
+void
+HazardTracker::invalidate()
+{
+    // Regions are kept so writes recorded earlier are still made visible to
+    // the host
+    for (Region& region : this->mRegions) {
+        this->resetRegion(region);
+    }
+}
+
+uint32_t
+HazardTracker::pipelineBarrierCount()
+{
+    return this->mPipelineBarrierCount;
+}
+
+void
+HazardTracker::resetRegion(Region& region)
+{
+    region.writeStageMask = PREVIOUS_WRITE_STAGE_MASK;
+    region.writeAccessMask = PREVIOUS_WRITE_ACCESS_MASK;
+    region.readStageMask = vk::PipelineStageFlags();
+    region.visibleStageMask = vk::PipelineStageFlags();
+    region.visibleAccessMask = vk::AccessFlags();
+}
+
+void
+HazardTracker::recordPipelineBarrier(const vk::CommandBuffer& commandBuffer,
+                                     const Barriers& barriers)
+{
+    if (barriers.bufferMemoryBarriers.empty()) {
+        return;
+    }
+
+    KP_LOG_DEBUG("Kompute HazardTracker recording {} buffer memory barriers",
+                 barriers.bufferMemoryBarriers.size());
+
+    BarrierBuilder barrierBuilder;
+    for (const vk::BufferMemoryBarrier& bufferMemoryBarrier :
+         barriers.bufferMemoryBarriers) {
+        barrierBuilder.addBufferMemoryBarrier(
+          barriers.srcStageMask, barriers.dstStageMask, bufferMemoryBarrier);
+    }
+    barrierBuilder.record(commandBuffer);
+    this->mPipelineBarrierCount++;
+}
+
+} // End namespace kp
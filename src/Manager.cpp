@@ -4,6 +4,7 @@
 #include "fmt/format.h"
 #include "kompute/logger/Logger.hpp"
 #include <fmt/core.h>
+#include <algorithm>
 #include <iterator>
 #include <set>
 #include <sstream>
@@ -67,6 +68,16 @@ Manager::Manager(std::shared_ptr<vk::Instance> instance,
 #if !KOMPUTE_OPT_LOG_LEVEL_DISABLED
     logger::setupLogger();
 #endif
+
+    if (this->mPhysicalDevice && this->mDevice) {
+        this->mMemoryPool = std::make_shared<MemoryPool>(this->mPhysicalDevice,
+                                                         this->mDevice);
+        this->mSyncPool = std::make_shared<SyncPool>(this->mDevice);
+        this->mPipelineCache = std::make_shared<PipelineCache>(
+          this->mPhysicalDevice, this->mDevice);
+        this->mDescriptorAllocator =
+          std::make_shared<DescriptorAllocator>(this->mDevice);
+    }
 }
 
 Manager::~Manager()
@@ -87,6 +98,8 @@ Manager::destroy()
         return;
     }
 
+    std::lock_guard<std::mutex> lock(this->mManagedResourcesMutex);
+
     if (this->mManageResources && this->mManagedSequences.size()) {
         KP_LOG_DEBUG("Kompute Manager explicitly running destructor for "
                      "managed sequences");
@@ -98,6 +111,27 @@ Manager::destroy()
         this->mManagedSequences.clear();
     }
 
+    if (this->mManageResources && this->mManagedBlocks.size()) {
+        KP_LOG_DEBUG("Kompute Manager explicitly freeing blocks");
+        for (const std::weak_ptr<OpBlock>& weakBlock : this->mManagedBlocks) {
+            if (std::shared_ptr<OpBlock> block = weakBlock.lock()) {
+                block->destroy();
+            }
+        }
+        this->mManagedBlocks.clear();
+    }
+
+    // Command buffers of the sequences are freed with the pools
+    if (this->mManageResources && this->mThreadCommandPools.size()) {
+        KP_LOG_DEBUG("Kompute Manager explicitly freeing command pools");
+        for (const auto& threadCommandPool : this->mThreadCommandPools) {
+            this->mDevice->destroy(
+              *threadCommandPool.second,
+              (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        }
+    }
+    this->mThreadCommandPools.clear();
+
     if (this->mManageResources && this->mManagedAlgorithms.size()) {
         KP_LOG_DEBUG("Kompute Manager explicitly freeing algorithms");
         for (const std::weak_ptr<Algorithm>& weakAlgorithm :
@@ -109,6 +143,10 @@ Manager::destroy()
         this->mManagedAlgorithms.clear();
     }
 
+    // Builds of algorithms that are not managed still run before the
+    // threads are joined
+    this->mWorkerPool = nullptr;
+
     if (this->mManageResources && this->mManagedTensors.size()) {
         KP_LOG_DEBUG("Kompute Manager explicitly freeing tensors");
         for (const std::weak_ptr<Tensor>& weakTensor : this->mManagedTensors) {
@@ -119,6 +157,54 @@ Manager::destroy()
         this->mManagedTensors.clear();
     }
 
+    // The cache is written to its file once all the pipelines were created
+    if (this->mPipelineCache) {
+        if (this->mManageResources) {
+            KP_LOG_DEBUG("Kompute Manager explicitly freeing pipeline cache");
+            this->mPipelineCache->destroy();
+        }
+        this->mPipelineCache = nullptr;
+    }
+
+    // Algorithms that are not managed still hold descriptor sets, in which
+    // case the allocator is released with the last of these
+    if (this->mDescriptorAllocator) {
+        if (this->mManageResources) {
+            KP_LOG_DEBUG(
+              "Kompute Manager explicitly freeing descriptor allocator");
+            this->mDescriptorAllocator->destroy();
+        }
+        this->mDescriptorAllocator = nullptr;
+    }
+
+    if (this->mStagingRing) {
+        if (this->mManageResources) {
+            KP_LOG_DEBUG("Kompute Manager explicitly freeing staging ring");
+            this->mStagingRing->destroy();
+        }
+        this->mStagingRing = nullptr;
+    }
+
+    // Sequences that are not managed keep a reference to the pool, which is
+    // then released with the last of these instead of freed explicitly
+    if (this->mSyncPool) {
+        if (this->mManageResources) {
+            KP_LOG_DEBUG("Kompute Manager explicitly freeing sync pool");
+            this->mSyncPool->destroy();
+        }
+        this->mSyncPool = nullptr;
+    }
+
+    // Unmanaged tensors may still hold sub-allocations, in which case the
+    // pool is released with the last reference instead of freed explicitly
+    if (this->mMemoryPool) {
+        if (this->mManageResources) {
+            KP_LOG_DEBUG("Kompute Manager explicitly freeing memory pool");
+            this->mMemoryPool->destroy();
+        }
+        this->mMemoryPool = nullptr;
+    }
+
     if (this->mFreeDevice) {
         KP_LOG_INFO("Destroying device");
         this->mDevice->destroy(
@@ -273,6 +359,7 @@ void
 Manager::clear()
 {
     if (this->mManageResources) {
+        std::lock_guard<std::mutex> lock(this->mManagedResourcesMutex);
         this->mManagedTensors.erase(
           std::remove_if(begin(this->mManagedTensors),
                          end(this->mManagedTensors),
@@ -289,6 +376,11 @@ Manager::clear()
                          end(this->mManagedSequences),
                          [](std::weak_ptr<Sequence> t) { return t.expired(); }),
           end(this->mManagedSequences));
+        this->mManagedBlocks.erase(
+          std::remove_if(begin(this->mManagedBlocks),
+                         end(this->mManagedBlocks),
+                         [](std::weak_ptr<OpBlock> t) { return t.expired(); }),
+          end(this->mManagedBlocks));
     }
 }
 
@@ -413,6 +505,41 @@ Manager::createDevice(const std::vector<uint32_t>& familyQueueIndices,
                      fmt::join(validExtensions, ", "));
     }
 
+    // Enabled whenever available so tensors can import host memory
+    std::string externalMemoryHostExtension =
+      VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME;
+    if (uniqueExtensionNames.count(externalMemoryHostExtension) != 0) {
+        if (std::find(desiredExtensions.begin(),
+                      desiredExtensions.end(),
+                      externalMemoryHostExtension) ==
+            desiredExtensions.end()) {
+            validExtensions.push_back(
+              VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME);
+        }
+        this->mExternalMemoryHostEnabled = true;
+    }
+
+    // Enabled whenever available so sequences can depend on each other
+    // without a round trip to the host
+    vk::PhysicalDeviceTimelineSemaphoreFeatures timelineSemaphoreFeatures;
+    std::string timelineSemaphoreExtension =
+      VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME;
+    if (uniqueExtensionNames.count(timelineSemaphoreExtension) != 0) {
+        vk::PhysicalDeviceFeatures2 features;
+        features.pNext = &timelineSemaphoreFeatures;
+        physicalDevice.getFeatures2(&features);
+        if (timelineSemaphoreFeatures.timelineSemaphore) {
+            if (std::find(desiredExtensions.begin(),
+                          desiredExtensions.end(),
+                          timelineSemaphoreExtension) ==
+                desiredExtensions.end()) {
+                validExtensions.push_back(
+                  VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+            }
+            this->mTimelineSemaphoreEnabled = true;
+        }
+    }
+
     vk::DeviceCreateInfo deviceCreateInfo(vk::DeviceCreateFlags(),
                                           deviceQueueCreateInfos.size(),
                                           deviceQueueCreateInfos.data(),
@@ -420,6 +547,9 @@ Manager::createDevice(const std::vector<uint32_t>& familyQueueIndices,
                                           {},
                                           validExtensions.size(),
                                           validExtensions.data());
+    if (this->mTimelineSemaphoreEnabled) {
+        deviceCreateInfo.setPNext(&timelineSemaphoreFeatures);
+    }
 
     this->mDevice = std::make_shared<vk::Device>();
     physicalDevice.createDevice(
@@ -436,9 +566,19 @@ Manager::createDevice(const std::vector<uint32_t>& familyQueueIndices,
         familyQueueIndexCount[familyQueueIndex]++;
 
         this->mComputeQueues.push_back(currQueue);
+        this->mComputeQueueMutexes.push_back(std::make_shared<std::mutex>());
     }
 
     KP_LOG_DEBUG("Kompute Manager compute queue obtained");
+
+    this->mMemoryPool =
+      std::make_shared<MemoryPool>(this->mPhysicalDevice, this->mDevice);
+    this->mSyncPool = std::make_shared<SyncPool>(
+      this->mDevice, this->mTimelineSemaphoreEnabled);
+    this->mPipelineCache =
+      std::make_shared<PipelineCache>(this->mPhysicalDevice, this->mDevice);
+    this->mDescriptorAllocator =
+      std::make_shared<DescriptorAllocator>(this->mDevice);
 }
 
 std::shared_ptr<Sequence>
@@ -446,20 +586,59 @@ Manager::sequence(uint32_t queueIndex, uint32_t totalTimestamps)
 {
     KP_LOG_DEBUG("Kompute Manager sequence() with queueIndex: {}", queueIndex);
 
+    std::shared_ptr<vk::CommandPool> commandPool = nullptr;
+    if (this->mConcurrentMode) {
+        commandPool =
+          this->threadCommandPool(this->mComputeQueueFamilyIndices[queueIndex]);
+    }
+
     std::shared_ptr<Sequence> sq{ new kp::Sequence(
       this->mPhysicalDevice,
       this->mDevice,
       this->mComputeQueues[queueIndex],
       this->mComputeQueueFamilyIndices[queueIndex],
-      totalTimestamps) };
+      totalTimestamps,
+      this->mSyncPool,
+      this->mComputeQueueMutexes[queueIndex],
+      commandPool) };
 
     if (this->mManageResources) {
+        std::lock_guard<std::mutex> lock(this->mManagedResourcesMutex);
         this->mManagedSequences.push_back(sq);
     }
 
     return sq;
 }
 
+std::shared_ptr<OpBlock>
+Manager::block(const std::vector<std::shared_ptr<OpBase>>& operations,
+               uint32_t queueIndex)
+{
+    KP_LOG_DEBUG("Kompute Manager block() with queueIndex: {}", queueIndex);
+
+    std::shared_ptr<OpBlock> block{ new kp::OpBlock(
+      this->mDevice,
+      this->mComputeQueueFamilyIndices[queueIndex],
+      operations) };
+
+    if (this->mManageResources) {
+        std::lock_guard<std::mutex> lock(this->mManagedResourcesMutex);
+        this->mManagedBlocks.push_back(block);
+    }
+
+    return block;
+}
+
+std::shared_ptr<SubmissionBatch>
+Manager::submit(const std::vector<std::shared_ptr<Sequence>>& sequences)
+{
+    KP_LOG_DEBUG("Kompute Manager submit() with {} sequences",
+                 sequences.size());
+
+    return std::make_shared<SubmissionBatch>(
+      this->mDevice, this->mSyncPool, sequences);
+}
+
 vk::PhysicalDeviceProperties
 Manager::getDeviceProperties() const
 {
@@ -478,4 +657,132 @@ Manager::getVkInstance() const
     return this->mInstance;
 }
 
+std::shared_ptr<MemoryPool>
+Manager::getMemoryPool() const
+{
+    return this->mMemoryPool;
+}
+
+void
+Manager::setMemoryPool(std::shared_ptr<MemoryPool> memoryPool)
+{
+    this->mMemoryPool = memoryPool;
+}
+
+void
+Manager::enableStagingRing(vk::DeviceSize size)
+{
+    KP_LOG_DEBUG("Kompute Manager enabling staging ring with size {}", size);
+
+    if (size == 0) {
+        this->mStagingRing = nullptr;
+        return;
+    }
+
+    this->mStagingRing =
+      std::make_shared<StagingRing>(this->mPhysicalDevice, this->mDevice, size);
+}
+
+std::shared_ptr<StagingRing>
+Manager::getStagingRing() const
+{
+    return this->mStagingRing;
+}
+
+std::shared_ptr<SyncPool>
+Manager::getSyncPool() const
+{
+    return this->mSyncPool;
+}
+
+void
+Manager::setUnifiedMemory(bool unifiedMemory)
+{
+    this->mUnifiedMemory = unifiedMemory;
+}
+
+bool
+Manager::getUnifiedMemory() const
+{
+    return this->mUnifiedMemory;
+}
+
+void
+Manager::setConcurrentMode(bool concurrentMode)
+{
+    this->mConcurrentMode = concurrentMode;
+}
+
+bool
+Manager::getConcurrentMode() const
+{
+    return this->mConcurrentMode;
+}
+
+void
+Manager::enablePersistentPipelineCache(const std::string& path)
+{
+    KP_LOG_DEBUG("Kompute Manager enabling pipeline cache file {}", path);
+
+    std::shared_ptr<PipelineCache> pipelineCache =
+      std::make_shared<PipelineCache>(
+        this->mPhysicalDevice, this->mDevice, path);
+
+    // Algorithms that still hold the previous cache create a cache of their
+    // own when rebuilt
+    if (this->mPipelineCache && this->mManageResources) {
+        this->mPipelineCache->destroy();
+    }
+    this->mPipelineCache = pipelineCache;
+}
+
+std::shared_ptr<PipelineCache>
+Manager::getPipelineCache() const
+{
+    return this->mPipelineCache;
+}
+
+std::shared_ptr<DescriptorAllocator>
+Manager::getDescriptorAllocator() const
+{
+    return this->mDescriptorAllocator;
+}
+
+std::shared_ptr<WorkerPool>
+Manager::getWorkerPool()
+{
+    std::lock_guard<std::mutex> lock(this->mManagedResourcesMutex);
+
+    if (!this->mWorkerPool) {
+        this->mWorkerPool = std::make_shared<WorkerPool>();
+    }
+    return this->mWorkerPool;
+}
+
+std::shared_ptr<vk::CommandPool>
+Manager::threadCommandPool(uint32_t queueFamilyIndex)
+{
+    std::lock_guard<std::mutex> lock(this->mManagedResourcesMutex);
+
+    std::pair<std::thread::id, uint32_t> key(std::this_thread::get_id(),
+                                             queueFamilyIndex);
+    auto it = this->mThreadCommandPools.find(key);
+    if (it != this->mThreadCommandPools.end()) {
+        return it->second;
+    }
+
+    KP_LOG_DEBUG("Kompute Manager creating command pool for queue family {}",
+                 queueFamilyIndex);
+
+    vk::CommandPoolCreateInfo commandPoolInfo(vk::CommandPoolCreateFlags(),
+                                              queueFamilyIndex);
+    std::shared_ptr<vk::CommandPool> commandPool =
+      std::make_shared<vk::CommandPool>();
+    this->mDevice->createCommandPool(
+      &commandPoolInfo, nullptr, commandPool.get());
+
+    this->mThreadCommandPools[key] = commandPool;
+    return commandPool;
+}
+
 }
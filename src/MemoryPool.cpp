@@ -0,0 +1,305 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "kompute/MemoryPool.hpp"
+
+namespace kp {
+
+MemoryPool::MemoryPool(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                       std::shared_ptr<vk::Device> device,
+                       vk::DeviceSize blockSize)
+{
+    KP_LOG_DEBUG("Kompute MemoryPool constructor with block size {}",
+                 blockSize);
+
+    if (!physicalDevice) {
+        throw std::runtime_error("Kompute MemoryPool phyisical device is null");
+    }
+    if (!device) {
+        throw std::runtime_error("Kompute MemoryPool device is null");
+    }
+
+    this->mPhysicalDevice = physicalDevice;
+    this->mDevice = device;
+    this->mBlockSize = blockSize;
+    this->mMemoryProperties = this->mPhysicalDevice->getMemoryProperties();
+}
+
+MemoryPool::~MemoryPool()
+{
+    KP_LOG_DEBUG("Kompute MemoryPool destructor started");
+
+    if (this->mDevice) {
+        this->destroy();
+    }
+
+    KP_LOG_DEBUG("Kompute MemoryPool destructor success");
+}
+
+MemoryPool::Allocation
+MemoryPool::allocate(const vk::MemoryRequirements& memoryRequirements,
+                     const vk::MemoryPropertyFlags& memoryPropertyFlags)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        throw std::runtime_error(
+          "Kompute MemoryPool attempted to allocate with null device");
+    }
+
+    int32_t memoryTypeIndex =
+      MemoryPool::findMemoryTypeIndex(this->mMemoryProperties,
+                                      memoryRequirements.memoryTypeBits,
+                                      memoryPropertyFlags);
+    if (memoryTypeIndex < 0) {
+        throw std::runtime_error(
+          "Memory type index for buffer creation not found");
+    }
+
+    uint32_t heapIndex =
+      this->mMemoryProperties.memoryTypes[memoryTypeIndex].heapIndex;
+    vk::DeviceSize blockSize =
+      std::min(this->mBlockSize,
+               this->mMemoryProperties.memoryHeaps[heapIndex].size / 8);
+
+    std::vector<std::unique_ptr<Block>>& blocks =
+      this->mBlocks[memoryTypeIndex];
+
+    Block* block = nullptr;
+    vk::DeviceSize offset = 0;
+
+    if (memoryRequirements.size > blockSize / 2) {
+        KP_LOG_DEBUG("Kompute MemoryPool creating dedicated block of size {}",
+                     memoryRequirements.size);
+        block =
+          this->createBlock(memoryTypeIndex, memoryRequirements.size, true);
+        this->suballocate(*block, memoryRequirements, offset);
+    } else {
+        for (const std::unique_ptr<Block>& candidate : blocks) {
+            if (!candidate->dedicated &&
+                this->suballocate(*candidate, memoryRequirements, offset)) {
+                block = candidate.get();
+                break;
+            }
+        }
+        if (!block) {
+            block = this->createBlock(memoryTypeIndex, blockSize, false);
+            if (!this->suballocate(*block, memoryRequirements, offset)) {
+                throw std::runtime_error(
+                  "Kompute MemoryPool failed to sub-allocate from new block");
+            }
+        }
+    }
+
+    Allocation allocation;
+    allocation.memory = block->memory;
+    allocation.offset = offset;
+    allocation.size = memoryRequirements.size;
+    allocation.memoryTypeIndex = memoryTypeIndex;
+    if (block->mappedData) {
+        allocation.mappedData = (uint8_t*)block->mappedData + offset;
+    }
+
+    KP_LOG_DEBUG("Kompute MemoryPool allocated size {} at offset {} with "
+                 "memory type index {}",
+                 allocation.size,
+                 allocation.offset,
+                 allocation.memoryTypeIndex);
+
+    return allocation;
+}
+
+void
+MemoryPool::free(const Allocation& allocation)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    auto blocksIt = this->mBlocks.find(allocation.memoryTypeIndex);
+    if (blocksIt == this->mBlocks.end()) {
+        KP_LOG_DEBUG("Kompute MemoryPool ignoring free of unknown allocation");
+        return;
+    }
+    std::vector<std::unique_ptr<Block>>& blocks = blocksIt->second;
+
+    auto blockIt = std::find_if(blocks.begin(),
+                                blocks.end(),
+                                [&allocation](const std::unique_ptr<Block>& b) {
+                                    return b->memory == allocation.memory;
+                                });
+    if (blockIt == blocks.end()) {
+        KP_LOG_DEBUG("Kompute MemoryPool ignoring free of unknown allocation");
+        return;
+    }
+    Block& block = **blockIt;
+
+    // Insert the range and coalesce with the adjacent free ranges
+    vk::DeviceSize offset = allocation.offset;
+    vk::DeviceSize size = allocation.size;
+
+    auto next = block.freeRanges.lower_bound(offset);
+    if (next != block.freeRanges.end() && offset + size == next->first) {
+        size += next->second;
+        next = block.freeRanges.erase(next);
+    }
+    if (next != block.freeRanges.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == offset) {
+            offset = prev->first;
+            size += prev->second;
+            block.freeRanges.erase(prev);
+        }
+    }
+    block.freeRanges[offset] = size;
+    block.used -= allocation.size;
+
+    // Dedicated blocks are released straight away, whereas a single empty
+    // block per memory type is kept around to avoid allocation churn
+    if (block.used == 0) {
+        size_t emptyBlocks =
+          std::count_if(blocks.begin(),
+                        blocks.end(),
+                        [](const std::unique_ptr<Block>& b) {
+                            return !b->dedicated && b->used == 0;
+                        });
+        if (block.dedicated || emptyBlocks > 1) {
+            this->freeBlock(block);
+            blocks.erase(blockIt);
+        }
+    }
+}
+
+void
+MemoryPool::destroy()
+{
+    KP_LOG_DEBUG("Kompute MemoryPool destroy started");
+
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        KP_LOG_WARN("Kompute MemoryPool destroy called with null Device");
+        return;
+    }
+
+    for (auto& blocks : this->mBlocks) {
+        for (std::unique_ptr<Block>& block : blocks.second) {
+            this->freeBlock(*block);
+        }
+    }
+    this->mBlocks.clear();
+
+    this->mDevice = nullptr;
+
+    KP_LOG_DEBUG("Kompute MemoryPool destroy success");
+}
+
+uint32_t
+MemoryPool::blockCount()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    uint32_t count = 0;
+    for (const auto& blocks : this->mBlocks) {
+        count += blocks.second.size();
+    }
+    return count;
+}
+
+int32_t
+MemoryPool::findMemoryTypeIndex(
+  const vk::PhysicalDeviceMemoryProperties& memoryProperties,
+  uint32_t memoryTypeBits,
+  const vk::MemoryPropertyFlags& memoryPropertyFlags)
+{
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+        if (memoryTypeBits & (1 << i)) {
+            if (((memoryProperties.memoryTypes[i]).propertyFlags &
+                 memoryPropertyFlags) == memoryPropertyFlags) {
+                return i;
+            }
+        }
+    }
+    return -1;
+}
+
+MemoryPool::Block*
+MemoryPool::createBlock(uint32_t memoryTypeIndex,
+                        vk::DeviceSize size,
+                        bool dedicated)
+{
+    KP_LOG_DEBUG("Kompute MemoryPool allocating block index: {}, size {}",
+                 memoryTypeIndex,
+                 size);
+
+    std::unique_ptr<Block> block(new Block());
+    block->size = size;
+    block->dedicated = dedicated;
+    block->freeRanges[0] = size;
+
+    vk::MemoryAllocateInfo memoryAllocateInfo(size, memoryTypeIndex);
+    this->mDevice->allocateMemory(
+      &memoryAllocateInfo, nullptr, &block->memory);
+
+    // Host visible blocks are kept persistently mapped, and given only
+    // coherent memory is requested no flush / invalidate is required
+    if (this->mMemoryProperties.memoryTypes[memoryTypeIndex].propertyFlags &
+        vk::MemoryPropertyFlagBits::eHostVisible) {
+        block->mappedData = this->mDevice->mapMemory(
+          block->memory, 0, VK_WHOLE_SIZE, vk::MemoryMapFlags());
+    }
+
+    std::vector<std::unique_ptr<Block>>& blocks =
+      this->mBlocks[memoryTypeIndex];
+    blocks.push_back(std::move(block));
+    return blocks.back().get();
+}
+
+void
+MemoryPool::freeBlock(Block& block)
+{
+    KP_LOG_DEBUG("Kompute MemoryPool freeing block of size {}", block.size);
+
+    if (block.mappedData) {
+        this->mDevice->unmapMemory(block.memory);
+        block.mappedData = nullptr;
+    }
+    this->mDevice->freeMemory(
+      block.memory, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+}
+
+bool
+MemoryPool::suballocate(Block& block,
+                        const vk::MemoryRequirements& memoryRequirements,
+                        vk::DeviceSize& offset)
+{
+    vk::DeviceSize alignment =
+      std::max<vk::DeviceSize>(memoryRequirements.alignment, 1);
+
+    for (auto it = block.freeRanges.begin(); it != block.freeRanges.end();
+         it++) {
+        vk::DeviceSize rangeOffset = it->first;
+        vk::DeviceSize rangeSize = it->second;
+        vk::DeviceSize alignedOffset =
+          (rangeOffset + alignment - 1) / alignment * alignment;
+
+        if (alignedOffset + memoryRequirements.size >
+            rangeOffset + rangeSize) {
+            continue;
+        }
+
+        block.freeRanges.erase(it);
+        if (alignedOffset > rangeOffset) {
+            block.freeRanges[rangeOffset] = alignedOffset - rangeOffset;
+        }
+        vk::DeviceSize end = alignedOffset + memoryRequirements.size;
+        if (end < rangeOffset + rangeSize) {
+            block.freeRanges[end] = rangeOffset + rangeSize - end;
+        }
+
+        block.used += memoryRequirements.size;
+        offset = alignedOffset;
+        return true;
+    }
+
+    return false;
+}
+
+} // End namespace kp
@@ -14,21 +14,23 @@ OpAlgoDispatch::~OpAlgoDispatch()
     }
 }
 
-void
-OpAlgoDispatch::record(const vk::CommandBuffer& commandBuffer)
+bool
+OpAlgoDispatch::declareAccesses(std::vector<TensorAccess>& accesses)
 {
-    KP_LOG_DEBUG("Kompute OpAlgoDispatch record called");
-
-    // Barrier to ensure the data is finished writing to buffer memory
     for (const std::shared_ptr<Tensor>& tensor :
          this->mAlgorithm->getTensors()) {
-        tensor->recordPrimaryBufferMemoryBarrier(
-          commandBuffer,
-          vk::AccessFlagBits::eTransferWrite,
-          vk::AccessFlagBits::eShaderRead,
-          vk::PipelineStageFlagBits::eTransfer,
-          vk::PipelineStageFlagBits::eComputeShader);
+        accesses.push_back({ tensor,
+                             vk::PipelineStageFlagBits::eComputeShader,
+                             vk::AccessFlagBits::eShaderRead |
+                               vk::AccessFlagBits::eShaderWrite });
     }
+    return true;
+}
+
+void
+OpAlgoDispatch::record(const vk::CommandBuffer& commandBuffer)
+{
+    KP_LOG_DEBUG("Kompute OpAlgoDispatch record called");
 
     if (this->mPushConstantsSize) {
         this->mAlgorithm->setPushConstants(
@@ -40,18 +42,37 @@ OpAlgoDispatch::record(const vk::CommandBuffer& commandBuffer)
     this->mAlgorithm->recordBindCore(commandBuffer);
     this->mAlgorithm->recordBindPush(commandBuffer);
     this->mAlgorithm->recordDispatch(commandBuffer);
+
+    this->mDescriptorSetVersion = this->mAlgorithm->descriptorSetVersion();
+}
+
+bool
+OpAlgoDispatch::requiresRerecord()
+{
+    // Commands recorded before the descriptor set was written again, or
+    // before the pipeline was created again, are no longer valid
+    if (!this->mAlgorithm->isBuilt()) {
+        return true;
+    }
+    return this->mAlgorithm->requiresDescriptorUpdate() ||
+           this->mAlgorithm->descriptorSetVersion() !=
+             this->mDescriptorSetVersion;
 }
 
 void
 OpAlgoDispatch::preEval(const vk::CommandBuffer& /*commandBuffer*/)
 {
     KP_LOG_DEBUG("Kompute OpAlgoDispatch preEval called");
+
+    this->mAlgorithm->beginSubmission(this->mDescriptorSetVersion);
 }
 
 void
 OpAlgoDispatch::postEval(const vk::CommandBuffer& /*commandBuffer*/)
 {
     KP_LOG_DEBUG("Kompute OpAlgoDispatch postSubmit called");
+
+    this->mAlgorithm->endSubmission(this->mDescriptorSetVersion);
 }
 
 }
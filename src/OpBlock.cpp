@@ -0,0 +1,249 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "kompute/operations/OpBlock.hpp"
+
+namespace kp {
+
+OpBlock::OpBlock(std::shared_ptr<vk::Device> device,
+                 uint32_t queueIndex,
+                 const std::vector<std::shared_ptr<OpBase>>& operations)
+{
+    KP_LOG_DEBUG("Kompute OpBlock constructor with {} operations",
+                 operations.size());
+
+    if (operations.size() < 1) {
+        throw std::runtime_error(
+          "Kompute OpBlock called with less than 1 operation");
+    }
+    for (const std::shared_ptr<OpBase>& op : operations) {
+        if (!op) {
+            throw std::runtime_error("Kompute OpBlock called with null "
+                                     "operation");
+        }
+    }
+
+    this->mDevice = device;
+    this->mQueueIndex = queueIndex;
+    this->mOperations = operations;
+
+    this->createCommandPool();
+    this->createCommandBuffer();
+    this->rerecord();
+}
+
+OpBlock::~OpBlock()
+{
+    KP_LOG_DEBUG("Kompute OpBlock destructor started");
+
+    this->destroy();
+}
+
+bool
+OpBlock::declareAccesses(std::vector<TensorAccess>& accesses)
+{
+    for (const std::shared_ptr<OpBase>& op : this->mOperations) {
+        if (!op->declareAccesses(accesses)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+OpBlock::record(const vk::CommandBuffer& commandBuffer)
+{
+    KP_LOG_DEBUG("Kompute OpBlock record called");
+
+    if (!this->isInit()) {
+        throw std::runtime_error(
+          "Kompute OpBlock record called on destroyed block");
+    }
+
+    if (this->requiresRerecord()) {
+        this->rerecord();
+    }
+
+    commandBuffer.executeCommands(*this->mCommandBuffer);
+}
+
+bool
+OpBlock::requiresRerecord()
+{
+    for (const std::shared_ptr<OpBase>& op : this->mOperations) {
+        if (op->requiresRerecord()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t
+OpBlock::recordVersion()
+{
+    return this->mRecordVersion;
+}
+
+void
+OpBlock::preEval(const vk::CommandBuffer& /*commandBuffer*/)
+{
+    KP_LOG_DEBUG("Kompute OpBlock preEval called");
+
+    for (const std::shared_ptr<OpBase>& op : this->mOperations) {
+        op->preEval(*this->mCommandBuffer);
+    }
+}
+
+void
+OpBlock::postEval(const vk::CommandBuffer& /*commandBuffer*/)
+{
+    KP_LOG_DEBUG("Kompute OpBlock postEval called");
+
+    for (const std::shared_ptr<OpBase>& op : this->mOperations) {
+        op->postEval(*this->mCommandBuffer);
+    }
+}
+
+void
+OpBlock::rerecord()
+{
+    KP_LOG_DEBUG("Kompute OpBlock rerecord called");
+
+    if (!this->isInit()) {
+        throw std::runtime_error(
+          "Kompute OpBlock rerecord called on destroyed block");
+    }
+
+    // The pool only holds the command buffer of the block
+    this->mDevice->resetCommandPool(*this->mCommandPool);
+
+    // Blocks are only executed outside of render passes, so nothing is
+    // inherited from the primary command buffers
+    vk::CommandBufferInheritanceInfo inheritanceInfo;
+    vk::CommandBufferBeginInfo commandBufferBeginInfo(
+      vk::CommandBufferUsageFlagBits::eSimultaneousUse, &inheritanceInfo);
+    this->mCommandBuffer->begin(commandBufferBeginInfo);
+
+    this->mHazardTracker.clear();
+
+    bool declaresAccesses = true;
+    for (const std::shared_ptr<OpBase>& op : this->mOperations) {
+        std::vector<TensorAccess> accesses;
+        if (op->declareAccesses(accesses)) {
+            this->mHazardTracker.recordBarriers(*this->mCommandBuffer,
+                                                accesses);
+            op->record(*this->mCommandBuffer);
+        } else {
+            op->record(*this->mCommandBuffer);
+            this->mHazardTracker.invalidate();
+            declaresAccesses = false;
+        }
+    }
+
+    // The sequences do not know which tensors were written when the block
+    // does not declare its accesses, so these are made visible to the host
+    if (!declaresAccesses) {
+        this->mHazardTracker.recordHostBarriers(*this->mCommandBuffer);
+    }
+
+    this->mCommandBuffer->end();
+
+    // Primary command buffers that execute the block are invalidated by the
+    // reset of the pool
+    this->mRecordVersion++;
+}
+
+bool
+OpBlock::isInit() const
+{
+    return this->mDevice && this->mCommandPool && this->mCommandBuffer;
+}
+
+void
+OpBlock::destroy()
+{
+    KP_LOG_DEBUG("Kompute OpBlock destroy called");
+
+    if (!this->mDevice) {
+        KP_LOG_WARN("Kompute OpBlock destroy called "
+                    "with null Device pointer");
+        return;
+    }
+
+    if (this->mFreeCommandBuffer) {
+        KP_LOG_INFO("Freeing CommandBuffer");
+        if (!this->mCommandBuffer) {
+            KP_LOG_WARN("Kompute OpBlock destroy called with null "
+                        "CommandBuffer pointer");
+            return;
+        }
+        this->mDevice->freeCommandBuffers(
+          *this->mCommandPool, 1, this->mCommandBuffer.get());
+
+        this->mCommandBuffer = nullptr;
+        this->mFreeCommandBuffer = false;
+
+        KP_LOG_DEBUG("Kompute OpBlock Freed CommandBuffer");
+    }
+
+    if (this->mFreeCommandPool) {
+        KP_LOG_INFO("Destroying CommandPool");
+        if (this->mCommandPool == nullptr) {
+            KP_LOG_WARN("Kompute OpBlock destroy called with null "
+                        "CommandPool pointer");
+            return;
+        }
+        this->mDevice->destroy(
+          *this->mCommandPool,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+
+        this->mCommandPool = nullptr;
+        this->mFreeCommandPool = false;
+
+        KP_LOG_DEBUG("Kompute OpBlock Destroyed CommandPool");
+    }
+
+    this->mOperations.clear();
+}
+
+void
+OpBlock::createCommandPool()
+{
+    KP_LOG_DEBUG("Kompute OpBlock creating command pool");
+
+    if (!this->mDevice) {
+        throw std::runtime_error("Kompute OpBlock device is null");
+    }
+
+    this->mFreeCommandPool = true;
+
+    vk::CommandPoolCreateInfo commandPoolInfo(vk::CommandPoolCreateFlags(),
+                                              this->mQueueIndex);
+    this->mCommandPool = std::make_shared<vk::CommandPool>();
+    this->mDevice->createCommandPool(
+      &commandPoolInfo, nullptr, this->mCommandPool.get());
+    KP_LOG_DEBUG("Kompute OpBlock Command Pool Created");
+}
+
+void
+OpBlock::createCommandBuffer()
+{
+    KP_LOG_DEBUG("Kompute OpBlock creating command buffer");
+    if (!this->mDevice) {
+        throw std::runtime_error("Kompute OpBlock device is null");
+    }
+    if (!this->mCommandPool) {
+        throw std::runtime_error("Kompute OpBlock command pool is null");
+    }
+
+    this->mFreeCommandBuffer = true;
+
+    vk::CommandBufferAllocateInfo commandBufferAllocateInfo(
+      *this->mCommandPool, vk::CommandBufferLevel::eSecondary, 1);
+
+    this->mCommandBuffer = std::make_shared<vk::CommandBuffer>();
+    this->mDevice->allocateCommandBuffers(&commandBufferAllocateInfo,
+                                          this->mCommandBuffer.get());
+    KP_LOG_DEBUG("Kompute OpBlock Command Buffer Created");
+}
+
+}
@@ -10,12 +10,14 @@ OpMemoryBarrier::OpMemoryBarrier(
   const vk::AccessFlagBits& dstAccessMask,
   const vk::PipelineStageFlagBits& srcStageMask,
   const vk::PipelineStageFlagBits& dstStageMask,
-  bool barrierOnPrimary)
+  bool barrierOnPrimary,
+  bool globalBarrier)
   : mSrcAccessMask(srcAccessMask)
   , mDstAccessMask(dstAccessMask)
   , mSrcStageMask(srcStageMask)
   , mDstStageMask(dstStageMask)
   , mBarrierOnPrimary(barrierOnPrimary)
+  , mGlobalBarrier(globalBarrier)
   , mTensors(tensors)
 {
     KP_LOG_DEBUG("Kompute OpMemoryBarrier constructor");
@@ -31,24 +33,41 @@ OpMemoryBarrier::record(const vk::CommandBuffer& commandBuffer)
 {
     KP_LOG_DEBUG("Kompute OpMemoryBarrier record called");
 
+    this->storeTensorGenerations(this->mTensors);
+
+    BarrierBuilder barrierBuilder;
+
     // Barrier to ensure the data is finished writing to buffer memory
-    if (this->mBarrierOnPrimary) {
+    if (this->mGlobalBarrier) {
+        barrierBuilder.addMemoryBarrier(
+          this->mSrcStageMask,
+          this->mDstStageMask,
+          vk::MemoryBarrier(this->mSrcAccessMask, this->mDstAccessMask));
+    } else if (this->mBarrierOnPrimary) {
         for (const std::shared_ptr<Tensor>& tensor : this->mTensors) {
-            tensor->recordPrimaryBufferMemoryBarrier(commandBuffer,
-                                                     this->mSrcAccessMask,
-                                                     this->mDstAccessMask,
-                                                     this->mSrcStageMask,
-                                                     this->mDstStageMask);
+            tensor->addPrimaryBufferMemoryBarrier(barrierBuilder,
+                                                  this->mSrcAccessMask,
+                                                  this->mDstAccessMask,
+                                                  this->mSrcStageMask,
+                                                  this->mDstStageMask);
         }
     } else {
         for (const std::shared_ptr<Tensor>& tensor : this->mTensors) {
-            tensor->recordStagingBufferMemoryBarrier(commandBuffer,
-                                                     this->mSrcAccessMask,
-                                                     this->mDstAccessMask,
-                                                     this->mSrcStageMask,
-                                                     this->mDstStageMask);
+            tensor->addStagingBufferMemoryBarrier(barrierBuilder,
+                                                  this->mSrcAccessMask,
+                                                  this->mDstAccessMask,
+                                                  this->mSrcStageMask,
+                                                  this->mDstStageMask);
         }
     }
+
+    barrierBuilder.record(commandBuffer);
+}
+
+bool
+OpMemoryBarrier::requiresRerecord()
+{
+    return this->tensorsRebuilt(this->mTensors);
 }
 
 void
@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "kompute/operations/OpRepeat.hpp"
+
+namespace kp {
+
+OpRepeat::OpRepeat(const std::vector<std::shared_ptr<OpBase>>& operations,
+                   uint32_t iterations,
+                   const std::function<void(uint32_t)>& iterationCallback)
+{
+    KP_LOG_DEBUG("Kompute OpRepeat constructor with {} operations and {} "
+                 "iterations",
+                 operations.size(),
+                 iterations);
+
+    if (operations.size() < 1) {
+        throw std::runtime_error(
+          "Kompute OpRepeat called with less than 1 operation");
+    }
+    if (iterations < 1) {
+        throw std::runtime_error(
+          "Kompute OpRepeat called with less than 1 iteration");
+    }
+    for (const std::shared_ptr<OpBase>& op : operations) {
+        if (!op) {
+            throw std::runtime_error("Kompute OpRepeat called with null "
+                                     "operation");
+        }
+    }
+
+    this->mOperations = operations;
+    this->mIterations = iterations;
+    this->mIterationCallback = iterationCallback;
+}
+
+OpRepeat::~OpRepeat()
+{
+    KP_LOG_DEBUG("Kompute OpRepeat destructor started");
+}
+
+bool
+OpRepeat::declareAccesses(std::vector<TensorAccess>& accesses)
+{
+    for (const std::shared_ptr<OpBase>& op : this->mOperations) {
+        if (!op->declareAccesses(accesses)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+OpRepeat::record(const vk::CommandBuffer& commandBuffer)
+{
+    KP_LOG_DEBUG("Kompute OpRepeat record called");
+
+    // The first iteration is synchronised with any previous device write,
+    // while the following ones only wait for the previous iteration
+    this->mHazardTracker.clear();
+
+    bool declaresAccesses = true;
+    for (uint32_t iteration = 0; iteration < this->mIterations; iteration++) {
+        if (this->mIterationCallback) {
+            this->mIterationCallback(iteration);
+        }
+
+        for (const std::shared_ptr<OpBase>& op : this->mOperations) {
+            std::vector<TensorAccess> accesses;
+            if (op->declareAccesses(accesses)) {
+                this->mHazardTracker.recordBarriers(commandBuffer, accesses);
+                op->record(commandBuffer);
+            } else {
+                op->record(commandBuffer);
+                this->mHazardTracker.invalidate();
+                declaresAccesses = false;
+            }
+        }
+    }
+
+    // The Sequence does not know which tensors were written when the body
+    // does not declare its accesses, so these are made visible to the host
+    if (!declaresAccesses) {
+        this->mHazardTracker.recordHostBarriers(commandBuffer);
+    }
+}
+
+bool
+OpRepeat::requiresRerecord()
+{
+    for (const std::shared_ptr<OpBase>& op : this->mOperations) {
+        if (op->requiresRerecord()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t
+OpRepeat::recordVersion()
+{
+    // Versions only increase, so the sum changes whenever any of them does
+    uint64_t version = 0;
+    for (const std::shared_ptr<OpBase>& op : this->mOperations) {
+        version += op->recordVersion();
+    }
+    return version;
+}
+
+void
+OpRepeat::preEval(const vk::CommandBuffer& commandBuffer)
+{
+    KP_LOG_DEBUG("Kompute OpRepeat preEval called");
+
+    for (const std::shared_ptr<OpBase>& op : this->mOperations) {
+        op->preEval(commandBuffer);
+    }
+}
+
+void
+OpRepeat::postEval(const vk::CommandBuffer& commandBuffer)
+{
+    KP_LOG_DEBUG("Kompute OpRepeat postEval called");
+
+    for (const std::shared_ptr<OpBase>& op : this->mOperations) {
+        op->postEval(commandBuffer);
+    }
+}
+
+}
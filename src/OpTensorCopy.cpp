@@ -17,7 +17,7 @@ OpTensorCopy::OpTensorCopy(const std::vector<std::shared_ptr<Tensor>>& tensors)
     }
 
     kp::Tensor::TensorDataTypes dataType = this->mTensors[0]->dataType();
-    uint32_t size = this->mTensors[0]->size();
+    uint64_t size = this->mTensors[0]->size();
     for (const std::shared_ptr<Tensor>& tensor : tensors) {
         if (tensor->dataType() != dataType) {
             throw std::runtime_error(fmt::format(
@@ -39,17 +39,39 @@ OpTensorCopy::~OpTensorCopy()
     KP_LOG_DEBUG("Kompute OpTensorCopy destructor started");
 }
 
+bool
+OpTensorCopy::declareAccesses(std::vector<TensorAccess>& accesses)
+{
+    accesses.push_back({ this->mTensors[0],
+                         vk::PipelineStageFlagBits::eTransfer,
+                         vk::AccessFlagBits::eTransferRead });
+    for (size_t i = 1; i < this->mTensors.size(); i++) {
+        accesses.push_back({ this->mTensors[i],
+                             vk::PipelineStageFlagBits::eTransfer,
+                             vk::AccessFlagBits::eTransferWrite });
+    }
+    return true;
+}
+
 void
 OpTensorCopy::record(const vk::CommandBuffer& commandBuffer)
 {
     KP_LOG_DEBUG("Kompute OpTensorCopy record called");
 
+    this->storeTensorGenerations(this->mTensors);
+
     // We iterate from the second tensor onwards and record a copy to all
     for (size_t i = 1; i < this->mTensors.size(); i++) {
         this->mTensors[i]->recordCopyFrom(commandBuffer, this->mTensors[0]);
     }
 }
 
+bool
+OpTensorCopy::requiresRerecord()
+{
+    return this->tensorsRebuilt(this->mTensors);
+}
+
 void
 OpTensorCopy::preEval(const vk::CommandBuffer& /*commandBuffer*/)
 {
@@ -66,6 +88,8 @@ OpTensorCopy::postEval(const vk::CommandBuffer& /*commandBuffer*/)
     // Copy the data from the first tensor into all the tensors
     for (size_t i = 1; i < this->mTensors.size(); i++) {
         this->mTensors[i]->setRawData(data);
+        // The device memory already holds the data that was copied
+        this->mTensors[i]->clearDirty();
     }
 }
 
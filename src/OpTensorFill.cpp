@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "kompute/operations/OpTensorFill.hpp"
+#include "kompute/Tensor.hpp"
+
+namespace kp {
+
+OpTensorFill::OpTensorFill(const std::vector<std::shared_ptr<Tensor>>& tensors,
+                           uint32_t value)
+{
+    KP_LOG_DEBUG("Kompute OpTensorFill constructor with params");
+
+    if (tensors.size() < 1) {
+        throw std::runtime_error(
+          "Kompute OpTensorFill called with less than 1 tensor");
+    }
+
+    for (const std::shared_ptr<Tensor>& tensor : tensors) {
+        if (tensor->offset() % 4 || tensor->memorySize() % 4) {
+            throw std::runtime_error(fmt::format(
+              "Kompute OpTensorFill tensor of {} bytes is not 4-byte aligned",
+              tensor->memorySize()));
+        }
+    }
+
+    this->mTensors = tensors;
+    this->mValue = value;
+}
+
+OpTensorFill::~OpTensorFill()
+{
+    KP_LOG_DEBUG("Kompute OpTensorFill destructor started");
+}
+
+bool
+OpTensorFill::declareAccesses(std::vector<TensorAccess>& accesses)
+{
+    for (const std::shared_ptr<Tensor>& tensor : this->mTensors) {
+        accesses.push_back({ tensor,
+                             vk::PipelineStageFlagBits::eTransfer,
+                             vk::AccessFlagBits::eTransferWrite });
+    }
+    return true;
+}
+
+void
+OpTensorFill::record(const vk::CommandBuffer& commandBuffer)
+{
+    KP_LOG_DEBUG("Kompute OpTensorFill record called");
+
+    this->storeTensorGenerations(this->mTensors);
+
+    // The host reads host and unified tensors from the device memory, which
+    // the sequence makes visible once all the operations are recorded
+    for (const std::shared_ptr<Tensor>& tensor : this->mTensors) {
+        tensor->recordFill(commandBuffer, this->mValue);
+    }
+}
+
+bool
+OpTensorFill::requiresRerecord()
+{
+    return this->tensorsRebuilt(this->mTensors);
+}
+
+void
+OpTensorFill::preEval(const vk::CommandBuffer& /*commandBuffer*/)
+{
+    KP_LOG_DEBUG("Kompute OpTensorFill preEval called");
+
+    // The host data is written before the submission, as the staging memory
+    // of device tensors is also where later operations in the sequence, such
+    // as OpTensorSyncLocal, copy their results back to
+    for (const std::shared_ptr<Tensor>& tensor : this->mTensors) {
+        if (tensor->tensorType() == Tensor::TensorTypes::eDevice &&
+            !tensor->isUnifiedMemory()) {
+            uint8_t* data = (uint8_t*)tensor->rawData();
+            for (uint64_t i = 0; i < tensor->memorySize(); i += 4) {
+                memcpy(data + i, &this->mValue, sizeof(uint32_t));
+            }
+        }
+        // The device memory already holds the value that was filled
+        tensor->clearDirty();
+    }
+}
+
+void
+OpTensorFill::postEval(const vk::CommandBuffer& /*commandBuffer*/)
+{
+    KP_LOG_DEBUG("Kompute OpTensorFill postEval called");
+}
+
+}
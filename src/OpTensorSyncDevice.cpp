@@ -17,29 +17,195 @@ OpTensorSyncDevice::OpTensorSyncDevice(
     this->mTensors = tensors;
 }
 
+OpTensorSyncDevice::OpTensorSyncDevice(
+  const std::vector<std::shared_ptr<Tensor>>& tensors,
+  const std::vector<TensorRange>& ranges)
+  : OpTensorSyncDevice(tensors)
+{
+    KP_LOG_DEBUG("Kompute OpTensorSyncDevice constructor with ranges");
+
+    if (ranges.size() < 1) {
+        throw std::runtime_error(
+          "Kompute OpTensorSyncDevice called with less than 1 range");
+    }
+
+    for (const std::shared_ptr<Tensor>& tensor : tensors) {
+        for (const TensorRange& range : ranges) {
+            if (range.size < 1 || range.offset + range.size > tensor->size()) {
+                throw std::runtime_error(fmt::format(
+                  "Kompute OpTensorSyncDevice range [{}, {}) out of bounds for "
+                  "tensor size {}",
+                  range.offset,
+                  range.offset + range.size,
+                  tensor->size()));
+            }
+        }
+    }
+
+    this->mRanges = ranges;
+}
+
+OpTensorSyncDevice::OpTensorSyncDevice(
+  const std::vector<std::shared_ptr<Tensor>>& tensors,
+  bool syncDirtyOnly)
+  : OpTensorSyncDevice(tensors)
+{
+    KP_LOG_DEBUG("Kompute OpTensorSyncDevice constructor with sync dirty "
+                 "only: {}",
+                 syncDirtyOnly);
+
+    this->mSyncDirtyOnly = syncDirtyOnly;
+}
+
 OpTensorSyncDevice::~OpTensorSyncDevice()
 {
     KP_LOG_DEBUG("Kompute OpTensorSyncDevice destructor started");
 
+    this->mStagingSlices.clear();
     this->mTensors.clear();
 }
 
+bool
+OpTensorSyncDevice::declareAccesses(std::vector<TensorAccess>& accesses)
+{
+    // The host writes of unified tensors are visible once submitted
+    for (const std::shared_ptr<Tensor>& tensor : this->mTensors) {
+        if (tensor->tensorType() != Tensor::TensorTypes::eDevice ||
+            tensor->isUnifiedMemory() ||
+            (this->mSyncDirtyOnly && tensor->dirtyRanges().empty())) {
+            continue;
+        }
+        accesses.push_back({ tensor,
+                             vk::PipelineStageFlagBits::eTransfer,
+                             vk::AccessFlagBits::eTransferWrite });
+    }
+    return true;
+}
+
 void
 OpTensorSyncDevice::record(const vk::CommandBuffer& commandBuffer)
 {
     KP_LOG_DEBUG("Kompute OpTensorSyncDevice record called");
 
+    this->storeTensorGenerations(this->mTensors);
+
+    this->mRecordedRanges.clear();
+
+    // Slices of a previous recording into the same command buffer are no
+    // longer referenced, while the ones of other command buffers may be
+    std::vector<std::shared_ptr<StagingRing::Slice>>& stagingSlices =
+      this->mStagingSlices[commandBuffer];
+    stagingSlices.clear();
+
     for (size_t i = 0; i < this->mTensors.size(); i++) {
-        if (this->mTensors[i]->tensorType() == Tensor::TensorTypes::eDevice) {
-            this->mTensors[i]->recordCopyFromStagingToDevice(commandBuffer);
+        std::shared_ptr<Tensor> tensor = this->mTensors[i];
+
+        std::vector<TensorRange> ranges;
+        if (this->mSyncDirtyOnly) {
+            ranges = tensor->dirtyRanges();
+        } else if (this->mRanges.empty()) {
+            ranges.push_back({ 0, tensor->size() });
+        } else {
+            ranges = this->mRanges;
+        }
+        this->mRecordedRanges.push_back(ranges);
+        stagingSlices.push_back(nullptr);
+
+        if (tensor->tensorType() != Tensor::TensorTypes::eDevice) {
+            continue;
+        }
+
+        if (ranges.empty()) {
+            KP_LOG_DEBUG("Kompute OpTensorSyncDevice skipping clean tensor");
+        } else if (tensor->isUnifiedMemory()) {
+            KP_LOG_DEBUG("Kompute OpTensorSyncDevice skipping unified tensor");
+        } else if (std::shared_ptr<StagingRing> stagingRing =
+                     tensor->stagingRing()) {
+            vk::DeviceSize sliceSize = 0;
+            for (const TensorRange& range : ranges) {
+                sliceSize +=
+                  (vk::DeviceSize)range.size * tensor->dataTypeMemorySize();
+            }
+            stagingSlices[i] = stagingRing->allocate(sliceSize);
+            tensor->recordCopyFromStagingRing(
+              commandBuffer, *stagingSlices[i], ranges);
+        } else if (!this->mSyncDirtyOnly && this->mRanges.empty()) {
+            tensor->recordCopyFromStagingToDevice(commandBuffer);
+        } else {
+            tensor->recordCopyFromStagingToDevice(commandBuffer, ranges);
         }
     }
 }
 
+bool
+OpTensorSyncDevice::requiresRerecord()
+{
+    if (this->tensorsRebuilt(this->mTensors)) {
+        return true;
+    }
+    if (!this->mSyncDirtyOnly) {
+        return false;
+    }
+
+    // The copies only cover the ranges that were dirty when recorded, so
+    // replaying these after other writes would leave the new ranges dirty
+    for (size_t i = 0; i < this->mRecordedRanges.size(); i++) {
+        std::shared_ptr<Tensor> tensor = this->mTensors[i];
+        if (tensor->tensorType() != Tensor::TensorTypes::eDevice ||
+            tensor->isUnifiedMemory()) {
+            continue;
+        }
+
+        const std::vector<TensorRange>& dirtyRanges = tensor->dirtyRanges();
+        const std::vector<TensorRange>& ranges = this->mRecordedRanges[i];
+        if (dirtyRanges.size() != ranges.size()) {
+            return true;
+        }
+        for (size_t j = 0; j < ranges.size(); j++) {
+            if (dirtyRanges[j].offset != ranges[j].offset ||
+                dirtyRanges[j].size != ranges[j].size) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 void
-OpTensorSyncDevice::preEval(const vk::CommandBuffer& /*commandBuffer*/)
+OpTensorSyncDevice::preEval(const vk::CommandBuffer& commandBuffer)
 {
     KP_LOG_DEBUG("Kompute OpTensorSyncDevice preEval called");
+
+    auto stagingSlices = this->mStagingSlices.find(commandBuffer);
+
+    // Host writes after this point are no longer covered by the submission
+    for (size_t i = 0; i < this->mRecordedRanges.size(); i++) {
+        std::shared_ptr<Tensor> tensor = this->mTensors[i];
+        const std::vector<TensorRange>& ranges = this->mRecordedRanges[i];
+
+        if (stagingSlices != this->mStagingSlices.end() &&
+            stagingSlices->second[i]) {
+            tensor->writeToStagingRing(*stagingSlices->second[i], ranges);
+        }
+
+        if (tensor->tensorType() == Tensor::TensorTypes::eDevice &&
+            !tensor->isUnifiedMemory()) {
+            uint64_t bytesUploaded = 0;
+            for (const TensorRange& range : ranges) {
+                bytesUploaded += range.size * tensor->dataTypeMemorySize();
+            }
+            bytesUploaded = std::min<uint64_t>(bytesUploaded,
+                                               tensor->memorySize());
+            tensor->mBytesUploaded += bytesUploaded;
+            tensor->mBytesSkipped += tensor->memorySize() - bytesUploaded;
+            tensor->clearDirty(ranges);
+        } else if (this->mSyncDirtyOnly) {
+            // The device reads the host writes of these tensors directly
+            tensor->clearDirty();
+        } else {
+            tensor->clearDirty(ranges);
+        }
+    }
 }
 
 void
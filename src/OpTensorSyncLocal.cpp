@@ -19,9 +19,55 @@ OpTensorSyncLocal::OpTensorSyncLocal(
     this->mTensors = tensors;
 }
 
+OpTensorSyncLocal::OpTensorSyncLocal(
+  const std::vector<std::shared_ptr<Tensor>>& tensors,
+  const std::vector<TensorRange>& ranges)
+  : OpTensorSyncLocal(tensors)
+{
+    KP_LOG_DEBUG("Kompute OpTensorSyncLocal constructor with ranges");
+
+    if (ranges.size() < 1) {
+        throw std::runtime_error(
+          "Kompute OpTensorSyncLocal called with less than 1 range");
+    }
+
+    for (const std::shared_ptr<Tensor>& tensor : tensors) {
+        for (const TensorRange& range : ranges) {
+            if (range.size < 1 || range.offset + range.size > tensor->size()) {
+                throw std::runtime_error(fmt::format(
+                  "Kompute OpTensorSyncLocal range [{}, {}) out of bounds for "
+                  "tensor size {}",
+                  range.offset,
+                  range.offset + range.size,
+                  tensor->size()));
+            }
+        }
+    }
+
+    this->mRanges = ranges;
+}
+
 OpTensorSyncLocal::~OpTensorSyncLocal()
 {
     KP_LOG_DEBUG("Kompute OpTensorSyncLocal destructor started");
+
+    this->mStagingSlices.clear();
+}
+
+bool
+OpTensorSyncLocal::declareAccesses(std::vector<TensorAccess>& accesses)
+{
+    // Unified tensors are read by the host from the primary buffer, which the
+    // sequence makes visible once all the operations are recorded
+    for (const std::shared_ptr<Tensor>& tensor : this->mTensors) {
+        if (tensor->tensorType() == Tensor::TensorTypes::eDevice &&
+            !tensor->isUnifiedMemory()) {
+            accesses.push_back({ tensor,
+                                 vk::PipelineStageFlagBits::eTransfer,
+                                 vk::AccessFlagBits::eTransferRead });
+        }
+    }
+    return true;
 }
 
 void
@@ -29,26 +75,79 @@ OpTensorSyncLocal::record(const vk::CommandBuffer& commandBuffer)
 {
     KP_LOG_DEBUG("Kompute OpTensorSyncLocal record called");
 
-    for (size_t i = 0; i < this->mTensors.size(); i++) {
-        if (this->mTensors[i]->tensorType() == Tensor::TensorTypes::eDevice) {
+    this->storeTensorGenerations(this->mTensors);
+
+    // Slices of a previous recording into the same command buffer are no
+    // longer referenced, while the ones of other command buffers may be
+    std::vector<std::shared_ptr<StagingRing::Slice>>& stagingSlices =
+      this->mStagingSlices[commandBuffer];
+    stagingSlices.clear();
 
-            this->mTensors[i]->recordPrimaryBufferMemoryBarrier(
-              commandBuffer,
-              vk::AccessFlagBits::eShaderWrite,
-              vk::AccessFlagBits::eTransferRead,
-              vk::PipelineStageFlagBits::eComputeShader,
-              vk::PipelineStageFlagBits::eTransfer);
+    // The host reads of all the tensors are synchronised together once all
+    // the copies are recorded
+    BarrierBuilder barrierBuilder;
 
-            this->mTensors[i]->recordCopyFromDeviceToStaging(commandBuffer);
+    for (size_t i = 0; i < this->mTensors.size(); i++) {
+        stagingSlices.push_back(nullptr);
+
+        if (this->mTensors[i]->tensorType() == Tensor::TensorTypes::eDevice) {
 
-            this->mTensors[i]->recordPrimaryBufferMemoryBarrier(
-              commandBuffer,
+            // The host reads the primary buffer directly
+            if (this->mTensors[i]->isUnifiedMemory()) {
+                continue;
+            }
+
+            if (std::shared_ptr<StagingRing> stagingRing =
+                  this->mTensors[i]->stagingRing()) {
+                std::vector<TensorRange> ranges = this->mRanges;
+                if (ranges.empty()) {
+                    ranges.push_back({ 0, this->mTensors[i]->size() });
+                }
+                vk::DeviceSize sliceSize = 0;
+                for (const TensorRange& range : ranges) {
+                    sliceSize += (vk::DeviceSize)range.size *
+                                 this->mTensors[i]->dataTypeMemorySize();
+                }
+                stagingSlices[i] = stagingRing->allocate(sliceSize);
+
+                this->mTensors[i]->recordCopyToStagingRing(
+                  commandBuffer, *stagingSlices[i], ranges);
+
+                stagingRing->addSliceMemoryBarrier(
+                  barrierBuilder,
+                  *stagingSlices[i],
+                  vk::AccessFlagBits::eTransferWrite,
+                  vk::AccessFlagBits::eHostRead,
+                  vk::PipelineStageFlagBits::eTransfer,
+                  vk::PipelineStageFlagBits::eHost);
+                continue;
+            }
+
+            if (this->mRanges.empty()) {
+                this->mTensors[i]->recordCopyFromDeviceToStaging(commandBuffer);
+            } else {
+                this->mTensors[i]->recordCopyFromDeviceToStaging(
+                  commandBuffer, this->mRanges);
+            }
+
+            // The host reads the staging buffer written by the transfer
+            this->mTensors[i]->addStagingBufferMemoryBarrier(
+              barrierBuilder,
               vk::AccessFlagBits::eTransferWrite,
               vk::AccessFlagBits::eHostRead,
               vk::PipelineStageFlagBits::eTransfer,
-              vk::PipelineStageFlagBits::eHost);
+              vk::PipelineStageFlagBits::eHost,
+              this->mRanges);
         }
     }
+
+    barrierBuilder.record(commandBuffer);
+}
+
+bool
+OpTensorSyncLocal::requiresRerecord()
+{
+    return this->tensorsRebuilt(this->mTensors);
 }
 
 void
@@ -58,11 +157,34 @@ OpTensorSyncLocal::preEval(const vk::CommandBuffer& /*commandBuffer*/)
 }
 
 void
-OpTensorSyncLocal::postEval(const vk::CommandBuffer& /*commandBuffer*/)
+OpTensorSyncLocal::postEval(const vk::CommandBuffer& commandBuffer)
 {
     KP_LOG_DEBUG("Kompute OpTensorSyncLocal postEval called");
 
     KP_LOG_DEBUG("Kompute OpTensorSyncLocal mapping data into tensor local");
+
+    auto stagingSlices = this->mStagingSlices.find(commandBuffer);
+
+    // The host data now matches the device data for the ranges synced
+    for (size_t i = 0; i < this->mTensors.size(); i++) {
+        if (stagingSlices != this->mStagingSlices.end() &&
+            i < stagingSlices->second.size() && stagingSlices->second[i]) {
+            std::vector<TensorRange> ranges = this->mRanges;
+            if (ranges.empty()) {
+                ranges.push_back({ 0, this->mTensors[i]->size() });
+            }
+            this->mTensors[i]->readFromStagingRing(*stagingSlices->second[i],
+                                                   ranges);
+        }
+
+        if (this->mTensors[i]->tensorType() == Tensor::TensorTypes::eDevice) {
+            if (this->mRanges.empty()) {
+                this->mTensors[i]->clearDirty();
+            } else {
+                this->mTensors[i]->clearDirty(this->mRanges);
+            }
+        }
+    }
 }
 
 }
@@ -0,0 +1,332 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "kompute/PipelineCache.hpp"
+
+namespace kp {
+
+// Stored in front of the cache data, as the header of the cache data itself
+// does not hold the driver version
+struct PipelineCacheFileHeader
+{
+    uint32_t magic;
+    uint32_t vendorID;
+    uint32_t deviceID;
+    uint32_t driverVersion;
+    uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+    uint64_t dataSize;
+};
+
+static const uint32_t PIPELINE_CACHE_FILE_MAGIC = 0x4350504b; // "KPPC"
+
+static PipelineCacheFileHeader
+createFileHeader(const vk::PhysicalDeviceProperties& properties,
+                 uint64_t dataSize)
+{
+    PipelineCacheFileHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = PIPELINE_CACHE_FILE_MAGIC;
+    header.vendorID = properties.vendorID;
+    header.deviceID = properties.deviceID;
+    header.driverVersion = properties.driverVersion;
+    memcpy(header.pipelineCacheUUID,
+           properties.pipelineCacheUUID.data(),
+           VK_UUID_SIZE);
+    header.dataSize = dataSize;
+    return header;
+}
+
+PipelineCache::SharedPipeline::SharedPipeline(
+  std::shared_ptr<vk::Device> device,
+  std::shared_ptr<vk::DescriptorSetLayout> descriptorSetLayout,
+  std::shared_ptr<vk::ShaderModule> shaderModule,
+  std::shared_ptr<vk::PipelineLayout> pipelineLayout,
+  std::shared_ptr<vk::Pipeline> pipeline)
+  : device(device)
+  , descriptorSetLayout(descriptorSetLayout)
+  , shaderModule(shaderModule)
+  , pipelineLayout(pipelineLayout)
+  , pipeline(pipeline)
+{
+}
+
+PipelineCache::SharedPipeline::~SharedPipeline()
+{
+    KP_LOG_DEBUG("Kompute PipelineCache destroying shared pipeline");
+
+    if (!this->device) {
+        KP_LOG_WARN("Kompute PipelineCache shared pipeline destructor reached "
+                    "with null Device pointer");
+        return;
+    }
+
+    if (this->pipeline) {
+        this->device->destroy(
+          *this->pipeline,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    }
+    if (this->pipelineLayout) {
+        this->device->destroy(
+          *this->pipelineLayout,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    }
+    if (this->shaderModule) {
+        this->device->destroy(
+          *this->shaderModule,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    }
+    if (this->descriptorSetLayout) {
+        this->device->destroy(
+          *this->descriptorSetLayout,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    }
+}
+
+PipelineCache::PipelineCache(
+  std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+  std::shared_ptr<vk::Device> device,
+  const std::string& path)
+{
+    KP_LOG_DEBUG("Kompute PipelineCache constructor with path: {}", path);
+
+    if (!physicalDevice) {
+        throw std::runtime_error("Kompute PipelineCache physical device is "
+                                 "null");
+    }
+    if (!device) {
+        throw std::runtime_error("Kompute PipelineCache device is null");
+    }
+
+    this->mPhysicalDevice = physicalDevice;
+    this->mDevice = device;
+    this->mPath = path;
+
+    std::vector<uint8_t> data;
+    if (this->mPath.size()) {
+        data = this->loadFile();
+    }
+
+    vk::PipelineCacheCreateInfo pipelineCacheInfo(
+      vk::PipelineCacheCreateFlags(), data.size(), data.data());
+    this->mPipelineCache = std::make_shared<vk::PipelineCache>();
+    this->mDevice->createPipelineCache(
+      &pipelineCacheInfo, nullptr, this->mPipelineCache.get());
+    this->mLoaded = data.size() > 0;
+}
+
+PipelineCache::~PipelineCache()
+{
+    KP_LOG_DEBUG("Kompute PipelineCache destructor started");
+
+    if (this->mPipelineCache) {
+        this->destroy();
+    }
+}
+
+std::shared_ptr<vk::PipelineCache>
+PipelineCache::getVkPipelineCache()
+{
+    return this->mPipelineCache;
+}
+
+const std::string&
+PipelineCache::getPath() const
+{
+    return this->mPath;
+}
+
+bool
+PipelineCache::isLoaded() const
+{
+    return this->mLoaded;
+}
+
+std::shared_ptr<PipelineCache::SharedPipeline>
+PipelineCache::findPipeline(const std::string& key)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    auto it = this->mPipelines.find(key);
+    if (it == this->mPipelines.end()) {
+        return nullptr;
+    }
+
+    std::shared_ptr<SharedPipeline> pipeline = it->second.lock();
+    if (!pipeline) {
+        this->mPipelines.erase(it);
+    }
+    return pipeline;
+}
+
+std::shared_ptr<PipelineCache::SharedPipeline>
+PipelineCache::addPipeline(const std::string& key,
+                           std::shared_ptr<SharedPipeline> pipeline)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    std::weak_ptr<SharedPipeline>& weakPipeline = this->mPipelines[key];
+    if (std::shared_ptr<SharedPipeline> existingPipeline =
+          weakPipeline.lock()) {
+        return existingPipeline;
+    }
+
+    // Pipelines that are no longer used are pruned as new ones are added
+    for (auto it = this->mPipelines.begin(); it != this->mPipelines.end();) {
+        if (it->second.expired() && it->first != key) {
+            it = this->mPipelines.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    this->mPipelines[key] = pipeline;
+    return pipeline;
+}
+
+uint32_t
+PipelineCache::pipelineCount()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    uint32_t count = 0;
+    for (const auto& pipeline : this->mPipelines) {
+        if (!pipeline.second.expired()) {
+            count++;
+        }
+    }
+    return count;
+}
+
+std::vector<uint8_t>
+PipelineCache::loadFile()
+{
+    std::ifstream file(this->mPath, std::ios::binary);
+    if (!file.is_open()) {
+        KP_LOG_INFO("Kompute PipelineCache file {} not found, starting with "
+                    "an empty cache",
+                    this->mPath);
+        return {};
+    }
+
+    PipelineCacheFileHeader header;
+    PipelineCacheFileHeader expected =
+      createFileHeader(this->mPhysicalDevice->getProperties(), 0);
+    if (!file.read((char*)&header, sizeof(header)) ||
+        header.magic != expected.magic ||
+        header.vendorID != expected.vendorID ||
+        header.deviceID != expected.deviceID ||
+        header.driverVersion != expected.driverVersion ||
+        memcmp(header.pipelineCacheUUID,
+               expected.pipelineCacheUUID,
+               VK_UUID_SIZE) != 0) {
+        KP_LOG_WARN("Kompute PipelineCache file {} was not written from this "
+                    "device and driver, starting with an empty cache",
+                    this->mPath);
+        return {};
+    }
+
+    // The size is validated before allocating, as a corrupted header could
+    // otherwise request an arbitrarily large buffer
+    std::streampos dataStart = file.tellg();
+    file.seekg(0, std::ios::end);
+    std::streampos dataEnd = file.tellg();
+    file.seekg(dataStart);
+    if (dataStart < 0 || dataEnd < dataStart ||
+        header.dataSize != (uint64_t)(dataEnd - dataStart)) {
+        KP_LOG_WARN("Kompute PipelineCache file {} is truncated or corrupted, "
+                    "starting with an empty cache",
+                    this->mPath);
+        return {};
+    }
+
+    std::vector<uint8_t> data(header.dataSize);
+    if (!file.read((char*)data.data(), data.size())) {
+        KP_LOG_WARN("Kompute PipelineCache file {} is truncated, starting "
+                    "with an empty cache",
+                    this->mPath);
+        return {};
+    }
+
+    KP_LOG_INFO("Kompute PipelineCache loaded {} bytes from {}",
+                data.size(),
+                this->mPath);
+
+    return data;
+}
+
+void
+PipelineCache::save()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (this->mPath.empty()) {
+        return;
+    }
+    if (!this->mPipelineCache) {
+        throw std::runtime_error(
+          "Kompute PipelineCache attempted to save after destroy");
+    }
+
+    std::vector<uint8_t> data =
+      this->mDevice->getPipelineCacheData(*this->mPipelineCache);
+    PipelineCacheFileHeader header =
+      createFileHeader(this->mPhysicalDevice->getProperties(), data.size());
+
+    std::string temporaryPath = this->mPath + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        file.write((const char*)&header, sizeof(header));
+        file.write((const char*)data.data(), data.size());
+        if (!file) {
+            KP_LOG_WARN("Kompute PipelineCache failed to write file {}",
+                        temporaryPath);
+            return;
+        }
+    }
+
+    // Renaming onto an existing file fails on some platforms
+    if (std::rename(temporaryPath.c_str(), this->mPath.c_str()) != 0 &&
+        (std::remove(this->mPath.c_str()) != 0 ||
+         std::rename(temporaryPath.c_str(), this->mPath.c_str()) != 0)) {
+        KP_LOG_WARN("Kompute PipelineCache failed to replace file {}",
+                    this->mPath);
+        std::remove(temporaryPath.c_str());
+        return;
+    }
+
+    KP_LOG_INFO("Kompute PipelineCache saved {} bytes to {}",
+                data.size(),
+                this->mPath);
+}
+
+void
+PipelineCache::destroy()
+{
+    KP_LOG_DEBUG("Kompute PipelineCache destroy called");
+
+    if (!this->mDevice) {
+        KP_LOG_WARN("Kompute PipelineCache destroy called with null Device "
+                    "pointer");
+        return;
+    }
+    if (!this->mPipelineCache) {
+        return;
+    }
+
+    this->save();
+
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    // Algorithms that still hold a shared pipeline release it on destroy
+    this->mPipelines.clear();
+
+    this->mDevice->destroy(
+      *this->mPipelineCache,
+      (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    this->mPipelineCache = nullptr;
+}
+
+}
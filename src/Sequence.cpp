@@ -1,5 +1,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
+#include <utility>
+
 #include "kompute/Sequence.hpp"
 
 namespace kp {
@@ -8,7 +10,10 @@ Sequence::Sequence(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
                    std::shared_ptr<vk::Device> device,
                    std::shared_ptr<vk::Queue> computeQueue,
                    uint32_t queueIndex,
-                   uint32_t totalTimestamps)
+                   uint32_t totalTimestamps,
+                   std::shared_ptr<SyncPool> syncPool,
+                   std::shared_ptr<std::mutex> queueMutex,
+                   std::shared_ptr<vk::CommandPool> commandPool)
 {
     KP_LOG_DEBUG("Kompute Sequence Constructor with existing device & queue");
 
@@ -16,9 +21,20 @@ Sequence::Sequence(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
     this->mDevice = device;
     this->mComputeQueue = computeQueue;
     this->mQueueIndex = queueIndex;
+    this->mQueueMutex = queueMutex;
+    this->mSyncPool =
+      syncPool ? syncPool : std::make_shared<SyncPool>(this->mDevice);
+    if (this->mSyncPool->supportsTimelineSemaphores()) {
+        this->mTimelineSemaphore = this->mSyncPool->acquireTimelineSemaphore();
+    }
 
-    this->createCommandPool();
+    if (commandPool) {
+        this->mCommandPool = commandPool;
+    } else {
+        this->createCommandPool();
+    }
     this->createCommandBuffer();
+    this->mCommandBuffer = this->mCommandBuffers[0];
     if (totalTimestamps > 0)
         this->createTimestampQueryPool(totalTimestamps +
                                        1); //+1 for the first one
@@ -48,16 +64,35 @@ Sequence::begin()
           "Kompute Sequence begin called when sequence still running");
     }
 
+    // Operations from a previous recording are no longer part of the command
+    // buffer, so these must not run their preEval / postEval again
+    this->mOperations.clear();
+    this->mOperationVersions.clear();
+    this->mHazardTracker.clear();
+
+    // The other command buffers of the ring now hold a previous recording
+    this->mRecordingVersion++;
+
     KP_LOG_INFO("Kompute Sequence command now started recording");
-    this->mCommandBuffer->begin(vk::CommandBufferBeginInfo());
+    this->beginCommandBuffer(*this->mCommandBuffer);
     this->mRecording = true;
+}
+
+void
+Sequence::beginCommandBuffer(const vk::CommandBuffer& commandBuffer)
+{
+    // Each command buffer is only pending in one submission at a time, and
+    // the first access to each tensor is synchronised with the commands
+    // submitted before it, so no barrier over all commands is required
+    // between submissions
+    vk::CommandBufferBeginInfo commandBufferBeginInfo;
+    commandBuffer.begin(commandBufferBeginInfo);
 
     // latch the first timestamp before any commands are submitted
     if (this->timestampQueryPool)
-        this->mCommandBuffer->writeTimestamp(
-          vk::PipelineStageFlagBits::eAllCommands,
-          *this->timestampQueryPool,
-          0);
+        commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eAllCommands,
+                                     *this->timestampQueryPool,
+                                     0);
 }
 
 void
@@ -75,7 +110,10 @@ Sequence::end()
         return;
     } else {
         KP_LOG_INFO("Kompute Sequence command recording END");
+        this->mHazardTracker.recordHostBarriers(*this->mCommandBuffer);
         this->mCommandBuffer->end();
+        this->mCommandBufferVersions[this->mCommandBufferIndex] =
+          this->mRecordingVersion;
         this->mRecording = false;
     }
 }
@@ -107,33 +145,110 @@ Sequence::eval(std::shared_ptr<OpBase> op)
 std::shared_ptr<Sequence>
 Sequence::evalAsync()
 {
+    SubmitResources resources;
+    this->prepareSubmit(resources);
+
+    vk::Fence fence = this->mSyncPool->acquireFence();
+
+    KP_LOG_DEBUG(
+      "Kompute sequence submitting command buffer into compute queue");
+
+    // Submissions to the same queue from other threads are serialised
+    std::unique_lock<std::mutex> lock;
+    if (this->mQueueMutex) {
+        lock = std::unique_lock<std::mutex>(*this->mQueueMutex);
+    }
+    this->mComputeQueue->submit(1, &resources.submitInfo, fence);
+    this->mInFlightSubmissions.push_back(
+      { fence, nullptr, resources.commandBufferIndex });
+
+    return shared_from_this();
+}
+
+void
+Sequence::prepareSubmit(SubmitResources& resources)
+{
+    // Replaying commands recorded against ranges or buffers that have since
+    // changed would skip or corrupt the data of the tensors, and commands
+    // shared with other sequences may have been recorded again by these
+    bool requiresRerecord = false;
+    for (size_t i = 0; i < this->mOperations.size(); i++) {
+        requiresRerecord = requiresRerecord ||
+                           this->mOperations[i]->requiresRerecord() ||
+                           this->mOperations[i]->recordVersion() !=
+                             this->mOperationVersions[i];
+    }
+    if (requiresRerecord) {
+        KP_LOG_DEBUG("Kompute Sequence recording operations again");
+        if (this->isRunning()) {
+            this->awaitSubmissions(this->mInFlightSubmissions.size(),
+                                   UINT64_MAX);
+        }
+        this->rerecord();
+    }
+
     if (this->isRecording()) {
         this->end();
     }
 
-    if (this->mIsRunning) {
-        throw std::runtime_error(
-          "Kompute Sequence evalAsync called when an eval async was "
-          "called without successful wait");
+    if (this->mInFlightSubmissions.size() >= this->mMaxInFlight) {
+        if (this->mMaxInFlight == 1) {
+            throw std::runtime_error(
+              "Kompute Sequence evalAsync called when an eval async was "
+              "called without successful wait");
+        }
+        // Backpressure only applies once all the slots are busy
+        KP_LOG_DEBUG("Kompute Sequence waiting for oldest submission");
+        this->awaitSubmissions(1, UINT64_MAX);
     }
 
-    this->mIsRunning = true;
+    // Command buffers are submitted in turn, so this one is no longer pending
+    // once a slot is free, and holds the operations unless recorded before
+    // the latest recording began
+    if (this->mCommandBufferVersions[this->mCommandBufferIndex] !=
+        this->mRecordingVersion) {
+        this->recordCommandBuffer();
+    }
 
     for (size_t i = 0; i < this->mOperations.size(); i++) {
         this->mOperations[i]->preEval(*this->mCommandBuffer);
     }
 
-    vk::SubmitInfo submitInfo(
-      0, nullptr, nullptr, 1, this->mCommandBuffer.get());
-
-    this->mFence = this->mDevice->createFence(vk::FenceCreateInfo());
-
-    KP_LOG_DEBUG(
-      "Kompute sequence submitting command buffer into compute queue");
+    // Waits for the latest submission of each of the dependencies
+    for (const std::weak_ptr<Sequence>& weakDependency : this->mDependencies) {
+        std::shared_ptr<Sequence> dependency = weakDependency.lock();
+        if (dependency && dependency->mTimelineValue > 0) {
+            resources.waitSemaphores.push_back(dependency->mTimelineSemaphore);
+            resources.waitValues.push_back(dependency->mTimelineValue);
+            resources.waitStages.push_back(
+              vk::PipelineStageFlagBits::eAllCommands);
+        }
+    }
 
-    this->mComputeQueue->submit(1, &submitInfo, this->mFence);
+    resources.commandBufferIndex = this->mCommandBufferIndex;
+    resources.submitInfo = vk::SubmitInfo(resources.waitSemaphores.size(),
+                                          resources.waitSemaphores.data(),
+                                          resources.waitStages.data(),
+                                          1,
+                                          this->mCommandBuffer.get());
 
-    return shared_from_this();
+    this->mCommandBufferIndex =
+      (this->mCommandBufferIndex + 1) % this->mCommandBuffers.size();
+    this->mCommandBuffer = this->mCommandBuffers[this->mCommandBufferIndex];
+
+    // The value is advanced before submitting so sequences prepared later in
+    // the same submission batch wait for this submission
+    if (this->mTimelineSemaphore) {
+        resources.signalValue = ++this->mTimelineValue;
+        resources.timelineSemaphoreSubmitInfo =
+          vk::TimelineSemaphoreSubmitInfo(resources.waitValues.size(),
+                                          resources.waitValues.data(),
+                                          1,
+                                          &resources.signalValue);
+        resources.submitInfo.signalSemaphoreCount = 1;
+        resources.submitInfo.pSignalSemaphores = &this->mTimelineSemaphore;
+        resources.submitInfo.setPNext(&resources.timelineSemaphoreSubmitInfo);
+    }
 }
 
 std::shared_ptr<Sequence>
@@ -148,35 +263,177 @@ Sequence::evalAsync(std::shared_ptr<OpBase> op)
 std::shared_ptr<Sequence>
 Sequence::evalAwait(uint64_t waitFor)
 {
-    if (!this->mIsRunning) {
+    if (this->mInFlightSubmissions.empty()) {
         KP_LOG_WARN("Kompute Sequence evalAwait called without existing eval");
         return shared_from_this();
     }
 
-    vk::Result result =
-      this->mDevice->waitForFences(1, &this->mFence, VK_TRUE, waitFor);
-    this->mDevice->destroy(
-      this->mFence, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    this->awaitSubmissions(this->mInFlightSubmissions.size(), waitFor);
+
+    return shared_from_this();
+}
+
+bool
+Sequence::awaitSubmissions(size_t count, uint64_t waitFor)
+{
+    std::vector<vk::Fence> fences;
+    for (size_t i = 0; i < count; i++) {
+        fences.push_back(this->mInFlightSubmissions[i].fence);
+    }
 
-    this->mIsRunning = false;
+    vk::Result result = this->mDevice->waitForFences(
+      fences.size(), fences.data(), VK_TRUE, waitFor);
 
     if (result == vk::Result::eTimeout) {
         KP_LOG_WARN("Kompute Sequence evalAwait reached timeout of {}",
                     waitFor);
-        return shared_from_this();
+        // Fences that have not signalled are only reused once these signal
+        for (const Submission& submission : this->mInFlightSubmissions) {
+            if (!submission.batchFence) {
+                this->mSyncPool->releaseFence(submission.fence, false);
+            }
+        }
+        this->mInFlightSubmissions.clear();
+        return false;
     }
 
-    for (size_t i = 0; i < this->mOperations.size(); i++) {
-        this->mOperations[i]->postEval(*this->mCommandBuffer);
+    for (size_t i = 0; i < count; i++) {
+        Submission submission = this->mInFlightSubmissions.front();
+        this->mInFlightSubmissions.pop_front();
+
+        // Fences of submission batches are released by the last holder
+        if (!submission.batchFence) {
+            this->mSyncPool->releaseFence(submission.fence);
+        }
+
+        const vk::CommandBuffer& commandBuffer =
+          *this->mCommandBuffers[submission.commandBufferIndex];
+        for (size_t j = 0; j < this->mOperations.size(); j++) {
+            this->mOperations[j]->postEval(commandBuffer);
+        }
     }
 
-    return shared_from_this();
+    return true;
+}
+
+void
+Sequence::awaitFence(vk::Fence fence)
+{
+    for (size_t i = 0; i < this->mInFlightSubmissions.size(); i++) {
+        if (this->mInFlightSubmissions[i].fence == fence) {
+            this->awaitSubmissions(i + 1, UINT64_MAX);
+            return;
+        }
+    }
 }
 
 bool
 Sequence::isRunning() const
 {
-    return this->mIsRunning;
+    return !this->mInFlightSubmissions.empty();
+}
+
+void
+Sequence::setMaxInFlight(uint32_t maxInFlight)
+{
+    if (maxInFlight < 1) {
+        throw std::runtime_error(
+          "Kompute Sequence max in flight submissions has to be at least 1");
+    }
+    if (this->isRunning()) {
+        throw std::runtime_error(
+          "Kompute Sequence setMaxInFlight called when sequence still running");
+    }
+
+    this->mMaxInFlight = maxInFlight;
+
+    // Command buffers added to the ring are recorded when first submitted
+    while (this->mCommandBuffers.size() < maxInFlight) {
+        this->createCommandBuffer();
+    }
+
+    if (this->mCommandBuffers.size() > maxInFlight) {
+        // The command buffer that operations are recorded into is kept
+        std::swap(this->mCommandBuffers[0],
+                  this->mCommandBuffers[this->mCommandBufferIndex]);
+        std::swap(this->mCommandBufferVersions[0],
+                  this->mCommandBufferVersions[this->mCommandBufferIndex]);
+        this->mCommandBufferIndex = 0;
+
+        std::vector<vk::CommandBuffer> commandBuffers;
+        for (size_t i = maxInFlight; i < this->mCommandBuffers.size(); i++) {
+            commandBuffers.push_back(*this->mCommandBuffers[i]);
+        }
+        this->mDevice->freeCommandBuffers(
+          *this->mCommandPool, commandBuffers.size(), commandBuffers.data());
+
+        this->mCommandBuffers.resize(maxInFlight);
+        this->mCommandBufferVersions.resize(maxInFlight);
+    }
+}
+
+uint32_t
+Sequence::getMaxInFlight() const
+{
+    return this->mMaxInFlight;
+}
+
+uint32_t
+Sequence::inFlightCount() const
+{
+    return this->mInFlightSubmissions.size();
+}
+
+std::shared_ptr<Sequence>
+Sequence::addDependency(std::shared_ptr<Sequence> sequence)
+{
+    if (!sequence || sequence.get() == this) {
+        throw std::runtime_error(
+          "Kompute Sequence dependency has to be another sequence");
+    }
+    if (!this->mTimelineSemaphore || !sequence->mTimelineSemaphore) {
+        throw std::runtime_error(
+          "Kompute Sequence dependencies require timeline semaphores which "
+          "are not supported by the device");
+    }
+
+    this->mDependencies.push_back(sequence);
+
+    return shared_from_this();
+}
+
+void
+Sequence::clearDependencies()
+{
+    this->mDependencies.clear();
+}
+
+uint64_t
+Sequence::getTimelineValue() const
+{
+    return this->mTimelineValue;
+}
+
+uint64_t
+Sequence::getCompletedTimelineValue()
+{
+    if (!this->mTimelineSemaphore) {
+        return 0;
+    }
+    return this->mSyncPool->getTimelineSemaphoreValue(
+      this->mTimelineSemaphore);
+}
+
+bool
+Sequence::isCompleted()
+{
+    for (const Submission& submission : this->mInFlightSubmissions) {
+        if (this->mDevice->getFenceStatus(submission.fence) !=
+            vk::Result::eSuccess) {
+            return false;
+        }
+    }
+    return true;
 }
 
 bool
@@ -198,6 +455,7 @@ Sequence::rerecord()
     this->end();
     std::vector<std::shared_ptr<OpBase>> ops = this->mOperations;
     this->mOperations.clear();
+    this->mOperationVersions.clear();
     for (const std::shared_ptr<kp::OpBase>& op : ops) {
         this->record(op);
     }
@@ -221,10 +479,17 @@ Sequence::destroy()
                         "CommandPool pointer");
             return;
         }
+        std::vector<vk::CommandBuffer> commandBuffers;
+        for (const std::shared_ptr<vk::CommandBuffer>& commandBuffer :
+             this->mCommandBuffers) {
+            commandBuffers.push_back(*commandBuffer);
+        }
         this->mDevice->freeCommandBuffers(
-          *this->mCommandPool, 1, this->mCommandBuffer.get());
+          *this->mCommandPool, commandBuffers.size(), commandBuffers.data());
 
         this->mCommandBuffer = nullptr;
+        this->mCommandBuffers.clear();
+        this->mCommandBufferVersions.clear();
         this->mFreeCommandBuffer = false;
 
         KP_LOG_DEBUG("Kompute Sequence Freed CommandBuffer");
@@ -247,9 +512,23 @@ Sequence::destroy()
         KP_LOG_DEBUG("Kompute Sequence Destroyed CommandPool");
     }
 
+    for (const Submission& submission : this->mInFlightSubmissions) {
+        if (!submission.batchFence) {
+            this->mSyncPool->releaseFence(submission.fence, false);
+        }
+    }
+    this->mInFlightSubmissions.clear();
+    if (this->mTimelineSemaphore) {
+        this->mSyncPool->releaseTimelineSemaphore(this->mTimelineSemaphore);
+        this->mTimelineSemaphore = vk::Semaphore();
+    }
+    this->mDependencies.clear();
+    this->mSyncPool = nullptr;
+
     if (this->mOperations.size()) {
         KP_LOG_INFO("Kompute Sequence clearing operations buffer");
         this->mOperations.clear();
+        this->mOperationVersions.clear();
     }
 
     if (this->timestampQueryPool) {
@@ -283,17 +562,64 @@ Sequence::record(std::shared_ptr<OpBase> op)
     KP_LOG_DEBUG(
       "Kompute Sequence running record on OpBase derived class instance");
 
-    op->record(*this->mCommandBuffer);
+    this->recordOperation(*this->mCommandBuffer,
+                          this->mHazardTracker,
+                          op,
+                          this->mOperations.size() + 1);
 
     this->mOperations.push_back(op);
+    this->mOperationVersions.push_back(op->recordVersion());
+
+    return shared_from_this();
+}
+
+void
+Sequence::recordOperation(const vk::CommandBuffer& commandBuffer,
+                          HazardTracker& hazardTracker,
+                          std::shared_ptr<OpBase> op,
+                          uint32_t timestampIndex)
+{
+    std::vector<TensorAccess> accesses;
+    bool declaresAccesses = op->declareAccesses(accesses);
+    if (declaresAccesses) {
+        hazardTracker.recordBarriers(commandBuffer, accesses);
+    }
+
+    op->record(commandBuffer);
+
+    // Operations that do not declare their accesses record their own barriers
+    // and may write any tensor
+    if (!declaresAccesses) {
+        hazardTracker.invalidate();
+    }
 
     if (this->timestampQueryPool)
-        this->mCommandBuffer->writeTimestamp(
-          vk::PipelineStageFlagBits::eAllCommands,
-          *this->timestampQueryPool,
-          this->mOperations.size());
+        commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eAllCommands,
+                                     *this->timestampQueryPool,
+                                     timestampIndex);
+}
 
-    return shared_from_this();
+void
+Sequence::recordCommandBuffer()
+{
+    KP_LOG_DEBUG("Kompute Sequence recording operations into command buffer "
+                 "{} of the ring",
+                 this->mCommandBufferIndex);
+
+    // The barriers are the same as the ones of the command buffer that the
+    // operations were first recorded into
+    HazardTracker hazardTracker;
+
+    this->beginCommandBuffer(*this->mCommandBuffer);
+    for (size_t i = 0; i < this->mOperations.size(); i++) {
+        this->recordOperation(
+          *this->mCommandBuffer, hazardTracker, this->mOperations[i], i + 1);
+    }
+    hazardTracker.recordHostBarriers(*this->mCommandBuffer);
+    this->mCommandBuffer->end();
+
+    this->mCommandBufferVersions[this->mCommandBufferIndex] =
+      this->mRecordingVersion;
 }
 
 void
@@ -331,9 +657,14 @@ Sequence::createCommandBuffer()
     vk::CommandBufferAllocateInfo commandBufferAllocateInfo(
       *this->mCommandPool, vk::CommandBufferLevel::ePrimary, 1);
 
-    this->mCommandBuffer = std::make_shared<vk::CommandBuffer>();
+    std::shared_ptr<vk::CommandBuffer> commandBuffer =
+      std::make_shared<vk::CommandBuffer>();
     this->mDevice->allocateCommandBuffers(&commandBufferAllocateInfo,
-                                          this->mCommandBuffer.get());
+                                          commandBuffer.get());
+
+    // Not recorded yet, as recording versions start at 1
+    this->mCommandBuffers.push_back(commandBuffer);
+    this->mCommandBufferVersions.push_back(0);
     KP_LOG_DEBUG("Kompute Sequence Command Buffer Created");
 }
 
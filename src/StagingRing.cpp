@@ -0,0 +1,349 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <iterator>
+
+#include "kompute/StagingRing.hpp"
+#include "kompute/MemoryPool.hpp"
+
+namespace kp {
+
+// Alignment of the slices, which keeps copies to and from the ring aligned
+static const vk::DeviceSize STAGING_RING_ALIGNMENT = 16;
+
+static vk::DeviceSize
+alignSliceSize(vk::DeviceSize size)
+{
+    return std::max<vk::DeviceSize>((size + STAGING_RING_ALIGNMENT - 1) /
+                                      STAGING_RING_ALIGNMENT *
+                                      STAGING_RING_ALIGNMENT,
+                                    STAGING_RING_ALIGNMENT);
+}
+
+StagingRing::Slice::Slice(std::shared_ptr<StagingRing> stagingRing,
+                          std::shared_ptr<vk::Buffer> buffer,
+                          std::shared_ptr<vk::DeviceMemory> memory,
+                          vk::DeviceSize offset,
+                          vk::DeviceSize size,
+                          void* mappedData)
+{
+    this->mStagingRing = stagingRing;
+    this->mBuffer = buffer;
+    this->mMemory = memory;
+    this->mOffset = offset;
+    this->mSize = size;
+    this->mMappedData = mappedData;
+}
+
+StagingRing::Slice::~Slice()
+{
+    if (this->mMemory) {
+        this->mStagingRing->releaseDedicated(this->mBuffer, this->mMemory);
+    } else {
+        this->mStagingRing->release(this->mOffset,
+                                    alignSliceSize(this->mSize));
+    }
+}
+
+std::shared_ptr<vk::Buffer>
+StagingRing::Slice::buffer()
+{
+    return this->mBuffer;
+}
+
+vk::DeviceSize
+StagingRing::Slice::offset()
+{
+    return this->mOffset;
+}
+
+vk::DeviceSize
+StagingRing::Slice::size()
+{
+    return this->mSize;
+}
+
+void*
+StagingRing::Slice::mappedData()
+{
+    return this->mMappedData;
+}
+
+bool
+StagingRing::Slice::isDedicated()
+{
+    return this->mMemory != nullptr;
+}
+
+StagingRing::StagingRing(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                         std::shared_ptr<vk::Device> device,
+                         vk::DeviceSize size)
+{
+    KP_LOG_DEBUG("Kompute StagingRing constructor with size {}", size);
+
+    if (!physicalDevice) {
+        throw std::runtime_error(
+          "Kompute StagingRing phyisical device is null");
+    }
+    if (!device) {
+        throw std::runtime_error("Kompute StagingRing device is null");
+    }
+    if (size < STAGING_RING_ALIGNMENT) {
+        throw std::runtime_error(
+          "Kompute StagingRing attempted to create a zero-sized ring");
+    }
+
+    this->mPhysicalDevice = physicalDevice;
+    this->mDevice = device;
+    this->mSize = size;
+    this->mFreeRegions[0] = size;
+
+    this->mBuffer = std::make_shared<vk::Buffer>();
+    this->mMemory = std::make_shared<vk::DeviceMemory>();
+    this->createBuffer(this->mBuffer, this->mMemory, size);
+
+    this->mMappedData = this->mDevice->mapMemory(
+      *this->mMemory, 0, VK_WHOLE_SIZE, vk::MemoryMapFlags());
+}
+
+StagingRing::~StagingRing()
+{
+    KP_LOG_DEBUG("Kompute StagingRing destructor started");
+
+    if (this->mDevice) {
+        this->destroy();
+    }
+}
+
+std::shared_ptr<StagingRing::Slice>
+StagingRing::allocate(vk::DeviceSize size)
+{
+    std::unique_lock<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        throw std::runtime_error(
+          "Kompute StagingRing attempted to allocate after destroy");
+    }
+
+    vk::DeviceSize alignedSize = alignSliceSize(size);
+
+    auto region = this->mFreeRegions.begin();
+    while (region != this->mFreeRegions.end() &&
+           region->second < alignedSize) {
+        region++;
+    }
+
+    if (region != this->mFreeRegions.end()) {
+        vk::DeviceSize offset = region->first;
+        vk::DeviceSize remainingSize = region->second - alignedSize;
+        this->mFreeRegions.erase(region);
+        if (remainingSize) {
+            this->mFreeRegions[offset + alignedSize] = remainingSize;
+        }
+        this->mUsedSize += alignedSize;
+
+        KP_LOG_DEBUG("Kompute StagingRing allocated {} bytes at offset {}",
+                     alignedSize,
+                     offset);
+
+        return std::make_shared<Slice>(shared_from_this(),
+                                       this->mBuffer,
+                                       nullptr,
+                                       offset,
+                                       size,
+                                       (uint8_t*)this->mMappedData + offset);
+    }
+
+    KP_LOG_INFO("Kompute StagingRing out of space allocating {} bytes with {} "
+                "of {} bytes in use, creating a dedicated buffer",
+                alignedSize,
+                this->mUsedSize,
+                this->mSize);
+
+    // Buffers are created without holding the lock so other slices can still
+    // be allocated and released in the meantime
+    lock.unlock();
+
+    std::shared_ptr<vk::Buffer> buffer = std::make_shared<vk::Buffer>();
+    std::shared_ptr<vk::DeviceMemory> memory =
+      std::make_shared<vk::DeviceMemory>();
+    this->createBuffer(buffer, memory, alignedSize);
+    void* mappedData =
+      this->mDevice->mapMemory(*memory, 0, VK_WHOLE_SIZE, vk::MemoryMapFlags());
+
+    lock.lock();
+    this->mDedicatedCount++;
+
+    return std::make_shared<Slice>(
+      shared_from_this(), buffer, memory, 0, size, mappedData);
+}
+
+void
+StagingRing::createBuffer(std::shared_ptr<vk::Buffer> buffer,
+                          std::shared_ptr<vk::DeviceMemory> memory,
+                          vk::DeviceSize size)
+{
+    vk::BufferCreateInfo bufferInfo(vk::BufferCreateFlags(),
+                                    size,
+                                    vk::BufferUsageFlagBits::eTransferSrc |
+                                      vk::BufferUsageFlagBits::eTransferDst,
+                                    vk::SharingMode::eExclusive);
+    this->mDevice->createBuffer(&bufferInfo, nullptr, buffer.get());
+
+    vk::MemoryRequirements memoryRequirements =
+      this->mDevice->getBufferMemoryRequirements(*buffer);
+
+    int32_t memoryTypeIndex = MemoryPool::findMemoryTypeIndex(
+      this->mPhysicalDevice->getMemoryProperties(),
+      memoryRequirements.memoryTypeBits,
+      vk::MemoryPropertyFlagBits::eHostVisible |
+        vk::MemoryPropertyFlagBits::eHostCoherent);
+    if (memoryTypeIndex < 0) {
+        throw std::runtime_error(
+          "Memory type index for buffer creation not found");
+    }
+
+    vk::MemoryAllocateInfo memoryAllocateInfo(memoryRequirements.size,
+                                              memoryTypeIndex);
+    this->mDevice->allocateMemory(&memoryAllocateInfo, nullptr, memory.get());
+    this->mDevice->bindBufferMemory(*buffer, *memory, 0);
+}
+
+void
+StagingRing::destroyBuffer(std::shared_ptr<vk::Buffer> buffer,
+                           std::shared_ptr<vk::DeviceMemory> memory)
+{
+    this->mDevice->unmapMemory(*memory);
+    this->mDevice->destroy(
+      *buffer, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    this->mDevice->freeMemory(
+      *memory, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+}
+
+void
+StagingRing::releaseDedicated(std::shared_ptr<vk::Buffer> buffer,
+                              std::shared_ptr<vk::DeviceMemory> memory)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    this->mDedicatedCount--;
+
+    if (!this->mDevice) {
+        KP_LOG_WARN("Kompute StagingRing dedicated slice released after "
+                    "destroy");
+        return;
+    }
+
+    KP_LOG_DEBUG("Kompute StagingRing destroying dedicated buffer");
+    this->destroyBuffer(buffer, memory);
+}
+
+void
+StagingRing::release(vk::DeviceSize offset, vk::DeviceSize size)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    this->mUsedSize -= size;
+
+    auto next = this->mFreeRegions.lower_bound(offset);
+    if (next != this->mFreeRegions.end() && next->first == offset + size) {
+        size += next->second;
+        next = this->mFreeRegions.erase(next);
+    }
+    if (next != this->mFreeRegions.begin()) {
+        auto previous = std::prev(next);
+        if (previous->first + previous->second == offset) {
+            previous->second += size;
+            return;
+        }
+    }
+    this->mFreeRegions[offset] = size;
+}
+
+void
+StagingRing::recordSliceMemoryBarrier(const vk::CommandBuffer& commandBuffer,
+                                      const Slice& slice,
+                                      vk::AccessFlagBits srcAccessMask,
+                                      vk::AccessFlagBits dstAccessMask,
+                                      vk::PipelineStageFlagBits srcStageMask,
+                                      vk::PipelineStageFlagBits dstStageMask)
+{
+    KP_LOG_DEBUG("Kompute StagingRing recording slice memory barrier");
+
+    BarrierBuilder barrierBuilder;
+    this->addSliceMemoryBarrier(barrierBuilder,
+                                slice,
+                                srcAccessMask,
+                                dstAccessMask,
+                                srcStageMask,
+                                dstStageMask);
+    barrierBuilder.record(commandBuffer);
+}
+
+void
+StagingRing::addSliceMemoryBarrier(BarrierBuilder& barrierBuilder,
+                                   const Slice& slice,
+                                   vk::AccessFlagBits srcAccessMask,
+                                   vk::AccessFlagBits dstAccessMask,
+                                   vk::PipelineStageFlagBits srcStageMask,
+                                   vk::PipelineStageFlagBits dstStageMask)
+{
+    vk::BufferMemoryBarrier bufferMemoryBarrier;
+    bufferMemoryBarrier.buffer = *slice.mBuffer;
+    bufferMemoryBarrier.offset = slice.mOffset;
+    bufferMemoryBarrier.size = slice.mSize;
+    bufferMemoryBarrier.srcAccessMask = srcAccessMask;
+    bufferMemoryBarrier.dstAccessMask = dstAccessMask;
+    bufferMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    bufferMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+
+    barrierBuilder.addBufferMemoryBarrier(
+      srcStageMask, dstStageMask, bufferMemoryBarrier);
+}
+
+void
+StagingRing::destroy()
+{
+    KP_LOG_DEBUG("Kompute StagingRing destroy started");
+
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        KP_LOG_WARN("Kompute StagingRing destroy called with null Device");
+        return;
+    }
+
+    if (this->mBuffer && this->mMemory) {
+        this->destroyBuffer(this->mBuffer, this->mMemory);
+        this->mMappedData = nullptr;
+        this->mBuffer = nullptr;
+        this->mMemory = nullptr;
+    }
+
+    this->mDevice = nullptr;
+
+    KP_LOG_DEBUG("Kompute StagingRing destroy success");
+}
+
+vk::DeviceSize
+StagingRing::size()
+{
+    return this->mSize;
+}
+
+vk::DeviceSize
+StagingRing::usedSize()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    return this->mUsedSize;
+}
+
+uint32_t
+StagingRing::dedicatedCount()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    return this->mDedicatedCount;
+}
+
+} // End namespace kp
@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <deque>
+
+#include "kompute/SubmissionBatch.hpp"
+
+namespace kp {
+
+SubmissionBatch::SubmissionBatch(
+  std::shared_ptr<vk::Device> device,
+  std::shared_ptr<SyncPool> syncPool,
+  const std::vector<std::shared_ptr<Sequence>>& sequences)
+{
+    KP_LOG_DEBUG("Kompute SubmissionBatch constructor with {} sequences",
+                 sequences.size());
+
+    if (!device) {
+        throw std::runtime_error("Kompute SubmissionBatch device is null");
+    }
+    if (!syncPool) {
+        throw std::runtime_error("Kompute SubmissionBatch sync pool is null");
+    }
+
+    // Validated upfront so no sequence is prepared if the batch cannot be
+    // submitted
+    for (size_t i = 0; i < sequences.size(); i++) {
+        const std::shared_ptr<Sequence>& sequence = sequences[i];
+        if (!sequence || !sequence->isInit()) {
+            throw std::runtime_error(
+              "Kompute SubmissionBatch sequence is not initialised");
+        }
+        if (sequence->isRunning() && sequence->getMaxInFlight() == 1) {
+            throw std::runtime_error(
+              "Kompute SubmissionBatch sequence is still running");
+        }
+        for (size_t j = 0; j < i; j++) {
+            if (sequences[j] == sequence) {
+                throw std::runtime_error(
+                  "Kompute SubmissionBatch sequence submitted twice");
+            }
+        }
+    }
+
+    this->mDevice = device;
+    this->mSequences = sequences;
+
+    // Resources are referenced by the submit infos so these must not move
+    std::deque<Sequence::SubmitResources> resources;
+    std::vector<std::shared_ptr<vk::Queue>> queues;
+    std::vector<std::shared_ptr<std::mutex>> queueMutexes;
+    std::vector<std::vector<vk::SubmitInfo>> queueSubmitInfos;
+    for (const std::shared_ptr<Sequence>& sequence : this->mSequences) {
+        resources.emplace_back();
+        sequence->prepareSubmit(resources.back());
+
+        size_t queueIndex = 0;
+        while (queueIndex < queues.size() &&
+               queues[queueIndex] != sequence->mComputeQueue) {
+            queueIndex++;
+        }
+        if (queueIndex == queues.size()) {
+            queues.push_back(sequence->mComputeQueue);
+            queueMutexes.push_back(sequence->mQueueMutex);
+            queueSubmitInfos.push_back({});
+        }
+        queueSubmitInfos[queueIndex].push_back(resources.back().submitInfo);
+        this->mSequenceFences.push_back(queueIndex);
+    }
+
+    for (size_t i = 0; i < queues.size(); i++) {
+        // Released as pending as the fence may not have been awaited
+        this->mFences.push_back(std::shared_ptr<vk::Fence>(
+          new vk::Fence(syncPool->acquireFence()),
+          [syncPool](vk::Fence* fence) {
+              syncPool->releaseFence(*fence, false);
+              delete fence;
+          }));
+
+        KP_LOG_DEBUG("Kompute SubmissionBatch submitting {} command buffers",
+                     queueSubmitInfos[i].size());
+
+        std::unique_lock<std::mutex> lock;
+        if (queueMutexes[i]) {
+            lock = std::unique_lock<std::mutex>(*queueMutexes[i]);
+        }
+        queues[i]->submit(queueSubmitInfos[i].size(),
+                          queueSubmitInfos[i].data(),
+                          *this->mFences[i]);
+    }
+
+    for (size_t i = 0; i < this->mSequences.size(); i++) {
+        const std::shared_ptr<vk::Fence>& fence =
+          this->mFences[this->mSequenceFences[i]];
+        this->mSequences[i]->mInFlightSubmissions.push_back(
+          { *fence, fence, resources[i].commandBufferIndex });
+    }
+}
+
+SubmissionBatch::~SubmissionBatch()
+{
+    KP_LOG_DEBUG("Kompute SubmissionBatch destructor started");
+}
+
+bool
+SubmissionBatch::evalAwait(uint64_t waitFor)
+{
+    std::vector<vk::Fence> fences;
+    for (const std::shared_ptr<vk::Fence>& fence : this->mFences) {
+        fences.push_back(*fence);
+    }
+
+    vk::Result result = this->mDevice->waitForFences(
+      fences.size(), fences.data(), VK_TRUE, waitFor);
+
+    if (result == vk::Result::eTimeout) {
+        KP_LOG_WARN("Kompute SubmissionBatch evalAwait reached timeout of {}",
+                    waitFor);
+        return false;
+    }
+
+    // Sequences that were already awaited no longer hold the fence
+    for (size_t i = 0; i < this->mSequences.size(); i++) {
+        this->mSequences[i]->awaitFence(
+          *this->mFences[this->mSequenceFences[i]]);
+    }
+
+    return true;
+}
+
+bool
+SubmissionBatch::isCompleted()
+{
+    for (const std::shared_ptr<vk::Fence>& fence : this->mFences) {
+        if (this->mDevice->getFenceStatus(*fence) != vk::Result::eSuccess) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const std::vector<std::shared_ptr<Sequence>>&
+SubmissionBatch::getSequences()
+{
+    return this->mSequences;
+}
+
+} // End namespace kp
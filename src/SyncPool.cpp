@@ -0,0 +1,214 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "kompute/SyncPool.hpp"
+
+namespace kp {
+
+SyncPool::SyncPool(std::shared_ptr<vk::Device> device, bool timelineSemaphores)
+{
+    KP_LOG_DEBUG("Kompute SyncPool constructor with timeline semaphores: {}",
+                 timelineSemaphores);
+
+    if (!device) {
+        throw std::runtime_error("Kompute SyncPool device is null");
+    }
+
+    this->mDevice = device;
+
+    // Extension functions are not exported by the loader
+    if (timelineSemaphores) {
+        this->mGetSemaphoreCounterValue =
+          (PFN_vkGetSemaphoreCounterValueKHR)this->mDevice->getProcAddr(
+            "vkGetSemaphoreCounterValueKHR");
+    }
+}
+
+SyncPool::~SyncPool()
+{
+    KP_LOG_DEBUG("Kompute SyncPool destructor started");
+
+    if (this->mDevice) {
+        this->destroy();
+    }
+}
+
+vk::Fence
+SyncPool::acquireFence()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        throw std::runtime_error(
+          "Kompute SyncPool attempted to acquire a fence after destroy");
+    }
+
+    // Fences released before signalling are reclaimed once these signal
+    if (this->mAvailableFences.empty() && this->mPendingFences.size()) {
+        std::vector<vk::Fence> signaledFences;
+        std::vector<vk::Fence> pendingFences;
+        for (const vk::Fence& fence : this->mPendingFences) {
+            if (this->mDevice->getFenceStatus(fence) == vk::Result::eSuccess) {
+                signaledFences.push_back(fence);
+            } else {
+                pendingFences.push_back(fence);
+            }
+        }
+        if (signaledFences.size()) {
+            this->mDevice->resetFences(signaledFences);
+            this->mAvailableFences.insert(this->mAvailableFences.end(),
+                                          signaledFences.begin(),
+                                          signaledFences.end());
+        }
+        this->mPendingFences = pendingFences;
+    }
+
+    if (this->mAvailableFences.size()) {
+        vk::Fence fence = this->mAvailableFences.back();
+        this->mAvailableFences.pop_back();
+        return fence;
+    }
+
+    KP_LOG_DEBUG("Kompute SyncPool creating fence {}", this->mFences.size());
+
+    vk::Fence fence = this->mDevice->createFence(vk::FenceCreateInfo());
+    this->mFences.push_back(fence);
+    return fence;
+}
+
+void
+SyncPool::releaseFence(vk::Fence fence, bool signaled)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        KP_LOG_WARN("Kompute SyncPool release called after destroy");
+        return;
+    }
+
+    if (!signaled) {
+        this->mPendingFences.push_back(fence);
+        return;
+    }
+
+    this->mDevice->resetFences(1, &fence);
+    this->mAvailableFences.push_back(fence);
+}
+
+bool
+SyncPool::supportsTimelineSemaphores()
+{
+    return this->mGetSemaphoreCounterValue != nullptr;
+}
+
+vk::Semaphore
+SyncPool::acquireTimelineSemaphore()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        throw std::runtime_error(
+          "Kompute SyncPool attempted to acquire a semaphore after destroy");
+    }
+    if (!this->supportsTimelineSemaphores()) {
+        throw std::runtime_error(
+          "Kompute SyncPool timeline semaphores are not supported");
+    }
+
+    vk::SemaphoreTypeCreateInfo semaphoreTypeInfo(
+      vk::SemaphoreType::eTimeline, 0);
+    vk::SemaphoreCreateInfo semaphoreInfo;
+    semaphoreInfo.setPNext(&semaphoreTypeInfo);
+
+    vk::Semaphore semaphore = this->mDevice->createSemaphore(semaphoreInfo);
+    this->mSemaphores.push_back(semaphore);
+    return semaphore;
+}
+
+void
+SyncPool::releaseTimelineSemaphore(vk::Semaphore semaphore)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        KP_LOG_WARN("Kompute SyncPool release called after destroy");
+        return;
+    }
+
+    for (size_t i = 0; i < this->mSemaphores.size(); i++) {
+        if (this->mSemaphores[i] == semaphore) {
+            this->mDevice->destroy(
+              semaphore, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+            this->mSemaphores.erase(this->mSemaphores.begin() + i);
+            return;
+        }
+    }
+}
+
+uint64_t
+SyncPool::getTimelineSemaphoreValue(vk::Semaphore semaphore)
+{
+    if (!this->mDevice || !this->supportsTimelineSemaphores()) {
+        throw std::runtime_error(
+          "Kompute SyncPool timeline semaphores are not available");
+    }
+
+    uint64_t value = 0;
+    VkResult result =
+      this->mGetSemaphoreCounterValue(static_cast<VkDevice>(*this->mDevice),
+                                      static_cast<VkSemaphore>(semaphore),
+                                      &value);
+    if (result != VK_SUCCESS) {
+        throw std::runtime_error(fmt::format(
+          "Kompute SyncPool failed to query semaphore value: {}", result));
+    }
+    return value;
+}
+
+void
+SyncPool::destroy()
+{
+    KP_LOG_DEBUG("Kompute SyncPool destroy started");
+
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        KP_LOG_WARN("Kompute SyncPool destroy called with null Device");
+        return;
+    }
+
+    for (const vk::Fence& fence : this->mFences) {
+        this->mDevice->destroy(
+          fence, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    }
+    this->mFences.clear();
+    this->mAvailableFences.clear();
+    this->mPendingFences.clear();
+
+    for (const vk::Semaphore& semaphore : this->mSemaphores) {
+        this->mDevice->destroy(
+          semaphore, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    }
+    this->mSemaphores.clear();
+
+    this->mDevice = nullptr;
+
+    KP_LOG_DEBUG("Kompute SyncPool destroy success");
+}
+
+uint32_t
+SyncPool::fenceCount()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    return this->mFences.size();
+}
+
+uint32_t
+SyncPool::availableFenceCount()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    return this->mAvailableFences.size();
+}
+
+} // End namespace kp
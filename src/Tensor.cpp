@@ -1,5 +1,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
+
 #include "kompute/Tensor.hpp"
 
 namespace kp {
@@ -41,10 +43,14 @@ Tensor::toString(Tensor::TensorTypes dt)
 Tensor::Tensor(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
                std::shared_ptr<vk::Device> device,
                void* data,
-               uint32_t elementTotalCount,
+               uint64_t elementTotalCount,
                uint32_t elementMemorySize,
                const TensorDataTypes& dataType,
-               const TensorTypes& tensorType)
+               const TensorTypes& tensorType,
+               std::shared_ptr<MemoryPool> memoryPool,
+               std::shared_ptr<StagingRing> stagingRing,
+               bool unifiedMemory,
+               bool importHostMemory)
 {
     KP_LOG_DEBUG("Kompute Tensor constructor data length: {}, and type: {}",
                  elementTotalCount,
@@ -52,12 +58,111 @@ Tensor::Tensor(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
 
     this->mPhysicalDevice = physicalDevice;
     this->mDevice = device;
+    this->mMemoryPool = memoryPool;
+    if (tensorType == TensorTypes::eDevice) {
+        this->mStagingRing = stagingRing;
+        this->mUnifiedMemory = unifiedMemory;
+    }
+    this->mImportHostMemory = importHostMemory;
     this->mDataType = dataType;
     this->mTensorType = tensorType;
 
     this->rebuild(data, elementTotalCount, elementMemorySize);
 }
 
+TensorView::TensorView(std::shared_ptr<Tensor> tensor,
+                       uint64_t elementOffset,
+                       uint64_t elementCount)
+{
+    KP_LOG_DEBUG("Kompute TensorView constructor with offset: {}, size: {}",
+                 elementOffset,
+                 elementCount);
+
+    if (!tensor || !tensor->isInit()) {
+        throw std::runtime_error(
+          "Kompute TensorView created from uninitialised tensor");
+    }
+    if (elementCount < 1 || elementOffset + elementCount > tensor->size()) {
+        throw std::runtime_error(fmt::format(
+          "Kompute TensorView range [{}, {}) out of bounds for tensor size {}",
+          elementOffset,
+          elementOffset + elementCount,
+          tensor->size()));
+    }
+
+    this->mTensor = tensor;
+    this->mElementOffset = elementOffset;
+    this->mSize = elementCount;
+
+    this->refresh();
+    tensor->mViews.push_back(this);
+}
+
+TensorView::~TensorView()
+{
+    KP_LOG_DEBUG("Kompute TensorView destructor");
+
+    std::vector<TensorView*>& views = this->mTensor->mViews;
+    views.erase(std::remove(views.begin(), views.end(), this), views.end());
+}
+
+void
+TensorView::refresh()
+{
+    KP_LOG_DEBUG("Kompute TensorView refreshing resources of tensor");
+
+    std::shared_ptr<Tensor> tensor = this->mTensor;
+
+    this->mPhysicalDevice = tensor->mPhysicalDevice;
+    this->mDevice = tensor->mDevice;
+    this->mTensorType = tensor->mTensorType;
+    this->mDataType = tensor->mDataType;
+    this->mDataTypeMemorySize = tensor->mDataTypeMemorySize;
+    this->mOffset = tensor->mOffset + (vk::DeviceSize)this->mElementOffset *
+                                        tensor->mDataTypeMemorySize;
+    this->mCapacityMemorySize = this->memorySize();
+    this->mStagingRing = tensor->mStagingRing;
+    this->mUnifiedMemory = tensor->mUnifiedMemory;
+
+    // The resources are dropped rather than left pointing to memory that the
+    // tensor no longer uses for the range of the view
+    if (!tensor->isInit() ||
+        this->mElementOffset + this->mSize > tensor->mSize) {
+        KP_LOG_WARN("Kompute TensorView range [{}, {}) no longer within the "
+                    "tensor of size {}",
+                    this->mElementOffset,
+                    this->mElementOffset + this->mSize,
+                    tensor->mSize);
+        this->mPrimaryBuffer = nullptr;
+        this->mPrimaryMemory = nullptr;
+        this->mStagingBuffer = nullptr;
+        this->mStagingMemory = nullptr;
+        this->mImportedHostData = nullptr;
+        this->mRawData = nullptr;
+    } else {
+        this->mPrimaryBuffer = tensor->mPrimaryBuffer;
+        this->mPrimaryMemory = tensor->mPrimaryMemory;
+        this->mStagingBuffer = tensor->mStagingBuffer;
+        this->mStagingMemory = tensor->mStagingMemory;
+        this->mImportedHostData = tensor->mImportedHostData;
+        this->mRawData = (uint8_t*)tensor->mRawData +
+                         (vk::DeviceSize)this->mElementOffset *
+                           tensor->mDataTypeMemorySize;
+    }
+
+    // Algorithms that bind the view update their descriptors
+    this->mGeneration++;
+    this->markDirty();
+
+    this->refreshViews();
+}
+
+std::shared_ptr<Tensor>
+TensorView::tensor()
+{
+    return this->mTensor;
+}
+
 Tensor::~Tensor()
 {
     KP_LOG_DEBUG("Kompute Tensor destructor started. Type: {}",
@@ -72,24 +177,66 @@ Tensor::~Tensor()
 
 void
 Tensor::rebuild(void* data,
-                uint32_t elementTotalCount,
+                uint64_t elementTotalCount,
                 uint32_t elementMemorySize)
 {
     KP_LOG_DEBUG("Kompute Tensor rebuilding with size {}", elementTotalCount);
 
-    this->mSize = elementTotalCount;
-    this->mDataTypeMemorySize = elementMemorySize;
+    vk::DeviceSize memorySize =
+      (vk::DeviceSize)elementTotalCount * elementMemorySize;
+
+    // Imported host memory always matches the size of the data it wraps, so
+    // it is never reused nor over-allocated
+    if (this->mPrimaryBuffer && !this->mImportHostMemory &&
+        memorySize <= this->mCapacityMemorySize) {
+        KP_LOG_DEBUG("Kompute Tensor reusing buffers with capacity {}",
+                     this->mCapacityMemorySize);
+        this->mSize = elementTotalCount;
+        this->mDataTypeMemorySize = elementMemorySize;
+    } else {
+        vk::DeviceSize capacityMemorySize = memorySize;
+        if (this->mPrimaryBuffer || this->mPrimaryMemory) {
+            KP_LOG_DEBUG(
+              "Kompute Tensor destroying existing resources before rebuild");
+            // Growing geometrically avoids reallocating on every rebuild when
+            // the size keeps increasing
+            if (!this->mImportHostMemory) {
+                capacityMemorySize = std::max(capacityMemorySize,
+                                              this->mCapacityMemorySize * 2);
+            }
+            this->freeMemoryDestroyGPUResources();
+        }
 
-    if (this->mPrimaryBuffer || this->mPrimaryMemory) {
-        KP_LOG_DEBUG(
-          "Kompute Tensor destroying existing resources before rebuild");
-        this->destroy();
+        this->mSize = elementTotalCount;
+        this->mDataTypeMemorySize = elementMemorySize;
+        this->mCapacityMemorySize = capacityMemorySize;
+
+        this->allocateMemoryCreateGPUResources(
+          this->mImportHostMemory ? data : nullptr);
+        this->mapRawData();
     }
 
-    this->allocateMemoryCreateGPUResources();
-    this->mapRawData();
+    this->mGeneration++;
+    this->refreshViews();
 
-    memcpy(this->mRawData, data, this->memorySize());
+    // Without data the memory is left uninitialised, and imported host memory
+    // already holds the data
+    if (!data) {
+        return;
+    }
+    if (this->mRawData != data) {
+        memcpy(this->mRawData, data, this->memorySize());
+    }
+
+    this->markDirty();
+}
+
+void
+Tensor::refreshViews()
+{
+    for (TensorView* view : this->mViews) {
+        view->refresh();
+    }
 }
 
 Tensor::TensorTypes
@@ -105,7 +252,13 @@ Tensor::isInit()
            this->mRawData;
 }
 
-uint32_t
+vk::DeviceSize
+Tensor::offset()
+{
+    return this->mOffset;
+}
+
+uint64_t
 Tensor::size()
 {
     return this->mSize;
@@ -117,12 +270,27 @@ Tensor::dataTypeMemorySize()
     return this->mDataTypeMemorySize;
 }
 
-uint32_t
+uint64_t
 Tensor::memorySize()
 {
     return this->mSize * this->mDataTypeMemorySize;
 }
 
+uint64_t
+Tensor::capacity()
+{
+    if (!this->mDataTypeMemorySize) {
+        return 0;
+    }
+    return this->mCapacityMemorySize / this->mDataTypeMemorySize;
+}
+
+uint64_t
+Tensor::generation()
+{
+    return this->mGeneration;
+}
+
 kp::Tensor::TensorDataTypes
 Tensor::dataType()
 {
@@ -139,6 +307,142 @@ void
 Tensor::setRawData(const void* data)
 {
     memcpy(this->mRawData, data, this->memorySize());
+
+    this->markDirty();
+}
+
+void
+Tensor::setRawData(const void* data,
+                   uint64_t elementOffset,
+                   uint64_t elementCount)
+{
+    if (elementOffset + elementCount > this->mSize) {
+        throw std::runtime_error(
+          "Kompute Tensor attempted to set data out of bounds");
+    }
+
+    memcpy((uint8_t*)this->mRawData +
+             (vk::DeviceSize)elementOffset * this->mDataTypeMemorySize,
+           data,
+           (vk::DeviceSize)elementCount * this->mDataTypeMemorySize);
+
+    this->markDirty(elementOffset, elementCount);
+}
+
+void
+Tensor::markDirty(uint64_t elementOffset, uint64_t elementCount)
+{
+    if (elementCount < 1) {
+        return;
+    }
+
+    uint64_t end = elementOffset + elementCount;
+
+    // Fast paths for sequential writes at or past the last dirty range
+    if (this->mDirtyRanges.empty()) {
+        this->mDirtyRanges.push_back({ elementOffset, elementCount });
+        return;
+    }
+    TensorRange& last = this->mDirtyRanges.back();
+    uint64_t lastEnd = last.offset + last.size;
+    if (elementOffset > lastEnd) {
+        this->mDirtyRanges.push_back({ elementOffset, elementCount });
+        return;
+    }
+    if (elementOffset >= last.offset) {
+        last.size = std::max(lastEnd, end) - last.offset;
+        return;
+    }
+
+    // Merge with all the ranges that overlap or are adjacent to the new one
+    std::vector<TensorRange> dirtyRanges;
+    dirtyRanges.reserve(this->mDirtyRanges.size() + 1);
+    bool inserted = false;
+    for (const TensorRange& range : this->mDirtyRanges) {
+        uint64_t rangeEnd = range.offset + range.size;
+        if (rangeEnd < elementOffset) {
+            dirtyRanges.push_back(range);
+        } else if (range.offset > end) {
+            if (!inserted) {
+                dirtyRanges.push_back({ elementOffset, end - elementOffset });
+                inserted = true;
+            }
+            dirtyRanges.push_back(range);
+        } else {
+            elementOffset = std::min(elementOffset, range.offset);
+            end = std::max(end, rangeEnd);
+        }
+    }
+    if (!inserted) {
+        dirtyRanges.push_back({ elementOffset, end - elementOffset });
+    }
+
+    this->mDirtyRanges = dirtyRanges;
+}
+
+void
+Tensor::markDirty()
+{
+    this->mDirtyRanges.clear();
+    if (this->mSize > 0) {
+        this->mDirtyRanges.push_back({ 0, this->mSize });
+    }
+}
+
+void
+Tensor::clearDirty()
+{
+    this->mDirtyRanges.clear();
+}
+
+void
+Tensor::clearDirty(const std::vector<TensorRange>& ranges)
+{
+    for (const TensorRange& clean : ranges) {
+        uint64_t cleanEnd = clean.offset + clean.size;
+
+        std::vector<TensorRange> dirtyRanges;
+        dirtyRanges.reserve(this->mDirtyRanges.size() + 1);
+        for (const TensorRange& range : this->mDirtyRanges) {
+            uint64_t rangeEnd = range.offset + range.size;
+            if (rangeEnd <= clean.offset || range.offset >= cleanEnd) {
+                dirtyRanges.push_back(range);
+                continue;
+            }
+            if (range.offset < clean.offset) {
+                dirtyRanges.push_back(
+                  { range.offset, clean.offset - range.offset });
+            }
+            if (rangeEnd > cleanEnd) {
+                dirtyRanges.push_back({ cleanEnd, rangeEnd - cleanEnd });
+            }
+        }
+        this->mDirtyRanges = dirtyRanges;
+    }
+}
+
+bool
+Tensor::isDirty()
+{
+    return !this->mDirtyRanges.empty();
+}
+
+const std::vector<TensorRange>&
+Tensor::dirtyRanges()
+{
+    return this->mDirtyRanges;
+}
+
+uint64_t
+Tensor::bytesUploaded()
+{
+    return this->mBytesUploaded;
+}
+
+uint64_t
+Tensor::bytesSkipped()
+{
+    return this->mBytesSkipped;
 }
 
 void
@@ -147,19 +451,43 @@ Tensor::mapRawData()
 
     KP_LOG_DEBUG("Kompute Tensor mapping data from host buffer");
 
+    // Imported host memory is accessed through the pointer it was created from
+    if (this->mImportedHostData) {
+        this->mRawData = this->mImportedHostData;
+        return;
+    }
+
+    // Data is transferred through the staging ring so it is kept in host
+    // memory rather than in a dedicated host visible buffer
+    if (this->mTensorType == TensorTypes::eDevice && this->mStagingRing &&
+        !this->mUnifiedMemory) {
+        this->mHostData.resize(this->mCapacityMemorySize);
+        this->mRawData = this->mHostData.data();
+        return;
+    }
+
     std::shared_ptr<vk::DeviceMemory> hostVisibleMemory = nullptr;
+    MemoryPool::Allocation* hostVisibleAllocation = nullptr;
 
-    if (this->mTensorType == TensorTypes::eHost) {
+    if (this->mTensorType == TensorTypes::eHost || this->mUnifiedMemory) {
         hostVisibleMemory = this->mPrimaryMemory;
+        hostVisibleAllocation = &this->mPrimaryAllocation;
     } else if (this->mTensorType == TensorTypes::eDevice) {
         hostVisibleMemory = this->mStagingMemory;
+        hostVisibleAllocation = &this->mStagingAllocation;
     } else {
         KP_LOG_WARN(
           "Kompute Tensor mapping data not supported on storage tensor");
         return;
     }
 
-    vk::DeviceSize bufferSize = this->memorySize();
+    // Pool memory blocks are persistently mapped so the pointer is reused
+    if (hostVisibleAllocation->mappedData) {
+        this->mRawData = hostVisibleAllocation->mappedData;
+        return;
+    }
+
+    vk::DeviceSize bufferSize = this->mCapacityMemorySize;
 
     // Given we request coherent host memory we don't need to invalidate /
     // flush
@@ -176,18 +504,29 @@ Tensor::unmapRawData()
     KP_LOG_DEBUG("Kompute Tensor mapping data from host buffer");
 
     std::shared_ptr<vk::DeviceMemory> hostVisibleMemory = nullptr;
+    bool freeHostVisibleMemory = false;
 
-    if (this->mTensorType == TensorTypes::eHost) {
+    if (this->mTensorType == TensorTypes::eHost || this->mUnifiedMemory) {
         hostVisibleMemory = this->mPrimaryMemory;
+        freeHostVisibleMemory = this->mFreePrimaryMemory;
     } else if (this->mTensorType == TensorTypes::eDevice) {
         hostVisibleMemory = this->mStagingMemory;
+        freeHostVisibleMemory = this->mFreeStagingMemory;
     } else {
         KP_LOG_WARN(
           "Kompute Tensor mapping data not supported on storage tensor");
         return;
     }
 
-    vk::DeviceSize bufferSize = this->memorySize();
+    // Memory that is not owned is either a persistently mapped pool block or
+    // the memory of the tensor a view was created from, and imported host
+    // memory is never mapped
+    if (!freeHostVisibleMemory || !hostVisibleMemory ||
+        this->mImportedHostData) {
+        return;
+    }
+
+    vk::DeviceSize bufferSize = this->mCapacityMemorySize;
     vk::MappedMemoryRange mappedRange(*hostVisibleMemory, 0, bufferSize);
     this->mDevice->flushMappedMemoryRanges(1, &mappedRange);
     this->mDevice->unmapMemory(*hostVisibleMemory);
@@ -199,7 +538,8 @@ Tensor::recordCopyFrom(const vk::CommandBuffer& commandBuffer,
 {
 
     vk::DeviceSize bufferSize(this->memorySize());
-    vk::BufferCopy copyRegion(0, 0, bufferSize);
+    vk::BufferCopy copyRegion(
+      copyFromTensor->mOffset, this->mOffset, bufferSize);
 
     KP_LOG_DEBUG("Kompute Tensor recordCopyFrom data size {}.", bufferSize);
 
@@ -210,11 +550,36 @@ Tensor::recordCopyFrom(const vk::CommandBuffer& commandBuffer,
                            copyRegion);
 }
 
+void
+Tensor::recordFill(const vk::CommandBuffer& commandBuffer, uint32_t value)
+{
+    vk::DeviceSize bufferSize = this->memorySize();
+
+    KP_LOG_DEBUG("Kompute Tensor filling buffer size {} with value {}",
+                 bufferSize,
+                 value);
+
+    if (!this->mPrimaryBuffer) {
+        throw std::runtime_error(
+          "Kompute Tensor attempted to record fill with null buffer");
+    }
+    if (this->mOffset % 4 || bufferSize % 4) {
+        throw std::runtime_error(fmt::format(
+          "Kompute Tensor fill requires offset {} and size {} to be multiples "
+          "of 4 bytes",
+          this->mOffset,
+          bufferSize));
+    }
+
+    commandBuffer.fillBuffer(
+      *this->mPrimaryBuffer, this->mOffset, bufferSize, value);
+}
+
 void
 Tensor::recordCopyFromStagingToDevice(const vk::CommandBuffer& commandBuffer)
 {
     vk::DeviceSize bufferSize(this->memorySize());
-    vk::BufferCopy copyRegion(0, 0, bufferSize);
+    vk::BufferCopy copyRegion(this->mOffset, this->mOffset, bufferSize);
 
     KP_LOG_DEBUG("Kompute Tensor copying data size {}.", bufferSize);
 
@@ -225,11 +590,21 @@ Tensor::recordCopyFromStagingToDevice(const vk::CommandBuffer& commandBuffer)
                            copyRegion);
 }
 
+void
+Tensor::recordCopyFromStagingToDevice(const vk::CommandBuffer& commandBuffer,
+                                      const std::vector<TensorRange>& ranges)
+{
+    KP_LOG_DEBUG("Kompute Tensor copying {} ranges to device", ranges.size());
+
+    this->recordCopyBufferRanges(
+      commandBuffer, this->mStagingBuffer, this->mPrimaryBuffer, ranges);
+}
+
 void
 Tensor::recordCopyFromDeviceToStaging(const vk::CommandBuffer& commandBuffer)
 {
     vk::DeviceSize bufferSize(this->memorySize());
-    vk::BufferCopy copyRegion(0, 0, bufferSize);
+    vk::BufferCopy copyRegion(this->mOffset, this->mOffset, bufferSize);
 
     KP_LOG_DEBUG("Kompute Tensor copying data size {}.", bufferSize);
 
@@ -240,6 +615,16 @@ Tensor::recordCopyFromDeviceToStaging(const vk::CommandBuffer& commandBuffer)
                            copyRegion);
 }
 
+void
+Tensor::recordCopyFromDeviceToStaging(const vk::CommandBuffer& commandBuffer,
+                                      const std::vector<TensorRange>& ranges)
+{
+    KP_LOG_DEBUG("Kompute Tensor copying {} ranges to staging", ranges.size());
+
+    this->recordCopyBufferRanges(
+      commandBuffer, this->mPrimaryBuffer, this->mStagingBuffer, ranges);
+}
+
 void
 Tensor::recordCopyBuffer(const vk::CommandBuffer& commandBuffer,
                          std::shared_ptr<vk::Buffer> bufferFrom,
@@ -247,25 +632,164 @@ Tensor::recordCopyBuffer(const vk::CommandBuffer& commandBuffer,
                          vk::DeviceSize /*bufferSize*/,
                          vk::BufferCopy copyRegion)
 {
+    if (!bufferFrom || !bufferTo) {
+        throw std::runtime_error(
+          "Kompute Tensor attempted to record copy with null buffer");
+    }
 
     commandBuffer.copyBuffer(*bufferFrom, *bufferTo, copyRegion);
 }
 
+void
+Tensor::recordCopyBufferRanges(const vk::CommandBuffer& commandBuffer,
+                               std::shared_ptr<vk::Buffer> bufferFrom,
+                               std::shared_ptr<vk::Buffer> bufferTo,
+                               const std::vector<TensorRange>& ranges)
+{
+    if (ranges.empty()) {
+        return;
+    }
+    if (!bufferFrom || !bufferTo) {
+        throw std::runtime_error(
+          "Kompute Tensor attempted to record copy with null buffer");
+    }
+
+    std::vector<vk::BufferCopy> copyRegions;
+    copyRegions.reserve(ranges.size());
+    for (const TensorRange& range : ranges) {
+        vk::DeviceSize offset =
+          this->mOffset +
+          (vk::DeviceSize)range.offset * this->mDataTypeMemorySize;
+        vk::DeviceSize size =
+          (vk::DeviceSize)range.size * this->mDataTypeMemorySize;
+        copyRegions.push_back(vk::BufferCopy(offset, offset, size));
+    }
+
+    commandBuffer.copyBuffer(*bufferFrom, *bufferTo, copyRegions);
+}
+
+std::shared_ptr<StagingRing>
+Tensor::stagingRing()
+{
+    return this->mStagingRing;
+}
+
+bool
+Tensor::isUnifiedMemory()
+{
+    return this->mUnifiedMemory;
+}
+
+bool
+Tensor::isHostMemoryImported()
+{
+    return this->mImportedHostData != nullptr;
+}
+
+void
+Tensor::recordCopyFromStagingRing(const vk::CommandBuffer& commandBuffer,
+                                  StagingRing::Slice& slice,
+                                  const std::vector<TensorRange>& ranges)
+{
+    KP_LOG_DEBUG("Kompute Tensor copying {} ranges from staging ring",
+                 ranges.size());
+
+    std::vector<vk::BufferCopy> copyRegions;
+    vk::DeviceSize sliceOffset = slice.offset();
+    for (const TensorRange& range : ranges) {
+        vk::DeviceSize size =
+          (vk::DeviceSize)range.size * this->mDataTypeMemorySize;
+        copyRegions.push_back(vk::BufferCopy(
+          sliceOffset,
+          this->mOffset +
+            (vk::DeviceSize)range.offset * this->mDataTypeMemorySize,
+          size));
+        sliceOffset += size;
+    }
+
+    if (!copyRegions.empty()) {
+        commandBuffer.copyBuffer(
+          *slice.buffer(), *this->mPrimaryBuffer, copyRegions);
+    }
+}
+
+void
+Tensor::recordCopyToStagingRing(const vk::CommandBuffer& commandBuffer,
+                                StagingRing::Slice& slice,
+                                const std::vector<TensorRange>& ranges)
+{
+    KP_LOG_DEBUG("Kompute Tensor copying {} ranges to staging ring",
+                 ranges.size());
+
+    std::vector<vk::BufferCopy> copyRegions;
+    vk::DeviceSize sliceOffset = slice.offset();
+    for (const TensorRange& range : ranges) {
+        vk::DeviceSize size =
+          (vk::DeviceSize)range.size * this->mDataTypeMemorySize;
+        copyRegions.push_back(vk::BufferCopy(
+          this->mOffset +
+            (vk::DeviceSize)range.offset * this->mDataTypeMemorySize,
+          sliceOffset,
+          size));
+        sliceOffset += size;
+    }
+
+    if (!copyRegions.empty()) {
+        commandBuffer.copyBuffer(
+          *this->mPrimaryBuffer, *slice.buffer(), copyRegions);
+    }
+}
+
+void
+Tensor::writeToStagingRing(StagingRing::Slice& slice,
+                           const std::vector<TensorRange>& ranges)
+{
+    uint8_t* sliceData = (uint8_t*)slice.mappedData();
+    for (const TensorRange& range : ranges) {
+        vk::DeviceSize size =
+          (vk::DeviceSize)range.size * this->mDataTypeMemorySize;
+        memcpy(sliceData,
+               (uint8_t*)this->mRawData +
+                 (vk::DeviceSize)range.offset * this->mDataTypeMemorySize,
+               size);
+        sliceData += size;
+    }
+}
+
+void
+Tensor::readFromStagingRing(StagingRing::Slice& slice,
+                            const std::vector<TensorRange>& ranges)
+{
+    uint8_t* sliceData = (uint8_t*)slice.mappedData();
+    for (const TensorRange& range : ranges) {
+        vk::DeviceSize size =
+          (vk::DeviceSize)range.size * this->mDataTypeMemorySize;
+        memcpy((uint8_t*)this->mRawData +
+                 (vk::DeviceSize)range.offset * this->mDataTypeMemorySize,
+               sliceData,
+               size);
+        sliceData += size;
+    }
+}
+
 void
 Tensor::recordPrimaryBufferMemoryBarrier(const vk::CommandBuffer& commandBuffer,
                                          vk::AccessFlagBits srcAccessMask,
                                          vk::AccessFlagBits dstAccessMask,
                                          vk::PipelineStageFlagBits srcStageMask,
-                                         vk::PipelineStageFlagBits dstStageMask)
+                                         vk::PipelineStageFlagBits dstStageMask,
+                                         const std::vector<TensorRange>& ranges)
 {
     KP_LOG_DEBUG("Kompute Tensor recording PRIMARY buffer memory barrier");
 
-    this->recordBufferMemoryBarrier(commandBuffer,
-                                    *this->mPrimaryBuffer,
-                                    srcAccessMask,
-                                    dstAccessMask,
-                                    srcStageMask,
-                                    dstStageMask);
+    BarrierBuilder barrierBuilder;
+    this->addPrimaryBufferMemoryBarrier(barrierBuilder,
+                                        srcAccessMask,
+                                        dstAccessMask,
+                                        srcStageMask,
+                                        dstStageMask,
+                                        ranges);
+    barrierBuilder.record(commandBuffer);
 }
 
 void
@@ -273,44 +797,108 @@ Tensor::recordStagingBufferMemoryBarrier(const vk::CommandBuffer& commandBuffer,
                                          vk::AccessFlagBits srcAccessMask,
                                          vk::AccessFlagBits dstAccessMask,
                                          vk::PipelineStageFlagBits srcStageMask,
-                                         vk::PipelineStageFlagBits dstStageMask)
+                                         vk::PipelineStageFlagBits dstStageMask,
+                                         const std::vector<TensorRange>& ranges)
 {
-    KP_LOG_DEBUG("Kompute Tensor recording PRIMARY buffer memory barrier");
-
-    this->recordBufferMemoryBarrier(commandBuffer,
-                                    *this->mStagingBuffer,
-                                    srcAccessMask,
-                                    dstAccessMask,
-                                    srcStageMask,
-                                    dstStageMask);
+    KP_LOG_DEBUG("Kompute Tensor recording STAGING buffer memory barrier");
+
+    BarrierBuilder barrierBuilder;
+    this->addStagingBufferMemoryBarrier(barrierBuilder,
+                                        srcAccessMask,
+                                        dstAccessMask,
+                                        srcStageMask,
+                                        dstStageMask,
+                                        ranges);
+    barrierBuilder.record(commandBuffer);
 }
 
 void
-Tensor::recordBufferMemoryBarrier(const vk::CommandBuffer& commandBuffer,
-                                  const vk::Buffer& buffer,
-                                  vk::AccessFlagBits srcAccessMask,
-                                  vk::AccessFlagBits dstAccessMask,
-                                  vk::PipelineStageFlagBits srcStageMask,
-                                  vk::PipelineStageFlagBits dstStageMask)
+Tensor::addPrimaryBufferMemoryBarrier(BarrierBuilder& barrierBuilder,
+                                      vk::AccessFlagBits srcAccessMask,
+                                      vk::AccessFlagBits dstAccessMask,
+                                      vk::PipelineStageFlagBits srcStageMask,
+                                      vk::PipelineStageFlagBits dstStageMask,
+                                      const std::vector<TensorRange>& ranges)
 {
-    KP_LOG_DEBUG("Kompute Tensor recording buffer memory barrier");
+    this->addBufferMemoryBarrier(barrierBuilder,
+                                 *this->mPrimaryBuffer,
+                                 srcAccessMask,
+                                 dstAccessMask,
+                                 srcStageMask,
+                                 dstStageMask,
+                                 ranges);
+}
 
-    vk::DeviceSize bufferSize = this->memorySize();
+void
+Tensor::addStagingBufferMemoryBarrier(BarrierBuilder& barrierBuilder,
+                                      vk::AccessFlagBits srcAccessMask,
+                                      vk::AccessFlagBits dstAccessMask,
+                                      vk::PipelineStageFlagBits srcStageMask,
+                                      vk::PipelineStageFlagBits dstStageMask,
+                                      const std::vector<TensorRange>& ranges)
+{
+    this->addBufferMemoryBarrier(barrierBuilder,
+                                 *this->mStagingBuffer,
+                                 srcAccessMask,
+                                 dstAccessMask,
+                                 srcStageMask,
+                                 dstStageMask,
+                                 ranges);
+}
 
+void
+Tensor::addBufferMemoryBarrier(BarrierBuilder& barrierBuilder,
+                               const vk::Buffer& buffer,
+                               vk::AccessFlagBits srcAccessMask,
+                               vk::AccessFlagBits dstAccessMask,
+                               vk::PipelineStageFlagBits srcStageMask,
+                               vk::PipelineStageFlagBits dstStageMask,
+                               const std::vector<TensorRange>& ranges)
+{
     vk::BufferMemoryBarrier bufferMemoryBarrier;
     bufferMemoryBarrier.buffer = buffer;
-    bufferMemoryBarrier.size = bufferSize;
+    bufferMemoryBarrier.offset = this->mOffset;
+    bufferMemoryBarrier.size = this->memorySize();
     bufferMemoryBarrier.srcAccessMask = srcAccessMask;
     bufferMemoryBarrier.dstAccessMask = dstAccessMask;
     bufferMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
     bufferMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
 
-    commandBuffer.pipelineBarrier(srcStageMask,
-                                  dstStageMask,
-                                  vk::DependencyFlags(),
-                                  nullptr,
-                                  bufferMemoryBarrier,
-                                  nullptr);
+    // A single barrier covering the whole tensor is used unless ranges are
+    // provided, in which case a barrier is added for each of the ranges
+    if (ranges.empty()) {
+        barrierBuilder.addBufferMemoryBarrier(
+          srcStageMask, dstStageMask, bufferMemoryBarrier);
+    }
+    for (const TensorRange& range : ranges) {
+        bufferMemoryBarrier.offset =
+          this->mOffset +
+          (vk::DeviceSize)range.offset * this->mDataTypeMemorySize;
+        bufferMemoryBarrier.size =
+          (vk::DeviceSize)range.size * this->mDataTypeMemorySize;
+        barrierBuilder.addBufferMemoryBarrier(
+          srcStageMask, dstStageMask, bufferMemoryBarrier);
+    }
+}
+
+vk::BufferMemoryBarrier
+Tensor::constructPrimaryBufferMemoryBarrier(vk::AccessFlags srcAccessMask,
+                                            vk::AccessFlags dstAccessMask)
+{
+    if (!this->mPrimaryBuffer) {
+        throw std::runtime_error(
+          "Kompute Tensor attempted to construct barrier with null buffer");
+    }
+
+    vk::BufferMemoryBarrier bufferMemoryBarrier;
+    bufferMemoryBarrier.buffer = *this->mPrimaryBuffer;
+    bufferMemoryBarrier.offset = this->mOffset;
+    bufferMemoryBarrier.size = this->memorySize();
+    bufferMemoryBarrier.srcAccessMask = srcAccessMask;
+    bufferMemoryBarrier.dstAccessMask = dstAccessMask;
+    bufferMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    bufferMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    return bufferMemoryBarrier;
 }
 
 vk::DescriptorBufferInfo
@@ -319,11 +907,111 @@ Tensor::constructDescriptorBufferInfo()
     KP_LOG_DEBUG("Kompute Tensor construct descriptor buffer info size {}",
                  this->memorySize());
     vk::DeviceSize bufferSize = this->memorySize();
+
+    if (!this->mPrimaryBuffer) {
+        throw std::runtime_error(
+          "Kompute Tensor attempted to bind descriptor with null buffer");
+    }
+    if (this->mOffset) {
+        vk::DeviceSize alignment = this->mPhysicalDevice->getProperties()
+                                     .limits.minStorageBufferOffsetAlignment;
+        if (alignment && this->mOffset % alignment) {
+            throw std::runtime_error(fmt::format(
+              "Kompute Tensor offset {} is not a multiple of the storage "
+              "buffer offset alignment {}",
+              this->mOffset,
+              alignment));
+        }
+    }
+
     return vk::DescriptorBufferInfo(*this->mPrimaryBuffer,
-                                    0, // offset
+                                    this->mOffset,
                                     bufferSize);
 }
 
+std::vector<vk::DescriptorBufferInfo>
+Tensor::constructDescriptorBufferInfos()
+{
+    vk::DeviceSize memorySize = this->memorySize();
+    vk::DeviceSize chunkMemorySize = this->getDescriptorChunkMemorySize();
+
+    if (chunkMemorySize >= memorySize) {
+        return { this->constructDescriptorBufferInfo() };
+    }
+
+    KP_LOG_DEBUG("Kompute Tensor construct {} descriptor buffer infos of size "
+                 "{}",
+                 this->descriptorCount(),
+                 chunkMemorySize);
+
+    // Validates the offset of the tensor within the buffer
+    this->constructDescriptorBufferInfo();
+
+    std::vector<vk::DescriptorBufferInfo> descriptorBufferInfos;
+    for (vk::DeviceSize offset = 0; offset < memorySize;
+         offset += chunkMemorySize) {
+        descriptorBufferInfos.push_back(vk::DescriptorBufferInfo(
+          *this->mPrimaryBuffer,
+          this->mOffset + offset,
+          std::min(chunkMemorySize, memorySize - offset)));
+    }
+    return descriptorBufferInfos;
+}
+
+uint32_t
+Tensor::descriptorCount()
+{
+    vk::DeviceSize memorySize = this->memorySize();
+    vk::DeviceSize chunkMemorySize = this->getDescriptorChunkMemorySize();
+
+    if (chunkMemorySize >= memorySize) {
+        return 1;
+    }
+    return (uint32_t)((memorySize + chunkMemorySize - 1) / chunkMemorySize);
+}
+
+uint64_t
+Tensor::descriptorChunkSize()
+{
+    if (!this->mDataTypeMemorySize) {
+        return 0;
+    }
+    return this->getDescriptorChunkMemorySize() / this->mDataTypeMemorySize;
+}
+
+vk::DeviceSize
+Tensor::getDescriptorChunkMemorySize()
+{
+    vk::PhysicalDeviceLimits limits =
+      this->mPhysicalDevice->getProperties().limits;
+    vk::DeviceSize memorySize = this->memorySize();
+
+    if (memorySize <= limits.maxStorageBufferRange) {
+        return memorySize;
+    }
+
+    // Every chunk has to start at an offset that is a multiple of both the
+    // storage buffer offset alignment and the element size
+    vk::DeviceSize alignment =
+      std::max<vk::DeviceSize>(limits.minStorageBufferOffsetAlignment, 1);
+    vk::DeviceSize granularity = alignment;
+    while (granularity % this->mDataTypeMemorySize) {
+        granularity += alignment;
+    }
+
+    vk::DeviceSize chunkMemorySize =
+      limits.maxStorageBufferRange / granularity * granularity;
+    if (!chunkMemorySize) {
+        throw std::runtime_error(fmt::format(
+          "Kompute Tensor cannot split {} bytes into descriptors of at most {} "
+          "bytes aligned to {} bytes",
+          memorySize,
+          limits.maxStorageBufferRange,
+          granularity));
+    }
+    return chunkMemorySize;
+}
+
 vk::BufferUsageFlags
 Tensor::getPrimaryBufferUsageFlags()
 {
@@ -351,6 +1039,11 @@ Tensor::getPrimaryMemoryPropertyFlags()
 {
     switch (this->mTensorType) {
         case TensorTypes::eDevice:
+            if (this->mUnifiedMemory) {
+                return vk::MemoryPropertyFlagBits::eDeviceLocal |
+                       vk::MemoryPropertyFlagBits::eHostVisible |
+                       vk::MemoryPropertyFlagBits::eHostCoherent;
+            }
             return vk::MemoryPropertyFlagBits::eDeviceLocal;
             break;
         case TensorTypes::eHost:
@@ -392,7 +1085,7 @@ Tensor::getStagingMemoryPropertyFlags()
 }
 
 void
-Tensor::allocateMemoryCreateGPUResources()
+Tensor::allocateMemoryCreateGPUResources(void* importData)
 {
     KP_LOG_DEBUG("Kompute Tensor creating buffer");
 
@@ -406,38 +1099,209 @@ Tensor::allocateMemoryCreateGPUResources()
     KP_LOG_DEBUG("Kompute Tensor creating primary buffer and memory");
 
     this->mPrimaryBuffer = std::make_shared<vk::Buffer>();
-    this->createBuffer(this->mPrimaryBuffer,
-                       this->getPrimaryBufferUsageFlags());
-    this->mFreePrimaryBuffer = true;
     this->mPrimaryMemory = std::make_shared<vk::DeviceMemory>();
-    this->allocateBindMemory(this->mPrimaryBuffer,
-                             this->mPrimaryMemory,
-                             this->getPrimaryMemoryPropertyFlags());
-    this->mFreePrimaryMemory = true;
 
-    if (this->mTensorType == TensorTypes::eDevice) {
+    if (importData && this->mTensorType == TensorTypes::eHost &&
+        this->importHostMemory(this->mPrimaryBuffer,
+                               this->mPrimaryMemory,
+                               this->getPrimaryBufferUsageFlags(),
+                               this->getPrimaryMemoryPropertyFlags(),
+                               importData)) {
+        this->mFreePrimaryBuffer = true;
+        this->mFreePrimaryMemory = true;
+        this->mImportedHostData = importData;
+    } else {
+        this->createBuffer(this->mPrimaryBuffer,
+                           this->getPrimaryBufferUsageFlags());
+        this->mFreePrimaryBuffer = true;
+
+        if (this->mUnifiedMemory &&
+            !this->supportsUnifiedMemory(this->mPrimaryBuffer)) {
+            KP_LOG_DEBUG(
+              "Kompute Tensor unified memory not available on device");
+            this->mUnifiedMemory = false;
+        }
+
+        if (this->mMemoryPool) {
+            this->allocateBindPoolMemory(this->mPrimaryBuffer,
+                                         this->mPrimaryMemory,
+                                         this->getPrimaryMemoryPropertyFlags(),
+                                         this->mPrimaryAllocation);
+            this->mFreePrimaryAllocation = true;
+        } else {
+            this->allocateBindMemory(this->mPrimaryBuffer,
+                                     this->mPrimaryMemory,
+                                     this->getPrimaryMemoryPropertyFlags());
+            this->mFreePrimaryMemory = true;
+        }
+    }
+
+    if (this->mTensorType == TensorTypes::eDevice && !this->mStagingRing &&
+        !this->mUnifiedMemory) {
         KP_LOG_DEBUG("Kompute Tensor creating staging buffer and memory");
 
         this->mStagingBuffer = std::make_shared<vk::Buffer>();
-        this->createBuffer(this->mStagingBuffer,
-                           this->getStagingBufferUsageFlags());
-        this->mFreeStagingBuffer = true;
         this->mStagingMemory = std::make_shared<vk::DeviceMemory>();
-        this->allocateBindMemory(this->mStagingBuffer,
-                                 this->mStagingMemory,
-                                 this->getStagingMemoryPropertyFlags());
-        this->mFreeStagingMemory = true;
+
+        if (importData &&
+            this->importHostMemory(this->mStagingBuffer,
+                                   this->mStagingMemory,
+                                   this->getStagingBufferUsageFlags(),
+                                   this->getStagingMemoryPropertyFlags(),
+                                   importData)) {
+            this->mFreeStagingBuffer = true;
+            this->mFreeStagingMemory = true;
+            this->mImportedHostData = importData;
+        } else {
+            this->createBuffer(this->mStagingBuffer,
+                               this->getStagingBufferUsageFlags());
+            this->mFreeStagingBuffer = true;
+            if (this->mMemoryPool) {
+                this->allocateBindPoolMemory(
+                  this->mStagingBuffer,
+                  this->mStagingMemory,
+                  this->getStagingMemoryPropertyFlags(),
+                  this->mStagingAllocation);
+                this->mFreeStagingAllocation = true;
+            } else {
+                this->allocateBindMemory(this->mStagingBuffer,
+                                         this->mStagingMemory,
+                                         this->getStagingMemoryPropertyFlags());
+                this->mFreeStagingMemory = true;
+            }
+        }
+    }
+
+    if (importData && !this->mImportedHostData) {
+        KP_LOG_DEBUG("Kompute Tensor could not import host memory so the "
+                     "data is copied instead");
     }
 
     KP_LOG_DEBUG("Kompute Tensor buffer & memory creation successful");
 }
 
+bool
+Tensor::importHostMemory(std::shared_ptr<vk::Buffer> buffer,
+                         std::shared_ptr<vk::DeviceMemory> memory,
+                         vk::BufferUsageFlags bufferUsageFlags,
+                         vk::MemoryPropertyFlags memoryPropertyFlags,
+                         void* data)
+{
+    KP_LOG_DEBUG("Kompute Tensor importing host memory");
+
+    vk::DeviceSize bufferSize = this->memorySize();
+
+    // Both the pointer and the size have to be aligned to the import
+    // granularity of the device, which is usually the page size
+    vk::PhysicalDeviceExternalMemoryHostPropertiesEXT hostProperties;
+    vk::PhysicalDeviceProperties2 properties;
+    properties.pNext = &hostProperties;
+    this->mPhysicalDevice->getProperties2(&properties);
+    vk::DeviceSize alignment = hostProperties.minImportedHostPointerAlignment;
+    if (!alignment || (uintptr_t)data % alignment ||
+        bufferSize % alignment) {
+        KP_LOG_DEBUG("Kompute Tensor host pointer or size {} not aligned to {}",
+                     bufferSize,
+                     alignment);
+        return false;
+    }
+
+    PFN_vkGetMemoryHostPointerPropertiesEXT getMemoryHostPointerProperties =
+      (PFN_vkGetMemoryHostPointerPropertiesEXT)this->mDevice->getProcAddr(
+        "vkGetMemoryHostPointerPropertiesEXT");
+    if (!getMemoryHostPointerProperties) {
+        return false;
+    }
+
+    VkMemoryHostPointerPropertiesEXT hostPointerProperties = {};
+    hostPointerProperties.sType =
+      VK_STRUCTURE_TYPE_MEMORY_HOST_POINTER_PROPERTIES_EXT;
+    if (getMemoryHostPointerProperties(
+          static_cast<VkDevice>(*this->mDevice),
+          VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT,
+          data,
+          &hostPointerProperties) != VK_SUCCESS) {
+        return false;
+    }
+
+    vk::ExternalMemoryBufferCreateInfo externalMemoryInfo(
+      vk::ExternalMemoryHandleTypeFlagBits::eHostAllocationEXT);
+    vk::BufferCreateInfo bufferInfo(vk::BufferCreateFlags(),
+                                    bufferSize,
+                                    bufferUsageFlags,
+                                    vk::SharingMode::eExclusive);
+    bufferInfo.pNext = &externalMemoryInfo;
+    this->mDevice->createBuffer(&bufferInfo, nullptr, buffer.get());
+
+    vk::MemoryRequirements memoryRequirements =
+      this->mDevice->getBufferMemoryRequirements(*buffer);
+
+    int32_t memoryTypeIndex = MemoryPool::findMemoryTypeIndex(
+      this->mPhysicalDevice->getMemoryProperties(),
+      memoryRequirements.memoryTypeBits & hostPointerProperties.memoryTypeBits,
+      memoryPropertyFlags);
+    if (memoryTypeIndex < 0 || memoryRequirements.size > bufferSize) {
+        this->mDevice->destroy(
+          *buffer, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        return false;
+    }
+
+    vk::ImportMemoryHostPointerInfoEXT importInfo(
+      vk::ExternalMemoryHandleTypeFlagBits::eHostAllocationEXT, data);
+    vk::MemoryAllocateInfo memoryAllocateInfo(bufferSize, memoryTypeIndex);
+    memoryAllocateInfo.pNext = &importInfo;
+
+    this->mDevice->allocateMemory(&memoryAllocateInfo, nullptr, memory.get());
+
+    this->mDevice->bindBufferMemory(*buffer, *memory, 0);
+
+    return true;
+}
+
+bool
+Tensor::supportsUnifiedMemory(std::shared_ptr<vk::Buffer> buffer)
+{
+    vk::PhysicalDeviceMemoryProperties memoryProperties =
+      this->mPhysicalDevice->getMemoryProperties();
+
+    vk::MemoryRequirements memoryRequirements =
+      this->mDevice->getBufferMemoryRequirements(*buffer);
+
+    vk::MemoryPropertyFlags memoryPropertyFlags =
+      vk::MemoryPropertyFlagBits::eDeviceLocal |
+      vk::MemoryPropertyFlagBits::eHostVisible |
+      vk::MemoryPropertyFlagBits::eHostCoherent;
+
+    vk::DeviceSize largestDeviceHeapSize = 0;
+    for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++) {
+        if (memoryProperties.memoryHeaps[i].flags &
+            vk::MemoryHeapFlagBits::eDeviceLocal) {
+            largestDeviceHeapSize = std::max(
+              largestDeviceHeapSize, memoryProperties.memoryHeaps[i].size);
+        }
+    }
+
+    // Discrete devices without resizable BAR only expose a small host visible
+    // window of device memory, which is not used to back tensors
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+        const vk::MemoryType& memoryType = memoryProperties.memoryTypes[i];
+        if ((memoryRequirements.memoryTypeBits & (1 << i)) &&
+            (memoryType.propertyFlags & memoryPropertyFlags) ==
+              memoryPropertyFlags &&
+            memoryProperties.memoryHeaps[memoryType.heapIndex].size >=
+              largestDeviceHeapSize) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void
 Tensor::createBuffer(std::shared_ptr<vk::Buffer> buffer,
                      vk::BufferUsageFlags bufferUsageFlags)
 {
 
-    vk::DeviceSize bufferSize = this->memorySize();
+    vk::DeviceSize bufferSize = this->mCapacityMemorySize;
 
     if (bufferSize < 1) {
         throw std::runtime_error(
@@ -504,24 +1368,31 @@ Tensor::allocateBindMemory(std::shared_ptr<vk::Buffer> buffer,
 }
 
 void
-Tensor::destroy()
+Tensor::allocateBindPoolMemory(std::shared_ptr<vk::Buffer> buffer,
+                               std::shared_ptr<vk::DeviceMemory> memory,
+                               vk::MemoryPropertyFlags memoryPropertyFlags,
+                               MemoryPool::Allocation& allocation)
 {
-    KP_LOG_DEBUG("Kompute Tensor started destroy()");
+    KP_LOG_DEBUG("Kompute Tensor sub-allocating and binding pool memory");
 
-    // Setting raw data to null regardless whether device is available to
-    // invalidate Tensor
-    this->mRawData = nullptr;
-    this->mSize = 0;
-    this->mDataTypeMemorySize = 0;
+    vk::MemoryRequirements memoryRequirements =
+      this->mDevice->getBufferMemoryRequirements(*buffer);
 
-    if (!this->mDevice) {
-        KP_LOG_WARN(
-          "Kompute Tensor destructor reached with null Device pointer");
-        return;
-    }
+    allocation =
+      this->mMemoryPool->allocate(memoryRequirements, memoryPropertyFlags);
+    *memory = allocation.memory;
+
+    this->mDevice->bindBufferMemory(*buffer, *memory, allocation.offset);
+}
+
+void
+Tensor::freeMemoryDestroyGPUResources()
+{
+    KP_LOG_DEBUG("Kompute Tensor freeing memory and destroying buffers");
 
     // Unmap the current memory data
     this->unmapRawData();
+    this->mImportedHostData = nullptr;
 
     if (this->mFreePrimaryBuffer) {
         if (!this->mPrimaryBuffer) {
@@ -579,10 +1450,53 @@ Tensor::destroy()
         }
     }
 
+    if (this->mFreePrimaryAllocation) {
+        KP_LOG_DEBUG("Kompose Tensor releasing primary pool allocation");
+        this->mMemoryPool->free(this->mPrimaryAllocation);
+        this->mPrimaryAllocation = MemoryPool::Allocation();
+        this->mPrimaryMemory = nullptr;
+        this->mFreePrimaryAllocation = false;
+    }
+
+    if (this->mFreeStagingAllocation) {
+        KP_LOG_DEBUG("Kompose Tensor releasing staging pool allocation");
+        this->mMemoryPool->free(this->mStagingAllocation);
+        this->mStagingAllocation = MemoryPool::Allocation();
+        this->mStagingMemory = nullptr;
+        this->mFreeStagingAllocation = false;
+    }
+
+    this->mHostData.clear();
+    this->mHostData.shrink_to_fit();
+    this->mCapacityMemorySize = 0;
+}
+
+void
+Tensor::destroy()
+{
+    KP_LOG_DEBUG("Kompute Tensor started destroy()");
+
+    // Setting raw data to null regardless whether device is available to
+    // invalidate Tensor
+    this->mRawData = nullptr;
+    this->mSize = 0;
+    this->mDataTypeMemorySize = 0;
+    this->mDirtyRanges.clear();
+
+    if (!this->mDevice) {
+        KP_LOG_WARN(
+          "Kompute Tensor destructor reached with null Device pointer");
+        return;
+    }
+
+    this->freeMemoryDestroyGPUResources();
+
     if (this->mDevice) {
         this->mDevice = nullptr;
     }
 
+    this->refreshViews();
+
     KP_LOG_DEBUG("Kompute Tensor successful destroy()");
 }
 
@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+
+#include "kompute/WorkerPool.hpp"
+
+namespace kp {
+
+WorkerPool::WorkerPool(uint32_t threadCount)
+{
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    KP_LOG_DEBUG("Kompute WorkerPool constructor with {} threads",
+                 threadCount);
+
+    for (uint32_t i = 0; i < threadCount; i++) {
+        this->mThreads.emplace_back(&WorkerPool::run, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    KP_LOG_DEBUG("Kompute WorkerPool destructor started");
+
+    {
+        std::lock_guard<std::mutex> lock(this->mMutex);
+        this->mStopping = true;
+    }
+    this->mCondition.notify_all();
+
+    for (std::thread& thread : this->mThreads) {
+        thread.join();
+    }
+}
+
+std::shared_future<void>
+WorkerPool::submit(const std::function<void()>& task)
+{
+    std::packaged_task<void()> packagedTask(task);
+    std::shared_future<void> future = packagedTask.get_future().share();
+
+    {
+        std::lock_guard<std::mutex> lock(this->mMutex);
+        if (this->mStopping) {
+            throw std::runtime_error(
+              "Kompute WorkerPool task submitted after destruction started");
+        }
+        this->mTasks.push_back(std::move(packagedTask));
+    }
+    this->mCondition.notify_one();
+
+    return future;
+}
+
+uint32_t
+WorkerPool::threadCount() const
+{
+    return this->mThreads.size();
+}
+
+void
+WorkerPool::run()
+{
+    while (true) {
+        std::packaged_task<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(this->mMutex);
+            this->mCondition.wait(lock, [this]() {
+                return this->mStopping || this->mTasks.size();
+            });
+
+            // Queued tasks are still run so their futures become ready
+            if (this->mTasks.empty()) {
+                return;
+            }
+            task = std::move(this->mTasks.front());
+            this->mTasks.pop_front();
+        }
+
+        // Exceptions are stored in the future of the task
+        task();
+    }
+}
+
+}
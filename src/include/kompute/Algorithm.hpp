@@ -1,10 +1,16 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
+#include <map>
+#include <mutex>
+
 #include "kompute/Core.hpp"
 
 #include "fmt/format.h"
+#include "kompute/DescriptorAllocator.hpp"
+#include "kompute/PipelineCache.hpp"
 #include "kompute/Tensor.hpp"
+#include "kompute/WorkerPool.hpp"
 #include "logger/Logger.hpp"
 
 namespace kp {
@@ -33,18 +39,31 @@ class Algorithm
      * when initializing the pipeline, which set the size of the push constants
      * - these can be modified but all new values must have the same data type
      * and length as otherwise it will result in errors.
+     *  @param pipelineCache (optional) The pipeline cache to create the
+     * pipelines from, which is shared with other algorithms, and which shares
+     * the pipeline of the algorithm with the algorithms created from the same
+     * SPIR-V and constants, otherwise the algorithm creates a pipeline cache
+     * of its own.
+     *  @param descriptorAllocator (optional) The allocator to allocate the
+     * descriptor set from, which is recycled when the algorithm is
+     * destroyed, otherwise the algorithm creates a descriptor pool of its own.
      */
     template<typename S = float, typename P = float>
-    Algorithm(std::shared_ptr<vk::Device> device,
-              const std::vector<std::shared_ptr<Tensor>>& tensors = {},
-              const std::vector<uint32_t>& spirv = {},
-              const Workgroup& workgroup = {},
-              const std::vector<S>& specializationConstants = {},
-              const std::vector<P>& pushConstants = {})
+    Algorithm(
+      std::shared_ptr<vk::Device> device,
+      const std::vector<std::shared_ptr<Tensor>>& tensors = {},
+      const std::vector<uint32_t>& spirv = {},
+      const Workgroup& workgroup = {},
+      const std::vector<S>& specializationConstants = {},
+      const std::vector<P>& pushConstants = {},
+      std::shared_ptr<PipelineCache> pipelineCache = nullptr,
+      std::shared_ptr<DescriptorAllocator> descriptorAllocator = nullptr)
     {
         KP_LOG_DEBUG("Kompute Algorithm Constructor with device");
 
         this->mDevice = device;
+        this->mSharedPipelineCache = pipelineCache;
+        this->mDescriptorAllocator = descriptorAllocator;
 
         if (tensors.size() && spirv.size()) {
             KP_LOG_INFO(
@@ -89,52 +108,76 @@ class Algorithm
     {
         KP_LOG_DEBUG("Kompute Algorithm rebuild started");
 
-        this->mTensors = tensors;
-        this->mSpirv = spirv;
-
-        if (specializationConstants.size()) {
-            if (this->mSpecializationConstantsData) {
-                free(this->mSpecializationConstantsData);
-            }
-            uint32_t memorySize =
-              sizeof(decltype(specializationConstants.back()));
-            uint32_t size = specializationConstants.size();
-            uint32_t totalSize = size * memorySize;
-            this->mSpecializationConstantsData = malloc(totalSize);
-            memcpy(this->mSpecializationConstantsData,
-                   specializationConstants.data(),
-                   totalSize);
-            this->mSpecializationConstantsDataTypeMemorySize = memorySize;
-            this->mSpecializationConstantsSize = size;
-        }
+        this->setParameters(tensors,
+                            spirv,
+                            workgroup,
+                            specializationConstants,
+                            pushConstants);
 
-        if (pushConstants.size()) {
-            if (this->mPushConstantsData) {
-                free(this->mPushConstantsData);
-            }
-            uint32_t memorySize = sizeof(decltype(pushConstants.back()));
-            uint32_t size = pushConstants.size();
-            uint32_t totalSize = size * memorySize;
-            this->mPushConstantsData = malloc(totalSize);
-            memcpy(this->mPushConstantsData, pushConstants.data(), totalSize);
-            this->mPushConstantsDataTypeMemorySize = memorySize;
-            this->mPushConstantsSize = size;
-        }
+        this->createPipelineResources();
+        this->createParameters();
+    }
 
-        this->setWorkgroup(
-          workgroup, this->mTensors.size() ? this->mTensors[0]->size() : 1);
+    /**
+     * Asynchronous version of rebuild, which creates the underlying
+     * resources, including the compilation of the pipeline, on a thread of
+     * the worker pool provided so several algorithms can be built in
+     * parallel. Recording, rebuilding or destroying the algorithm first waits
+     * for the build to finish, which can also be awaited through wait.
+     *
+     *  @param workerPool The worker pool to create the resources on
+     *  @param tensors The tensors to use to create the descriptor resources
+     *  @param spirv The spirv code to use to create the algorithm
+     *  @param workgroup (optional) The kp::Workgroup to use for the dispatch
+     * which defaults to kp::Workgroup(tensor[0].size(), 1, 1) if not set.
+     *  @param specializationConstants (optional) The specialization constants
+     * of the algorithm
+     *  @param pushConstants (optional) The initial push constants of the
+     * algorithm, which set the size of the push constants
+     */
+    template<typename S = float, typename P = float>
+    void rebuildAsync(std::shared_ptr<WorkerPool> workerPool,
+                      const std::vector<std::shared_ptr<Tensor>>& tensors,
+                      const std::vector<uint32_t>& spirv,
+                      const Workgroup& workgroup = {},
+                      const std::vector<S>& specializationConstants = {},
+                      const std::vector<P>& pushConstants = {})
+    {
+        KP_LOG_DEBUG("Kompute Algorithm asynchronous rebuild started");
 
-        // Descriptor pool is created first so if available then destroy all
-        // before rebuild
-        if (this->isInit()) {
-            this->destroy();
+        if (!workerPool) {
+            throw std::runtime_error(
+              "Kompute Algorithm rebuildAsync called with null worker pool");
         }
 
-        this->createParameters();
-        this->createShaderModule();
-        this->createPipeline();
+        this->setParameters(tensors,
+                            spirv,
+                            workgroup,
+                            specializationConstants,
+                            pushConstants);
+
+        // The algorithm waits for the build before it is destroyed, so it
+        // outlives the task
+        this->mBuild = workerPool->submit([this]() {
+            this->createPipelineResources();
+            this->createParameters();
+        });
     }
 
+    /**
+     * Whether the resources of the algorithm have been created, which is
+     * only false while an asynchronous rebuild is running.
+     *
+     * @return Boolean stating whether the algorithm is built
+     */
+    bool isBuilt();
+
+    /**
+     * Waits for the asynchronous rebuild of the algorithm to finish, if any.
+     * An exception is thrown if the resources could not be created.
+     */
+    void wait();
+
     /**
      * Destructor for Algorithm which is responsible for freeing and desroying
      * respective pipelines and owned parameter groups.
@@ -151,7 +194,12 @@ class Algorithm
 
     /**
      * Records command that binds the "core" algorithm components which consist
-     * of binding the pipeline and binding the descriptorsets.
+     * of binding the pipeline and binding the descriptorsets. The bindings of
+     * tensors rebuilt since the descriptor set was last written are written
+     * again first. When a submission that may use the current descriptor set
+     * is running, the bindings are written into a new set of the descriptor
+     * allocator instead, and algorithms without a descriptor allocator throw
+     * as their only set would be updated in place.
      *
      * @param commandBuffer Command buffer to record the algorithm resources to
      */
@@ -167,6 +215,46 @@ class Algorithm
      */
     void recordBindPush(const vk::CommandBuffer& commandBuffer);
 
+    /**
+     * Whether any of the tensors of the algorithm has been rebuilt since the
+     * descriptor set was written, in which case it is written again the next
+     * time the algorithm is recorded.
+     *
+     * @return Boolean stating whether the descriptor set is outdated
+     */
+    bool requiresDescriptorUpdate();
+
+    /**
+     * Number of times the descriptor set of the algorithm has been written,
+     * which changes whenever the resources that recordBindCore binds change,
+     * so commands recorded with a previous version have to be recorded again.
+     *
+     * @return Version of the descriptor set
+     */
+    uint64_t descriptorSetVersion();
+
+    /**
+     * Marks the start of a submission that executes commands recorded with
+     * the descriptor set version provided, which keeps the descriptor sets
+     * replaced while it is running from being reused until it completes.
+     * This is called by the operations that record the algorithm from their
+     * preEval.
+     *
+     * @param descriptorSetVersion The version the commands were recorded with
+     */
+    void beginSubmission(uint64_t descriptorSetVersion);
+
+    /**
+     * Marks the completion of a submission started through beginSubmission,
+     * releasing the replaced descriptor sets that no running submission can
+     * use anymore. This is called by the operations that record the algorithm
+     * from their postEval. Submissions that are never awaited, such as after
+     * a timeout, are considered as running until the algorithm is destroyed.
+     *
+     * @param descriptorSetVersion The version the commands were recorded with
+     */
+    void endSubmission(uint64_t descriptorSetVersion);
+
     /**
      * function that checks all the gpu resource components to verify if these
      * have been created and returns true if all are valid.
@@ -182,8 +270,10 @@ class Algorithm
      * It must have a value greater than 1 on the x value (index 1) otherwise it
      * will be initialized on the size of the first tensor (ie.
      * this->mTensor[0]->size())
+     * @param minSize The x value used when the workgroup is not provided,
+     * which has to fit in 32 bits
      */
-    void setWorkgroup(const Workgroup& workgroup, uint32_t minSize = 1);
+    void setWorkgroup(const Workgroup& workgroup, uint64_t minSize = 1);
     /**
      * Sets the push constants to the new value provided to use in the next
      * bindPush()
@@ -198,7 +288,7 @@ class Algorithm
         uint32_t memorySize = sizeof(decltype(pushConstants.back()));
         uint32_t size = pushConstants.size();
 
-        this->setPushConstants(pushConstants.data(), size, memorySize);
+        this->setPushConstants((void*)pushConstants.data(), size, memorySize);
     }
 
     /**
@@ -273,12 +363,39 @@ class Algorithm
      */
     const std::vector<std::shared_ptr<Tensor>>& getTensors();
 
+    /**
+     * Sets the tensors bound to the algorithm without recreating its
+     * pipeline. When the tensors need the same number of descriptors for
+     * each binding as the current tensors, only the descriptor set is
+     * written again, or a new set of the descriptor allocator while
+     * submissions that use the current set are running, otherwise the
+     * descriptor set layout and the pipeline are created again as for
+     * rebuild, which throws while such submissions are running. The
+     * workgroup is kept, and sequences that record the algorithm are
+     * recorded again when next evaluated.
+     *
+     * @param tensors The tensors to bind to the algorithm
+     */
+    void setTensors(const std::vector<std::shared_ptr<Tensor>>& tensors);
+
     void destroy();
 
   private:
     // -------------- NEVER OWNED RESOURCES
     std::shared_ptr<vk::Device> mDevice;
+    std::shared_ptr<PipelineCache> mSharedPipelineCache;
+    std::shared_ptr<DescriptorAllocator> mDescriptorAllocator;
     std::vector<std::shared_ptr<Tensor>> mTensors;
+    std::vector<uint64_t> mTensorGenerations;
+    std::vector<uint32_t> mTensorDescriptorCounts;
+    // Kept across rebuilds so recorded commands can be compared against it
+    uint64_t mDescriptorSetVersion = 0;
+    // Running submissions by the descriptor set version these were recorded
+    // with, and the sets replaced meanwhile with the last version they were
+    // current for
+    std::map<uint64_t, uint32_t> mPendingSubmissions;
+    std::vector<std::pair<uint64_t, vk::DescriptorSet>> mRetiredDescriptorSets;
+    std::mutex mSubmissionMutex;
 
     // -------------- OPTIONALLY OWNED RESOURCES
     std::shared_ptr<vk::DescriptorSetLayout> mDescriptorSetLayout;
@@ -295,6 +412,8 @@ class Algorithm
     bool mFreePipelineCache = false;
     std::shared_ptr<vk::Pipeline> mPipeline;
     bool mFreePipeline = false;
+    // Holds the pipeline resources above when these are shared
+    std::shared_ptr<PipelineCache::SharedPipeline> mSharedPipeline;
 
     // -------------- ALWAYS OWNED RESOURCES
     std::vector<uint32_t> mSpirv;
@@ -305,13 +424,77 @@ class Algorithm
     uint32_t mPushConstantsDataTypeMemorySize = 0;
     uint32_t mPushConstantsSize = 0;
     Workgroup mWorkgroup;
+    // Ready once the resources of an asynchronous rebuild are created
+    std::shared_future<void> mBuild;
+
+    // Releases the replaced descriptor sets that no running submission can
+    // use, which requires the submission mutex to be held
+    void releaseRetiredDescriptorSets();
+
+    // Sets the parameters of the algorithm before its resources are created
+    template<typename S, typename P>
+    void setParameters(const std::vector<std::shared_ptr<Tensor>>& tensors,
+                       const std::vector<uint32_t>& spirv,
+                       const Workgroup& workgroup,
+                       const std::vector<S>& specializationConstants,
+                       const std::vector<P>& pushConstants)
+    {
+        // Descriptor pool is created first so if available then destroy all
+        // before rebuild, which also waits for a running build
+        if (this->isInit()) {
+            this->destroy();
+        }
+        this->mBuild = std::shared_future<void>();
+
+        this->mTensors = tensors;
+        this->mSpirv = spirv;
+
+        if (specializationConstants.size()) {
+            if (this->mSpecializationConstantsData) {
+                free(this->mSpecializationConstantsData);
+            }
+            uint32_t memorySize =
+              sizeof(decltype(specializationConstants.back()));
+            uint32_t size = specializationConstants.size();
+            uint32_t totalSize = size * memorySize;
+            this->mSpecializationConstantsData = malloc(totalSize);
+            memcpy(this->mSpecializationConstantsData,
+                   specializationConstants.data(),
+                   totalSize);
+            this->mSpecializationConstantsDataTypeMemorySize = memorySize;
+            this->mSpecializationConstantsSize = size;
+        }
+
+        if (pushConstants.size()) {
+            if (this->mPushConstantsData) {
+                free(this->mPushConstantsData);
+            }
+            uint32_t memorySize = sizeof(decltype(pushConstants.back()));
+            uint32_t size = pushConstants.size();
+            uint32_t totalSize = size * memorySize;
+            this->mPushConstantsData = malloc(totalSize);
+            memcpy(this->mPushConstantsData, pushConstants.data(), totalSize);
+            this->mPushConstantsDataTypeMemorySize = memorySize;
+            this->mPushConstantsSize = size;
+        }
+
+        this->setWorkgroup(
+          workgroup, this->mTensors.size() ? this->mTensors[0]->size() : 1);
+    }
+
+    // Waits for a running build without throwing its exception
+    void finishBuild();
 
     // Create util functions
+    void createPipelineResources();
     void createShaderModule();
     void createPipeline();
+    std::string pipelineKey();
 
     // Parameters
+    void createDescriptorSetLayout();
     void createParameters();
+    void updateDescriptorSets();
 };
 
 } // End namespace kp
@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/Core.hpp"
+#include "logger/Logger.hpp"
+
+namespace kp {
+
+/**
+ * Collects memory and buffer memory barriers so these are recorded with a
+ * single pipeline barrier for each pair of source and destination stage
+ * masks, instead of one pipeline barrier for each buffer.
+ *
+ * Barriers are recorded in the order in which their stage mask pairs were
+ * first added, and the builder is empty again once recorded.
+ */
+class BarrierBuilder
+{
+  public:
+    /**
+     * Adds a global memory barrier, which applies to all the memory accessed
+     * by the stages provided.
+     *
+     * @param srcStageMask Pipeline stage flags for source stage mask
+     * @param dstStageMask Pipeline stage flags for destination stage mask
+     * @param memoryBarrier The memory barrier with the access masks
+     * @return Reference to the builder
+     */
+    BarrierBuilder& addMemoryBarrier(vk::PipelineStageFlags srcStageMask,
+                                     vk::PipelineStageFlags dstStageMask,
+                                     const vk::MemoryBarrier& memoryBarrier);
+
+    /**
+     * Adds a buffer memory barrier.
+     *
+     * @param srcStageMask Pipeline stage flags for source stage mask
+     * @param dstStageMask Pipeline stage flags for destination stage mask
+     * @param bufferMemoryBarrier The buffer memory barrier
+     * @return Reference to the builder
+     */
+    BarrierBuilder& addBufferMemoryBarrier(
+      vk::PipelineStageFlags srcStageMask,
+      vk::PipelineStageFlags dstStageMask,
+      const vk::BufferMemoryBarrier& bufferMemoryBarrier);
+
+    /**
+     * Records the barriers added into the command buffer, with one pipeline
+     * barrier for each pair of stage masks, and clears the builder.
+     *
+     * @param commandBuffer Vulkan Command Buffer to record the barriers into
+     */
+    void record(const vk::CommandBuffer& commandBuffer);
+
+    /**
+     * Removes all the barriers added without recording these.
+     */
+    void clear();
+
+    /**
+     * Whether no barriers have been added since the builder was last
+     * recorded or cleared.
+     *
+     * @return Boolean stating whether the builder is empty
+     */
+    bool empty();
+
+    /**
+     * Number of pipeline barriers that recording the builder would record.
+     *
+     * @return Number of pipeline barriers
+     */
+    uint32_t pipelineBarrierCount();
+
+    /**
+     * Number of buffer memory barriers added to the builder.
+     *
+     * @return Number of buffer memory barriers
+     */
+    uint32_t bufferMemoryBarrierCount();
+
+  private:
+    // Barriers that share the same source and destination stage masks
+    struct StageBarriers
+    {
+        vk::PipelineStageFlags srcStageMask;
+        vk::PipelineStageFlags dstStageMask;
+        std::vector<vk::MemoryBarrier> memoryBarriers;
+        std::vector<vk::BufferMemoryBarrier> bufferMemoryBarriers;
+    };
+
+    std::vector<StageBarriers> mStageBarriers;
+
+    StageBarriers& stageBarriers(vk::PipelineStageFlags srcStageMask,
+                                 vk::PipelineStageFlags dstStageMask);
+};
+
+} // End namespace kp
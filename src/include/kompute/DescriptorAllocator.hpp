@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <map>
+#include <mutex>
+
+#include "kompute/Core.hpp"
+#include "logger/Logger.hpp"
+
+#define KP_DEFAULT_DESCRIPTOR_POOL_SETS 256
+#define KP_DEFAULT_DESCRIPTOR_POOL_DESCRIPTORS_PER_SET 8
+
+namespace kp {
+
+/**
+ * Allocator of the descriptor sets of algorithms, which allocates the sets
+ * from descriptor pools that hold many sets instead of each algorithm
+ * creating a descriptor pool of its own. A new pool is created when the
+ * current pools are exhausted.
+ *
+ * The descriptor set layouts are cached by the number of descriptors of each
+ * of their bindings, and the sets released by destroyed algorithms are
+ * recycled for the next algorithms with the same layout instead of being
+ * freed, so creating and destroying algorithms does not create or free any
+ * descriptor pool or set once the pools are warm.
+ *
+ * The allocator can be used by several threads at the same time.
+ */
+class DescriptorAllocator
+{
+  public:
+    /**
+     * Constructor for the allocator, which creates pools lazily as sets are
+     * allocated.
+     *
+     * @param device The device to create the pools and layouts from
+     * @param setsPerPool The maximum number of sets of each pool
+     * @param descriptorsPerSet The average number of storage buffer
+     * descriptors of each set that the pools are sized for
+     */
+    DescriptorAllocator(
+      std::shared_ptr<vk::Device> device,
+      uint32_t setsPerPool = KP_DEFAULT_DESCRIPTOR_POOL_SETS,
+      uint32_t descriptorsPerSet =
+        KP_DEFAULT_DESCRIPTOR_POOL_DESCRIPTORS_PER_SET);
+
+    /**
+     * Destructor which destroys the pools and layouts of the allocator.
+     */
+    ~DescriptorAllocator();
+
+    /**
+     * Returns the descriptor set layout with a storage buffer binding for
+     * each descriptor count provided, which is created the first time it is
+     * requested and destroyed with the allocator.
+     *
+     * @param descriptorCounts The number of descriptors of each binding
+     * @return Shared pointer to the cached layout
+     */
+    std::shared_ptr<vk::DescriptorSetLayout> layout(
+      const std::vector<uint32_t>& descriptorCounts);
+
+    /**
+     * Allocates a descriptor set with the layout of the descriptor counts
+     * provided, which reuses a released set with the same layout if any.
+     *
+     * @param descriptorCounts The number of descriptors of each binding
+     * @return Descriptor set that is held until released
+     */
+    vk::DescriptorSet allocate(const std::vector<uint32_t>& descriptorCounts);
+
+    /**
+     * Releases a descriptor set so it is reused by the next allocation with
+     * the same layout, which must not happen while a submission that uses
+     * the set is running.
+     *
+     * @param descriptorCounts The descriptor counts the set was allocated for
+     * @param descriptorSet The descriptor set allocated from this allocator
+     */
+    void release(const std::vector<uint32_t>& descriptorCounts,
+                 vk::DescriptorSet descriptorSet);
+
+    /**
+     * Destroys the pools and layouts of the allocator. Descriptor sets that
+     * are still held become invalid.
+     */
+    void destroy();
+
+    /**
+     * Number of descriptor pools created by the allocator.
+     *
+     * @return Number of pools
+     */
+    uint32_t poolCount();
+
+    /**
+     * Number of released descriptor sets that are ready to be reused.
+     *
+     * @return Number of available sets
+     */
+    uint32_t availableSetCount();
+
+  private:
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<vk::Device> mDevice;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    uint32_t mSetsPerPool;
+    uint32_t mDescriptorsPerSet;
+    std::vector<vk::DescriptorPool> mPools;
+    // Layouts and released sets indexed by the descriptor counts of the
+    // bindings
+    std::map<std::vector<uint32_t>, std::shared_ptr<vk::DescriptorSetLayout>>
+      mLayouts;
+    std::map<std::vector<uint32_t>, std::vector<vk::DescriptorSet>>
+      mAvailableSets;
+    std::mutex mMutex;
+
+    std::shared_ptr<vk::DescriptorSetLayout> findLayout(
+      const std::vector<uint32_t>& descriptorCounts);
+    void createPool(uint32_t descriptorCount);
+};
+
+} // End namespace kp
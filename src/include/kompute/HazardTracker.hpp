@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/BarrierBuilder.hpp"
+#include "kompute/Core.hpp"
+#include "kompute/Tensor.hpp"
+#include "logger/Logger.hpp"
+
+namespace kp {
+
+/**
+ * Access of an operation to the primary buffer of a tensor, given by the
+ * pipeline stages that perform it and the types of access, where any write
+ * access flag makes it a write.
+ */
+struct TensorAccess
+{
+    std::shared_ptr<Tensor> tensor;
+    vk::PipelineStageFlags stageMask;
+    vk::AccessFlags accessMask;
+};
+
+/**
+ * Tracker of the last accesses to the primary buffers of the tensors while
+ * the operations of a sequence are recorded, which is used to record only the
+ * barriers that the accesses of each operation require.
+ *
+ * Barriers are required for read after write, write after write and write
+ * after read hazards. A write is only made visible once to each stage and
+ * access type that reads it, and all the barriers required by the accesses of
+ * an operation are merged into a single pipeline barrier. Tensors that share a
+ * buffer, such as tensor views, are tracked by the region of the buffer these
+ * cover so accesses to overlapping regions are synchronised.
+ *
+ * The first access to a tensor in a recording is synchronised with the device
+ * writes of the commands submitted to the queue before it, as the tracker
+ * does not know what these accessed.
+ */
+class HazardTracker
+{
+  public:
+    /**
+     * Barriers required before a set of accesses, merged into the stage masks
+     * and buffer memory barriers of a single pipeline barrier.
+     */
+    struct Barriers
+    {
+        vk::PipelineStageFlags srcStageMask;
+        vk::PipelineStageFlags dstStageMask;
+        std::vector<vk::BufferMemoryBarrier> bufferMemoryBarriers;
+    };
+
+    /**
+     * Computes the barriers required before the accesses provided and updates
+     * the tracked state as if the accesses were performed.
+     *
+     * @param accesses The accesses performed by an operation
+     * @return The barriers required, which are empty if none are required
+     */
+    Barriers track(const std::vector<TensorAccess>& accesses);
+
+    /**
+     * Records the barriers required before the accesses provided into the
+     * command buffer as a single pipeline barrier, and updates the tracked
+     * state as if the accesses were performed.
+     *
+     * @param commandBuffer Vulkan Command Buffer to record the barrier into
+     * @param accesses The accesses performed by an operation
+     */
+    void recordBarriers(const vk::CommandBuffer& commandBuffer,
+                        const std::vector<TensorAccess>& accesses);
+
+    /**
+     * Records the barriers that make the device writes to host and unified
+     * memory tensors visible to the host, which is required once all the
+     * operations have been recorded as the host reads these tensors directly
+     * from the primary buffer.
+     *
+     * @param commandBuffer Vulkan Command Buffer to record the barrier into
+     */
+    void recordHostBarriers(const vk::CommandBuffer& commandBuffer);
+
+    /**
+     * Forgets all the accesses tracked so far, which is used when a new
+     * recording begins.
+     */
+    void clear();
+
+    /**
+     * Assumes that any device write may have been performed on the tensors
+     * tracked so far, so the following accesses are synchronised with it.
+     * Used after an operation that does not declare its accesses.
+     */
+    void invalidate();
+
+    /**
+     * Number of pipeline barriers recorded by the tracker since it was
+     * constructed.
+     *
+     * @return Number of pipeline barriers
+     */
+    uint32_t pipelineBarrierCount();
+
+  private:
+    // Last accesses to a region of a buffer
+    struct Region
+    {
+        std::shared_ptr<Tensor> tensor;
+        vk::Buffer buffer;
+        vk::DeviceSize offset;
+        vk::DeviceSize size;
+        bool written; // Whether the last write is part of the recording
+        vk::PipelineStageFlags writeStageMask;
+        vk::AccessFlags writeAccessMask;
+        vk::PipelineStageFlags readStageMask; // Reads since the last write
+        vk::PipelineStageFlags visibleStageMask; // Where the write is visible
+        vk::AccessFlags visibleAccessMask;
+    };
+
+    std::vector<Region> mRegions;
+    uint32_t mPipelineBarrierCount = 0;
+
+    void resetRegion(Region& region);
+
+    void recordPipelineBarrier(const vk::CommandBuffer& commandBuffer,
+                               const Barriers& barriers);
+};
+
+} // End namespace kp
@@ -1,16 +1,29 @@
 #pragma once
 
 #include "Algorithm.hpp"
+#include "BarrierBuilder.hpp"
 #include "Core.hpp"
+#include "DescriptorAllocator.hpp"
+#include "HazardTracker.hpp"
 #include "Manager.hpp"
+#include "MemoryPool.hpp"
+#include "ParameterBlock.hpp"
+#include "PipelineCache.hpp"
 #include "Sequence.hpp"
+#include "StagingRing.hpp"
+#include "SubmissionBatch.hpp"
+#include "SyncPool.hpp"
 #include "Tensor.hpp"
+#include "WorkerPool.hpp"
 
 #include "operations/OpAlgoDispatch.hpp"
 #include "operations/OpBase.hpp"
+#include "operations/OpBlock.hpp"
 #include "operations/OpMemoryBarrier.hpp"
 #include "operations/OpMult.hpp"
+#include "operations/OpRepeat.hpp"
 #include "operations/OpTensorCopy.hpp"
+#include "operations/OpTensorFill.hpp"
 #include "operations/OpTensorSyncDevice.hpp"
 #include "operations/OpTensorSyncLocal.hpp"
 
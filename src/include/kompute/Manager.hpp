@@ -1,12 +1,25 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
+#include <functional>
+#include <map>
+#include <mutex>
 #include <set>
+#include <thread>
 #include <unordered_map>
 
 #include "kompute/Core.hpp"
 
+#include "kompute/DescriptorAllocator.hpp"
+#include "kompute/MemoryPool.hpp"
+#include "kompute/ParameterBlock.hpp"
+#include "kompute/PipelineCache.hpp"
 #include "kompute/Sequence.hpp"
+#include "kompute/StagingRing.hpp"
+#include "kompute/SubmissionBatch.hpp"
+#include "kompute/SyncPool.hpp"
+#include "kompute/WorkerPool.hpp"
+#include "kompute/operations/OpBlock.hpp"
 #include "logger/Logger.hpp"
 
 #define KP_DEFAULT_SESSION "DEFAULT"
@@ -14,7 +27,12 @@
 namespace kp {
 
 /**
-    Base orchestrator which creates and manages device and child components
+    Base orchestrator which creates and manages device and child components.
+
+    The manager can be used by several threads at the same time to create
+    resources, and submissions of sequences to the same queue are serialised.
+    Each sequence, algorithm and tensor is still meant to be used by one
+    thread at a time.
 */
 class Manager
 {
@@ -70,6 +88,32 @@ class Manager
     std::shared_ptr<Sequence> sequence(uint32_t queueIndex = 0,
                                        uint32_t totalTimestamps = 0);
 
+    /**
+     * Create a managed block that records the operations provided once into
+     * a secondary command buffer, which sequences of the same queue family
+     * then execute when the block is recorded into them instead of recording
+     * the operations again.
+     *
+     * @param operations The operations to record into the block, in order
+     * @param queueIndex The queue of the sequences that execute the block
+     * @returns Shared pointer with initialised block
+     */
+    std::shared_ptr<OpBlock> block(
+      const std::vector<std::shared_ptr<OpBase>>& operations,
+      uint32_t queueIndex = 0);
+
+    /**
+     * Submits the recorded sequences together, with the sequences that use
+     * the same queue submitted in a single vkQueueSubmit. The batch returned
+     * is the completion handle for all the sequences.
+     *
+     * @param sequences The sequences to submit in order, where sequences that
+     * depend on other sequences of the batch have to come after these
+     * @returns Shared pointer with the submitted batch
+     */
+    std::shared_ptr<SubmissionBatch> submit(
+      const std::vector<std::shared_ptr<Sequence>>& sequences);
+
     /**
      * Create a managed tensor that will be destroyed by this manager
      * if it hasn't been destroyed by its reference count going to zero.
@@ -86,9 +130,16 @@ class Manager
         KP_LOG_DEBUG("Kompute Manager tensor creation triggered");
 
         std::shared_ptr<TensorT<T>> tensor{ new kp::TensorT<T>(
-          this->mPhysicalDevice, this->mDevice, data, tensorType) };
+          this->mPhysicalDevice,
+          this->mDevice,
+          data,
+          tensorType,
+          this->mMemoryPool,
+          this->mStagingRing,
+          this->mUnifiedMemory) };
 
         if (this->mManageResources) {
+            std::lock_guard<std::mutex> lock(this->mManagedResourcesMutex);
             this->mManagedTensors.push_back(tensor);
         }
 
@@ -104,7 +155,7 @@ class Manager
 
     std::shared_ptr<Tensor> tensor(
       void* data,
-      uint32_t elementTotalCount,
+      uint64_t elementTotalCount,
       uint32_t elementMemorySize,
       const Tensor::TensorDataTypes& dataType,
       Tensor::TensorTypes tensorType = Tensor::TensorTypes::eDevice)
@@ -115,9 +166,13 @@ class Manager
                                                        elementTotalCount,
                                                        elementMemorySize,
                                                        dataType,
-                                                       tensorType) };
+                                                       tensorType,
+                                                       this->mMemoryPool,
+                                                       this->mStagingRing,
+                                                       this->mUnifiedMemory) };
 
         if (this->mManageResources) {
+            std::lock_guard<std::mutex> lock(this->mManagedResourcesMutex);
             this->mManagedTensors.push_back(tensor);
         }
 
@@ -181,9 +236,67 @@ class Manager
           spirv,
           workgroup,
           specializationConstants,
-          pushConstants) };
+          pushConstants,
+          this->mPipelineCache,
+          this->mDescriptorAllocator) };
+
+        if (this->mManageResources) {
+            std::lock_guard<std::mutex> lock(this->mManagedResourcesMutex);
+            this->mManagedAlgorithms.push_back(algorithm);
+        }
+
+        return algorithm;
+    }
+
+    /**
+     * Create a managed algorithm whose resources are created, and pipeline
+     * compiled, asynchronously on the worker pool of the manager, so the
+     * algorithms of a model are built in parallel and off the calling
+     * thread. The algorithm is returned straight away, and recording it
+     * waits for its build to finish, which can also be awaited through
+     * Algorithm::wait.
+     *
+     * @param tensors The tensors to initialise the algorithm with
+     * @param spirv The SPIRV bytes for the algorithm to dispatch
+     * @param workgroup (optional) kp::Workgroup for algorithm to use, and
+     * defaults to (tensor[0].size(), 1, 1)
+     * @param specializationConstants (optional) templatable vector parameter to
+     * use for specialization constants, and defaults to an empty constant
+     * @param pushConstants (optional) templatable vector parameter to use for
+     * push constants, and defaults to an empty constant
+     * @returns Shared pointer with the algorithm being built
+     */
+    template<typename S = float, typename P = float>
+    std::shared_ptr<Algorithm> algorithmAsync(
+      const std::vector<std::shared_ptr<Tensor>>& tensors,
+      const std::vector<uint32_t>& spirv,
+      const Workgroup& workgroup = {},
+      const std::vector<S>& specializationConstants = {},
+      const std::vector<P>& pushConstants = {})
+    {
+        KP_LOG_DEBUG("Kompute Manager asynchronous algorithm creation "
+                     "triggered");
+
+        std::shared_ptr<Algorithm> algorithm{
+            new kp::Algorithm(this->mDevice,
+                              {},
+                              {},
+                              {},
+                              {},
+                              {},
+                              this->mPipelineCache,
+                              this->mDescriptorAllocator)
+        };
+
+        algorithm->rebuildAsync(this->getWorkerPool(),
+                                tensors,
+                                spirv,
+                                workgroup,
+                                specializationConstants,
+                                pushConstants);
 
         if (this->mManageResources) {
+            std::lock_guard<std::mutex> lock(this->mManagedResourcesMutex);
             this->mManagedAlgorithms.push_back(algorithm);
         }
 
@@ -223,6 +336,292 @@ class Manager
      **/
     std::shared_ptr<vk::Instance> getVkInstance() const;
 
+    /**
+     * Create a managed tensor that will be destroyed by this manager, without
+     * initialising its memory, which avoids building a throwaway host vector
+     * and copying it for tensors that are written to before being read, such
+     * as output tensors. The device memory can be cleared through the
+     * OpTensorFill operation.
+     *
+     * @param elementTotalCount The number of elements of the tensor
+     * @param tensorType The type of tensor to initialize
+     * @returns Shared pointer with initialised tensor
+     */
+    template<typename T>
+    std::shared_ptr<TensorT<T>> emptyTensorT(
+      uint64_t elementTotalCount,
+      Tensor::TensorTypes tensorType = Tensor::TensorTypes::eDevice)
+    {
+        KP_LOG_DEBUG("Kompute Manager empty tensor creation triggered");
+
+        std::shared_ptr<TensorT<T>> tensor{ new kp::TensorT<T>(
+          this->mPhysicalDevice,
+          this->mDevice,
+          elementTotalCount,
+          tensorType,
+          this->mMemoryPool,
+          this->mStagingRing,
+          this->mUnifiedMemory) };
+
+        if (this->mManageResources) {
+            std::lock_guard<std::mutex> lock(this->mManagedResourcesMutex);
+            this->mManagedTensors.push_back(tensor);
+        }
+
+        return tensor;
+    }
+
+    std::shared_ptr<TensorT<float>> emptyTensor(
+      uint64_t elementTotalCount,
+      Tensor::TensorTypes tensorType = Tensor::TensorTypes::eDevice)
+    {
+        return this->emptyTensorT<float>(elementTotalCount, tensorType);
+    }
+
+    std::shared_ptr<Tensor> emptyTensor(
+      uint64_t elementTotalCount,
+      uint32_t elementMemorySize,
+      const Tensor::TensorDataTypes& dataType,
+      Tensor::TensorTypes tensorType = Tensor::TensorTypes::eDevice)
+    {
+        return this->tensor(
+          nullptr, elementTotalCount, elementMemorySize, dataType, tensorType);
+    }
+
+    /**
+     * Create a managed tensor whose data is written by the generator provided
+     * straight into the host memory of the tensor, instead of being copied
+     * from a host vector.
+     *
+     * @param elementTotalCount The number of elements of the tensor
+     * @param generator Function called with the host data of the tensor and
+     * its number of elements, which has to write all the elements
+     * @param tensorType The type of tensor to initialize
+     * @returns Shared pointer with initialised tensor
+     */
+    template<typename T>
+    std::shared_ptr<TensorT<T>> tensorT(
+      uint64_t elementTotalCount,
+      const std::function<void(T*, uint64_t)>& generator,
+      Tensor::TensorTypes tensorType = Tensor::TensorTypes::eDevice)
+    {
+        std::shared_ptr<TensorT<T>> tensor =
+          this->emptyTensorT<T>(elementTotalCount, tensorType);
+
+        generator(tensor->data(), elementTotalCount);
+        tensor->markDirty();
+
+        return tensor;
+    }
+
+    /**
+     * Create a managed tensor that imports the host memory provided instead
+     * of copying it, which avoids a full copy of large inputs. The memory is
+     * imported through the VK_EXT_external_memory_host extension, which is
+     * enabled by the manager when the device supports it, as the memory of
+     * host tensors or as the staging memory of device tensors. The pointer
+     * and the total size have to be aligned to the import granularity of the
+     * device, which is usually the page size. If the memory cannot be
+     * imported the data is copied as it is for the other tensor functions.
+     * Otherwise the memory has to outlive the tensor, and the host data of
+     * the tensor is the memory provided.
+     *
+     * @param data The host memory to import into the tensor
+     * @param elementTotalCount The number of elements in the memory
+     * @param elementMemorySize The size in bytes of each element
+     * @param dataType The data type of the elements
+     * @param tensorType The type of tensor to initialize
+     * @returns Shared pointer with initialised tensor
+     */
+    std::shared_ptr<Tensor> importTensor(
+      void* data,
+      uint64_t elementTotalCount,
+      uint32_t elementMemorySize,
+      const Tensor::TensorDataTypes& dataType,
+      Tensor::TensorTypes tensorType = Tensor::TensorTypes::eDevice)
+    {
+        KP_LOG_DEBUG("Kompute Manager tensor import triggered");
+
+        std::shared_ptr<Tensor> tensor{ new kp::Tensor(
+          this->mPhysicalDevice,
+          this->mDevice,
+          data,
+          elementTotalCount,
+          elementMemorySize,
+          dataType,
+          tensorType,
+          this->mMemoryPool,
+          this->mStagingRing,
+          this->mUnifiedMemory,
+          this->mExternalMemoryHostEnabled) };
+
+        if (this->mManageResources) {
+            std::lock_guard<std::mutex> lock(this->mManagedResourcesMutex);
+            this->mManagedTensors.push_back(tensor);
+        }
+
+        return tensor;
+    }
+
+    /**
+     * Create a managed parameter block, which holds a value of the type
+     * provided in a persistently mapped host buffer that algorithms bind as
+     * any other tensor. The value can be updated with ParameterBlock::set
+     * between evaluations of a sequence without recording it again, which is
+     * not possible with push constants.
+     *
+     * @param value The initial value of the parameters
+     * @returns Shared pointer with initialised parameter block
+     */
+    template<typename T>
+    std::shared_ptr<ParameterBlock<T>> parameterBlock(const T& value = T())
+    {
+        KP_LOG_DEBUG("Kompute Manager parameter block creation triggered");
+
+        std::shared_ptr<ParameterBlock<T>> parameterBlock{
+            new kp::ParameterBlock<T>(
+              this->mPhysicalDevice, this->mDevice, value, this->mMemoryPool)
+        };
+
+        if (this->mManageResources) {
+            std::lock_guard<std::mutex> lock(this->mManagedResourcesMutex);
+            this->mManagedTensors.push_back(parameterBlock);
+        }
+
+        return parameterBlock;
+    }
+
+    /**
+     * The memory pool used to sub-allocate the memory of the tensors created
+     * by this manager.
+     *
+     * @return a shared pointer to the memory pool, or nullptr if disabled
+     **/
+    std::shared_ptr<MemoryPool> getMemoryPool() const;
+
+    /**
+     * Sets the memory pool used by tensors created from this point onwards,
+     * which allows for a pool with a custom block size to be provided, or for
+     * pooling to be disabled by providing a nullptr so each buffer gets its own
+     * dedicated allocation. Existing tensors keep using their original pool.
+     *
+     * @param memoryPool The memory pool to use for new tensors, or nullptr
+     **/
+    void setMemoryPool(std::shared_ptr<MemoryPool> memoryPool);
+
+    /**
+     * Creates a staging ring that device tensors created from this point
+     * onwards transfer their data through, instead of each of these holding
+     * a dedicated staging buffer. The ring has to be large enough to hold the
+     * data of all the sync operations that are recorded at the same time.
+     * Providing a size of zero disables the staging ring for new tensors.
+     *
+     * @param size The size in bytes of the staging ring
+     **/
+    void enableStagingRing(
+      vk::DeviceSize size = KP_DEFAULT_STAGING_RING_SIZE);
+
+    /**
+     * The staging ring used by the device tensors created by this manager.
+     *
+     * @return a shared pointer to the staging ring, or nullptr if disabled
+     **/
+    std::shared_ptr<StagingRing> getStagingRing() const;
+
+    /**
+     * The pool that the sequences created by this manager acquire their
+     * fences from, which are recycled across evals, as well as the timeline
+     * semaphores used for dependencies between sequences when the device
+     * supports these.
+     *
+     * @return a shared pointer to the sync pool
+     **/
+    std::shared_ptr<SyncPool> getSyncPool() const;
+
+    /**
+     * Sets whether device tensors created from this point onwards are backed
+     * by memory that is both device local and host visible when the device
+     * provides it, as is the case on integrated and software devices or on
+     * discrete devices with resizable BAR. These tensors map their primary
+     * buffer directly so neither staging buffers nor the staging ring are
+     * used, and the sync operations only record barriers. Note that the host
+     * data is then the device data, so it must not be modified while a
+     * sequence that uses the tensor is running. Unified memory is enabled by
+     * default, so this is mainly used to opt out of it.
+     *
+     * @param unifiedMemory Whether to use unified memory when available
+     **/
+    void setUnifiedMemory(bool unifiedMemory);
+
+    /**
+     * Whether device tensors created by this manager use unified memory when
+     * the device provides it.
+     *
+     * @return Boolean stating whether unified memory is enabled
+     **/
+    bool getUnifiedMemory() const;
+
+    /**
+     * Sets whether sequences created by this manager afterwards allocate
+     * their command buffer from a command pool cached for the thread that
+     * creates the sequence and its queue family, instead of each sequence
+     * creating its own command pool. This avoids creating a command pool for
+     * every sequence when worker threads create many sequences, however as
+     * command pools cannot be used by several threads at the same time, the
+     * sequences have to be recorded and destroyed on the thread that created
+     * them, which is why this mode is opt-in. The cached command pools are
+     * destroyed with the manager.
+     *
+     * @param concurrentMode Whether to use per-thread command pools
+     **/
+    void setConcurrentMode(bool concurrentMode);
+
+    /**
+     * Whether sequences created by this manager use command pools cached for
+     * the thread that creates these.
+     *
+     * @return Boolean stating whether concurrent mode is enabled
+     **/
+    bool getConcurrentMode() const;
+
+    /**
+     * Replaces the pipeline cache shared by the algorithms created by this
+     * manager with one persisted to the file provided, which is loaded if it
+     * was written from the same device and driver, and which is written when
+     * the manager is destroyed. Pipelines that were compiled before, for
+     * example by a previous run of the process, are then not compiled again.
+     * The previous cache is destroyed, and only algorithms created or
+     * rebuilt afterwards use the new cache.
+     *
+     * @param path The file to load the pipeline cache from and save it to
+     **/
+    void enablePersistentPipelineCache(const std::string& path);
+
+    /**
+     * The pipeline cache shared by the algorithms created by this manager.
+     *
+     * @return a shared pointer to the pipeline cache
+     **/
+    std::shared_ptr<PipelineCache> getPipelineCache() const;
+
+    /**
+     * The allocator that the algorithms created by this manager allocate
+     * their descriptor sets from, and which caches their descriptor set
+     * layouts.
+     *
+     * @return a shared pointer to the descriptor allocator
+     **/
+    std::shared_ptr<DescriptorAllocator> getDescriptorAllocator() const;
+
+    /**
+     * The worker pool that the algorithms created through algorithmAsync are
+     * built on, which is created with a thread for each hardware thread the
+     * first time it is used.
+     *
+     * @return a shared pointer to the worker pool
+     **/
+    std::shared_ptr<WorkerPool> getWorkerPool();
+
   private:
     // -------------- OPTIONALLY OWNED RESOURCES
     std::shared_ptr<vk::Instance> mInstance = nullptr;
@@ -234,10 +633,28 @@ class Manager
     // -------------- ALWAYS OWNED RESOURCES
     std::vector<std::weak_ptr<Tensor>> mManagedTensors;
     std::vector<std::weak_ptr<Sequence>> mManagedSequences;
+    std::vector<std::weak_ptr<OpBlock>> mManagedBlocks;
     std::vector<std::weak_ptr<Algorithm>> mManagedAlgorithms;
+    std::mutex mManagedResourcesMutex;
+    std::shared_ptr<MemoryPool> mMemoryPool = nullptr;
+    std::shared_ptr<StagingRing> mStagingRing = nullptr;
+    std::shared_ptr<SyncPool> mSyncPool = nullptr;
+    std::shared_ptr<PipelineCache> mPipelineCache = nullptr;
+    std::shared_ptr<DescriptorAllocator> mDescriptorAllocator = nullptr;
+    std::shared_ptr<WorkerPool> mWorkerPool = nullptr;
+    bool mUnifiedMemory = true;
+    bool mExternalMemoryHostEnabled = false;
+    bool mTimelineSemaphoreEnabled = false;
 
     std::vector<uint32_t> mComputeQueueFamilyIndices;
     std::vector<std::shared_ptr<vk::Queue>> mComputeQueues;
+    // Held while submitting to the compute queue of the same index
+    std::vector<std::shared_ptr<std::mutex>> mComputeQueueMutexes;
+    bool mConcurrentMode = false;
+    // Command pools indexed by creating thread and queue family index
+    std::map<std::pair<std::thread::id, uint32_t>,
+             std::shared_ptr<vk::CommandPool>>
+      mThreadCommandPools;
 
     bool mManageResources = false;
 
@@ -251,6 +668,8 @@ class Manager
     void createDevice(const std::vector<uint32_t>& familyQueueIndices = {},
                       uint32_t hysicalDeviceIndex = 0,
                       const std::vector<std::string>& desiredExtensions = {});
+    std::shared_ptr<vk::CommandPool> threadCommandPool(
+      uint32_t queueFamilyIndex);
 };
 
 } // End namespace kp
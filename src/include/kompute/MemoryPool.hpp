@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <map>
+#include <mutex>
+
+#include "kompute/Core.hpp"
+#include "logger/Logger.hpp"
+
+#define KP_DEFAULT_MEMORY_POOL_BLOCK_SIZE (64 * 1024 * 1024)
+
+namespace kp {
+
+/**
+ * Block allocator that hands out aligned sub-allocations from large
+ * vk::DeviceMemory blocks, which avoids a vkAllocateMemory call (and the
+ * respective maxMemoryAllocationCount limit) for every buffer created.
+ *
+ * A separate list of blocks is kept for each memory type, and each block keeps
+ * an offset-ordered free list which is coalesced on release so memory can be
+ * reused. Blocks with host visible memory are mapped once on creation and
+ * remain mapped until the block is released.
+ *
+ * The pool can be used by several threads at the same time.
+ */
+class MemoryPool
+{
+  public:
+    /**
+     * Sub-allocation returned by the pool, which contains the memory block
+     * and the offset at which the resource is to be bound.
+     */
+    struct Allocation
+    {
+        vk::DeviceMemory memory;
+        vk::DeviceSize offset = 0;
+        vk::DeviceSize size = 0;
+        uint32_t memoryTypeIndex = 0;
+        void* mappedData = nullptr; ///< Host pointer to offset if mappable
+    };
+
+    /**
+     * Constructor for the memory pool which requires the devices that will be
+     * used to fetch the memory properties and allocate the blocks.
+     *
+     * @param physicalDevice The physical device to fetch memory properties
+     * @param device The device to allocate the memory blocks from
+     * @param blockSize The size in bytes for each of the memory blocks, which
+     * is capped to an eighth of the respective memory heap.
+     */
+    MemoryPool(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+               std::shared_ptr<vk::Device> device,
+               vk::DeviceSize blockSize = KP_DEFAULT_MEMORY_POOL_BLOCK_SIZE);
+
+    /**
+     * Destructor which frees all the memory blocks owned by the pool.
+     */
+    ~MemoryPool();
+
+    /**
+     * Sub-allocates memory that satisfies the requirements and property flags
+     * provided. Requests larger than half of the block size are given a
+     * dedicated block that is freed as soon as the allocation is released.
+     *
+     * @param memoryRequirements The memory requirements of the resource
+     * @param memoryPropertyFlags The memory property flags required
+     * @return Allocation with the memory and offset to bind the resource to
+     */
+    Allocation allocate(const vk::MemoryRequirements& memoryRequirements,
+                        const vk::MemoryPropertyFlags& memoryPropertyFlags);
+
+    /**
+     * Releases a sub-allocation back into the free list of its block.
+     *
+     * @param allocation The allocation previously returned by allocate
+     */
+    void free(const Allocation& allocation);
+
+    /**
+     * Frees all the memory blocks in the pool. Any allocations that are still
+     * held are invalidated, and are ignored when released.
+     */
+    void destroy();
+
+    /**
+     * Returns the number of device memory blocks currently allocated, which
+     * equates to the number of vkAllocateMemory calls that are alive.
+     *
+     * @return Number of memory blocks
+     */
+    uint32_t blockCount();
+
+    /**
+     * Finds the first memory type index that is allowed by the type bits and
+     * contains all the memory property flags provided.
+     *
+     * @param memoryProperties The memory properties of the physical device
+     * @param memoryTypeBits The memory type bits allowed by the resource
+     * @param memoryPropertyFlags The memory property flags required
+     * @return Index of the memory type, or -1 if none matches
+     */
+    static int32_t findMemoryTypeIndex(
+      const vk::PhysicalDeviceMemoryProperties& memoryProperties,
+      uint32_t memoryTypeBits,
+      const vk::MemoryPropertyFlags& memoryPropertyFlags);
+
+  private:
+    struct Block
+    {
+        vk::DeviceMemory memory;
+        vk::DeviceSize size = 0;
+        vk::DeviceSize used = 0;
+        void* mappedData = nullptr;
+        bool dedicated = false;
+        // Free ranges indexed by offset with their respective size
+        std::map<vk::DeviceSize, vk::DeviceSize> freeRanges;
+    };
+
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<vk::PhysicalDevice> mPhysicalDevice;
+    std::shared_ptr<vk::Device> mDevice;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    vk::PhysicalDeviceMemoryProperties mMemoryProperties;
+    vk::DeviceSize mBlockSize;
+    // Blocks indexed by memory type index
+    std::map<uint32_t, std::vector<std::unique_ptr<Block>>> mBlocks;
+    std::mutex mMutex;
+
+    Block* createBlock(uint32_t memoryTypeIndex,
+                       vk::DeviceSize size,
+                       bool dedicated);
+    void freeBlock(Block& block);
+    bool suballocate(Block& block,
+                     const vk::MemoryRequirements& memoryRequirements,
+                     vk::DeviceSize& offset);
+};
+
+} // End namespace kp
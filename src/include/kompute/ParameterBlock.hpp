@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <cstring>
+#include <type_traits>
+
+#include "kompute/Tensor.hpp"
+
+namespace kp {
+
+/**
+ * Small block of parameters of a trivially copyable type, such as a struct
+ * holding a learning rate or an iteration index, which is stored in a
+ * persistently mapped host visible and coherent buffer. The block is bound to
+ * algorithms as any other tensor, and the shader reads it as a storage buffer
+ * with the same layout as the type provided.
+ *
+ * As opposed to push constants, which are recorded into the command buffer,
+ * the values of the block can be updated between evaluations of a sequence
+ * without recording it again, given the host write is done before the
+ * submission that reads it and while no previous submission of the sequence
+ * is still running.
+ */
+template<typename T>
+class ParameterBlock : public Tensor
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Kompute ParameterBlock type has to be trivially copyable");
+
+  public:
+    /**
+     * Constructor which creates the host buffer of the block and initialises
+     * it with the value provided.
+     *
+     * @param physicalDevice The physical device to use to fetch properties
+     * @param device The device to use to create the buffer and memory from
+     * @param value The initial value of the parameters
+     * @param memoryPool Optional pool to sub-allocate the memory from
+     */
+    ParameterBlock(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                   std::shared_ptr<vk::Device> device,
+                   const T& value = T(),
+                   std::shared_ptr<MemoryPool> memoryPool = nullptr)
+      : Tensor(physicalDevice,
+               device,
+               nullptr,
+               (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t),
+               sizeof(uint32_t),
+               TensorDataTypes::eUnsignedInt,
+               TensorTypes::eHost,
+               memoryPool)
+    {
+        KP_LOG_DEBUG("Kompute ParameterBlock constructor with size {}",
+                     sizeof(T));
+
+        memset(this->mRawData, 0, this->memorySize());
+        this->set(value);
+    }
+
+    ~ParameterBlock() { KP_LOG_DEBUG("Kompute ParameterBlock destructor"); }
+
+    /**
+     * Writes the value of the parameters into the mapped memory of the block,
+     * which is read by the next submissions of the sequences that use it.
+     *
+     * @param value The new value of the parameters
+     */
+    void set(const T& value)
+    {
+        if (!this->mRawData) {
+            throw std::runtime_error(
+              "Kompute ParameterBlock set called on destroyed block");
+        }
+
+        memcpy(this->mRawData, &value, sizeof(T));
+    }
+
+    /**
+     * Reads the current value of the parameters from the mapped memory of the
+     * block.
+     *
+     * @return The value of the parameters
+     */
+    T get()
+    {
+        if (!this->mRawData) {
+            throw std::runtime_error(
+              "Kompute ParameterBlock get called on destroyed block");
+        }
+
+        T value;
+        memcpy(&value, this->mRawData, sizeof(T));
+        return value;
+    }
+};
+
+} // End namespace kp
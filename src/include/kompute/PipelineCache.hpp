@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+
+#include "kompute/Core.hpp"
+#include "logger/Logger.hpp"
+
+namespace kp {
+
+/**
+ * Pipeline cache shared by all the algorithms created by a manager, so the
+ * compilation results of a pipeline are reused by every algorithm and every
+ * rebuild that creates the same pipeline instead of each algorithm compiling
+ * its pipelines into a cache of its own.
+ *
+ * The cache can be persisted to a file, in which case it is initialised with
+ * the data of the file and the data is written back to the file when the
+ * cache is destroyed, so the pipelines are not compiled again when the
+ * process starts again. The file holds the vendor, device, driver version and
+ * pipeline cache UUID of the device it was written from, and files written
+ * from another device or driver are ignored.
+ *
+ * The cache also deduplicates the pipelines themselves, as algorithms with
+ * the same SPIR-V, specialization constants, push constant range and
+ * bindings share the same shader module, descriptor set layout, pipeline
+ * layout and pipeline, which are destroyed with the last algorithm that uses
+ * these. Only the descriptor sets are then created for each algorithm.
+ *
+ * Pipelines can be created from the cache by several threads at the same
+ * time.
+ */
+class PipelineCache
+{
+  public:
+    /**
+     * Pipeline and the resources it was created from, which are shared by
+     * the algorithms that create the same pipeline and destroyed with the
+     * last reference to these.
+     */
+    struct SharedPipeline
+    {
+        SharedPipeline(
+          std::shared_ptr<vk::Device> device,
+          std::shared_ptr<vk::DescriptorSetLayout> descriptorSetLayout,
+          std::shared_ptr<vk::ShaderModule> shaderModule,
+          std::shared_ptr<vk::PipelineLayout> pipelineLayout,
+          std::shared_ptr<vk::Pipeline> pipeline);
+        ~SharedPipeline();
+
+        std::shared_ptr<vk::Device> device;
+        std::shared_ptr<vk::DescriptorSetLayout> descriptorSetLayout;
+        std::shared_ptr<vk::ShaderModule> shaderModule;
+        std::shared_ptr<vk::PipelineLayout> pipelineLayout;
+        std::shared_ptr<vk::Pipeline> pipeline;
+    };
+
+    /**
+     * Constructor for the cache, which loads the data of the file provided
+     * if it exists and was written from the same device and driver.
+     *
+     * @param physicalDevice The physical device used to validate the file
+     * @param device The device to create the cache from
+     * @param path (optional) The file to load the cache from and save it to,
+     * which keeps the cache in memory only if empty
+     */
+    PipelineCache(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                  std::shared_ptr<vk::Device> device,
+                  const std::string& path = "");
+
+    /**
+     * Destructor which saves the cache to its file and destroys it, unless
+     * this has been done already through destroy.
+     */
+    ~PipelineCache();
+
+    /**
+     * The Vulkan pipeline cache to create the pipelines from.
+     *
+     * @return Shared pointer to the pipeline cache, or nullptr if destroyed
+     */
+    std::shared_ptr<vk::PipelineCache> getVkPipelineCache();
+
+    /**
+     * The file the cache is persisted to.
+     *
+     * @return The path of the file, or an empty string if not persisted
+     */
+    const std::string& getPath() const;
+
+    /**
+     * Whether the cache was initialised with the data of its file.
+     *
+     * @return Boolean stating whether the file was loaded
+     */
+    bool isLoaded() const;
+
+    /**
+     * Finds a pipeline that is still used by an algorithm from the content
+     * it was created from.
+     *
+     * @param key The bytes of the SPIR-V, specialization constants, push
+     * constant range and bindings of the pipeline
+     * @return The shared pipeline, or nullptr if none was found
+     */
+    std::shared_ptr<SharedPipeline> findPipeline(const std::string& key);
+
+    /**
+     * Adds a pipeline so algorithms created from the same content share it.
+     * If another thread added a pipeline with the same content in the
+     * meantime, that pipeline is returned instead of the one provided.
+     *
+     * @param key The bytes of the content the pipeline was created from
+     * @param pipeline The pipeline to share
+     * @return The pipeline to use for the content provided
+     */
+    std::shared_ptr<SharedPipeline> addPipeline(
+      const std::string& key,
+      std::shared_ptr<SharedPipeline> pipeline);
+
+    /**
+     * Number of pipelines that are still used by algorithms.
+     *
+     * @return Number of shared pipelines
+     */
+    uint32_t pipelineCount();
+
+    /**
+     * Writes the data of the cache to its file, which is first written to a
+     * temporary file that then replaces it so the file is never left partly
+     * written. Nothing is written if the cache is not persisted.
+     */
+    void save();
+
+    /**
+     * Saves the cache to its file and destroys it. Algorithms that still use
+     * the cache have to be destroyed beforehand.
+     */
+    void destroy();
+
+  private:
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<vk::PhysicalDevice> mPhysicalDevice;
+    std::shared_ptr<vk::Device> mDevice;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    std::shared_ptr<vk::PipelineCache> mPipelineCache;
+    std::string mPath;
+    bool mLoaded = false;
+    // Pipelines indexed by the content these were created from
+    std::unordered_map<std::string, std::weak_ptr<SharedPipeline>> mPipelines;
+    std::mutex mMutex;
+
+    std::vector<uint8_t> loadFile();
+};
+
+} // End namespace kp
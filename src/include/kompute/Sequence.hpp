@@ -1,8 +1,13 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
+#include <deque>
+#include <mutex>
+
 #include "kompute/Core.hpp"
 
+#include "kompute/HazardTracker.hpp"
+#include "kompute/SyncPool.hpp"
 #include "kompute/operations/OpAlgoDispatch.hpp"
 #include "kompute/operations/OpBase.hpp"
 
@@ -23,12 +28,23 @@ class Sequence : public std::enable_shared_from_this<Sequence>
      * @param computeQueue Vulkan compute queue
      * @param queueIndex Vulkan compute queue index in device
      * @param totalTimestamps Maximum number of timestamps to allocate
+     * @param syncPool (optional) Pool to acquire the fences for the evals
+     * from, otherwise the sequence creates its own pool
+     * @param queueMutex (optional) Mutex held while submitting to the compute
+     * queue, which has to be shared by all the sequences that submit to the
+     * same queue from different threads
+     * @param commandPool (optional) Command pool to allocate the command
+     * buffer from, which is not owned by the sequence and has to be only used
+     * by one thread at a time, otherwise the sequence creates its own pool
      */
     Sequence(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
              std::shared_ptr<vk::Device> device,
              std::shared_ptr<vk::Queue> computeQueue,
              uint32_t queueIndex,
-             uint32_t totalTimestamps = 0);
+             uint32_t totalTimestamps = 0,
+             std::shared_ptr<SyncPool> syncPool = nullptr,
+             std::shared_ptr<std::mutex> queueMutex = nullptr,
+             std::shared_ptr<vk::CommandPool> commandPool = nullptr);
     /**
      * Destructor for sequence which is responsible for cleaning all subsequent
      * owned operations.
@@ -194,8 +210,9 @@ class Sequence : public std::enable_shared_from_this<Sequence>
     }
 
     /**
-     * Eval Await waits for the fence to finish processing and then once it
-     * finishes, it runs the postEval of all operations.
+     * Eval Await waits for the fences of all the submissions in flight to
+     * finish processing and then once these finish, it runs the postEval of
+     * all operations once for each of the submissions.
      *
      * @param waitFor Number of milliseconds to wait before timing out.
      * @return shared_ptr<Sequence> of the Sequence class itself
@@ -248,7 +265,10 @@ class Sequence : public std::enable_shared_from_this<Sequence>
     /**
      * Clears command buffer and triggers re-record of all the current
      * operations saved, which is useful if the underlying kp::Tensors or
-     * kp::Algorithms are modified and need to be re-recorded.
+     * kp::Algorithms are modified and need to be re-recorded. This is done
+     * automatically when the sequence is evaluated if any of its operations
+     * requires it or the record version of any of them has changed, waiting
+     * for the submissions in flight first.
      */
     void rerecord();
 
@@ -260,6 +280,87 @@ class Sequence : public std::enable_shared_from_this<Sequence>
      */
     bool isRunning() const;
 
+    /**
+     * Sets the number of submissions of the sequence that can be in flight at
+     * the same time, which allows evalAsync to be called again while the
+     * previous evals are still executing so the GPU is not left idle between
+     * iterations. When all the slots are busy, evalAsync waits for the oldest
+     * submission to finish. Each slot has its own command buffer, which the
+     * operations are recorded into the first time it is submitted, and the
+     * submissions are ordered by the barriers that the accesses of the
+     * operations require, as the first access to each tensor is synchronised
+     * with the commands submitted before it. The host data of the tensors is
+     * shared across the submissions, so it must not be modified while a
+     * submission that reads it is in flight, except for tensors that use the
+     * staging ring, whose host data is copied when submitted.
+     *
+     * @param maxInFlight Number of submissions that can be in flight, where 1
+     * (default) makes evalAsync throw while the sequence is running
+     */
+    void setMaxInFlight(uint32_t maxInFlight);
+
+    /**
+     * Returns the number of submissions of the sequence that can be in flight
+     * at the same time.
+     *
+     * @return Maximum number of submissions in flight
+     */
+    uint32_t getMaxInFlight() const;
+
+    /**
+     * Returns the number of submissions of the sequence that have not been
+     * awaited yet.
+     *
+     * @return Number of submissions in flight
+     */
+    uint32_t inFlightCount() const;
+
+    /**
+     * Makes the following submissions of this sequence wait on the device for
+     * the latest submission of the sequence provided at the time of each
+     * evalAsync, without a round trip to the host, which allows multi-stage
+     * and multi-queue workloads to run back to back. Dependencies are tracked
+     * through timeline semaphores, so an exception is thrown if these are not
+     * supported by the device. The postEval of the sequence provided still
+     * only runs when it is awaited.
+     *
+     * @param sequence The sequence to wait for, which is not kept alive
+     * @return shared_ptr<Sequence> of the Sequence class itself
+     */
+    std::shared_ptr<Sequence> addDependency(std::shared_ptr<Sequence> sequence);
+
+    /**
+     * Removes all the dependencies added to the sequence.
+     */
+    void clearDependencies();
+
+    /**
+     * Returns the timeline value that the latest submission of the sequence
+     * signals once it finishes, which increases by one on every evalAsync.
+     *
+     * @return Timeline value of the latest submission, or 0 if none or if
+     * timeline semaphores are not supported
+     */
+    uint64_t getTimelineValue() const;
+
+    /**
+     * Returns the timeline value of the latest submission of the sequence
+     * that finished executing, without blocking.
+     *
+     * @return Timeline value of the latest finished submission, or 0 if
+     * timeline semaphores are not supported
+     */
+    uint64_t getCompletedTimelineValue();
+
+    /**
+     * Returns whether all the submissions of the sequence finished executing
+     * on the device, without blocking. The postEval of the operations only
+     * runs once the sequence is awaited.
+     *
+     * @return Boolean stating whether all submissions finished
+     */
+    bool isCompleted();
+
     /**
      * Destroys and frees the GPU resources which include the buffer and memory
      * and sets the sequence as init=False.
@@ -267,31 +368,79 @@ class Sequence : public std::enable_shared_from_this<Sequence>
     void destroy();
 
   private:
+    friend class SubmissionBatch;
+
+    // Fence of a submission in flight, which is shared with the other
+    // sequences of a submission batch when batchFence is set, and the command
+    // buffer of the ring it submitted
+    struct Submission
+    {
+        vk::Fence fence;
+        std::shared_ptr<vk::Fence> batchFence;
+        size_t commandBufferIndex;
+    };
+
+    // Submit info of the sequence along with the arrays it references
+    struct SubmitResources
+    {
+        std::vector<vk::Semaphore> waitSemaphores;
+        std::vector<uint64_t> waitValues;
+        std::vector<vk::PipelineStageFlags> waitStages;
+        size_t commandBufferIndex = 0;
+        uint64_t signalValue = 0;
+        vk::TimelineSemaphoreSubmitInfo timelineSemaphoreSubmitInfo;
+        vk::SubmitInfo submitInfo;
+    };
+
     // -------------- NEVER OWNED RESOURCES
     std::shared_ptr<vk::PhysicalDevice> mPhysicalDevice = nullptr;
     std::shared_ptr<vk::Device> mDevice = nullptr;
     std::shared_ptr<vk::Queue> mComputeQueue = nullptr;
     uint32_t mQueueIndex = -1;
+    std::shared_ptr<SyncPool> mSyncPool = nullptr;
+    std::shared_ptr<std::mutex> mQueueMutex = nullptr;
 
     // -------------- OPTIONALLY OWNED RESOURCES
     std::shared_ptr<vk::CommandPool> mCommandPool = nullptr;
     bool mFreeCommandPool = false;
+    // Command buffer of the ring that is recorded into and submitted next
     std::shared_ptr<vk::CommandBuffer> mCommandBuffer = nullptr;
     bool mFreeCommandBuffer = false;
+    // One command buffer per submission that can be in flight, submitted in
+    // turn, along with the recording version that each of these holds
+    std::vector<std::shared_ptr<vk::CommandBuffer>> mCommandBuffers;
+    std::vector<uint64_t> mCommandBufferVersions;
+    size_t mCommandBufferIndex = 0;
 
     // -------------- ALWAYS OWNED RESOURCES
-    vk::Fence mFence;
+    std::deque<Submission> mInFlightSubmissions; // Oldest to newest
+    vk::Semaphore mTimelineSemaphore;
+    uint64_t mTimelineValue = 0;
+    std::vector<std::weak_ptr<Sequence>> mDependencies;
     std::vector<std::shared_ptr<OpBase>> mOperations{};
+    std::vector<uint64_t> mOperationVersions{};
+    HazardTracker mHazardTracker;
     std::shared_ptr<vk::QueryPool> timestampQueryPool = nullptr;
 
     // State
     bool mRecording = false;
-    bool mIsRunning = false;
+    uint64_t mRecordingVersion = 0; // Increased every time recording begins
+    uint32_t mMaxInFlight = 1;
 
     // Create functions
     void createCommandPool();
     void createCommandBuffer();
     void createTimestampQueryPool(uint32_t totalTimestamps);
+
+    void beginCommandBuffer(const vk::CommandBuffer& commandBuffer);
+    void recordOperation(const vk::CommandBuffer& commandBuffer,
+                         HazardTracker& hazardTracker,
+                         std::shared_ptr<OpBase> op,
+                         uint32_t timestampIndex);
+    void recordCommandBuffer();
+    void prepareSubmit(SubmitResources& resources);
+    bool awaitSubmissions(size_t count, uint64_t waitFor);
+    void awaitFence(vk::Fence fence);
 };
 
 } // End namespace kp
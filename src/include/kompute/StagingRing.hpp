@@ -0,0 +1,191 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <map>
+#include <mutex>
+
+#include "kompute/BarrierBuilder.hpp"
+#include "kompute/Core.hpp"
+#include "logger/Logger.hpp"
+
+#define KP_DEFAULT_STAGING_RING_SIZE (64 * 1024 * 1024)
+
+namespace kp {
+
+/**
+ * Persistently mapped host visible buffer that uploads and readbacks of device
+ * tensors stream through, instead of each device tensor holding a dedicated
+ * staging buffer for its whole lifetime.
+ *
+ * Slices are held by the operation that recorded the copy commands for each
+ * command buffer it was recorded into, as the command buffer can be submitted
+ * again, and are released when the operation is recorded again into the same
+ * command buffer or destroyed, which can only happen once that command buffer
+ * is no longer pending. The space of released slices is returned to a free
+ * list in any order, so slices held by long-lived recorded sequences do not
+ * prevent the space of other slices from being reused.
+ *
+ * When there is not enough contiguous space left in the ring, including when
+ * the slice is larger than the whole ring, the slice is backed by a dedicated
+ * host visible buffer instead, which is destroyed along with the slice.
+ *
+ * Slices can be allocated and released by several threads at the same time.
+ */
+class StagingRing : public std::enable_shared_from_this<StagingRing>
+{
+  public:
+    /**
+     * Region of the staging ring reserved for the copy commands of an
+     * operation, which is released back into the ring when destroyed. Slices
+     * that did not fit in the ring own a dedicated buffer and memory, given
+     * by a non-null memory, which are destroyed along with the slice.
+     */
+    class Slice
+    {
+      public:
+        Slice(std::shared_ptr<StagingRing> stagingRing,
+              std::shared_ptr<vk::Buffer> buffer,
+              std::shared_ptr<vk::DeviceMemory> memory,
+              vk::DeviceSize offset,
+              vk::DeviceSize size,
+              void* mappedData);
+        ~Slice();
+
+        std::shared_ptr<vk::Buffer> buffer();
+        vk::DeviceSize offset();
+        vk::DeviceSize size();
+        void* mappedData();
+        bool isDedicated();
+
+      private:
+        friend class StagingRing;
+
+        std::shared_ptr<StagingRing> mStagingRing;
+        std::shared_ptr<vk::Buffer> mBuffer;
+        std::shared_ptr<vk::DeviceMemory> mMemory;
+        vk::DeviceSize mOffset;
+        vk::DeviceSize mSize;
+        void* mMappedData;
+    };
+
+    /**
+     * Constructor for the staging ring which creates the buffer and the host
+     * visible memory, which remains mapped until the ring is destroyed.
+     *
+     * @param physicalDevice The physical device to fetch memory properties
+     * @param device The device to create the buffer and memory from
+     * @param size The total size in bytes of the ring
+     */
+    StagingRing(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                std::shared_ptr<vk::Device> device,
+                vk::DeviceSize size = KP_DEFAULT_STAGING_RING_SIZE);
+
+    /**
+     * Destructor which frees the buffer and memory of the ring.
+     */
+    ~StagingRing();
+
+    /**
+     * Reserves a slice of the ring from the first free region that is large
+     * enough. If there is not enough contiguous space available, the slice is
+     * backed by a dedicated buffer instead, so the ring only has to be large
+     * enough for the data transferred by the recorded operations to avoid
+     * creating buffers.
+     *
+     * @param size The size in bytes of the slice
+     * @return Shared pointer to the slice which is released when destroyed
+     */
+    std::shared_ptr<Slice> allocate(vk::DeviceSize size);
+
+    /**
+     * Records a buffer memory barrier over the region of the slice provided.
+     *
+     * @param commandBuffer Vulkan Command Buffer to record the commands into
+     * @param slice The slice to record the barrier for
+     * @param srcAccessMask Access flags for source access mask
+     * @param dstAccessMask Access flags for destination access mask
+     * @param scrStageMask Pipeline stage flags for source stage mask
+     * @param dstStageMask Pipeline stage flags for destination stage mask
+     */
+    void recordSliceMemoryBarrier(const vk::CommandBuffer& commandBuffer,
+                                  const Slice& slice,
+                                  vk::AccessFlagBits srcAccessMask,
+                                  vk::AccessFlagBits dstAccessMask,
+                                  vk::PipelineStageFlagBits srcStageMask,
+                                  vk::PipelineStageFlagBits dstStageMask);
+
+    /**
+     * Adds a buffer memory barrier over the region of the slice provided to
+     * a barrier builder, so it is recorded along with other barriers.
+     *
+     * @param barrierBuilder The barrier builder to add the barrier to
+     * @param slice The slice to add the barrier for
+     * @param srcAccessMask Access flags for source access mask
+     * @param dstAccessMask Access flags for destination access mask
+     * @param scrStageMask Pipeline stage flags for source stage mask
+     * @param dstStageMask Pipeline stage flags for destination stage mask
+     */
+    void addSliceMemoryBarrier(BarrierBuilder& barrierBuilder,
+                               const Slice& slice,
+                               vk::AccessFlagBits srcAccessMask,
+                               vk::AccessFlagBits dstAccessMask,
+                               vk::PipelineStageFlagBits srcStageMask,
+                               vk::PipelineStageFlagBits dstStageMask);
+
+    /**
+     * Destroys the buffer and memory of the ring. Any slices that are still
+     * held become invalid.
+     */
+    void destroy();
+
+    /**
+     * Total size in bytes of the ring.
+     *
+     * @return Size of the ring
+     */
+    vk::DeviceSize size();
+
+    /**
+     * Total size in bytes currently reserved by slices, which does not include
+     * the slices backed by dedicated buffers.
+     *
+     * @return Bytes in use in the ring
+     */
+    vk::DeviceSize usedSize();
+
+    /**
+     * Number of slices currently backed by dedicated buffers as these did not
+     * fit in the ring.
+     *
+     * @return Number of dedicated slices
+     */
+    uint32_t dedicatedCount();
+
+  private:
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<vk::PhysicalDevice> mPhysicalDevice;
+    std::shared_ptr<vk::Device> mDevice;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    std::shared_ptr<vk::Buffer> mBuffer;
+    std::shared_ptr<vk::DeviceMemory> mMemory;
+    void* mMappedData = nullptr;
+    vk::DeviceSize mSize;
+    vk::DeviceSize mUsedSize = 0;
+    // Free regions indexed by offset, which are merged with their neighbours
+    // when released so these remain as large as possible
+    std::map<vk::DeviceSize, vk::DeviceSize> mFreeRegions;
+    uint32_t mDedicatedCount = 0;
+    std::mutex mMutex;
+
+    void createBuffer(std::shared_ptr<vk::Buffer> buffer,
+                      std::shared_ptr<vk::DeviceMemory> memory,
+                      vk::DeviceSize size);
+    void destroyBuffer(std::shared_ptr<vk::Buffer> buffer,
+                       std::shared_ptr<vk::DeviceMemory> memory);
+    void release(vk::DeviceSize offset, vk::DeviceSize size);
+    void releaseDedicated(std::shared_ptr<vk::Buffer> buffer,
+                          std::shared_ptr<vk::DeviceMemory> memory);
+};
+
+} // End namespace kp
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/Core.hpp"
+
+#include "kompute/Sequence.hpp"
+#include "kompute/SyncPool.hpp"
+
+namespace kp {
+
+/**
+ * Group of sequences that are submitted together, with the command buffers
+ * of all the sequences that use the same queue submitted in a single
+ * vkQueueSubmit, which avoids the overhead of a submission per sequence when
+ * many independent sequences are evaluated at once.
+ *
+ * The batch acts as the completion handle for all its sequences. Awaiting it
+ * runs the postEval of the operations of each sequence, as evalAwait would.
+ * Sequences in the batch can also be awaited individually.
+ */
+class SubmissionBatch
+{
+  public:
+    /**
+     * Constructor for the batch which submits the sequences provided, in the
+     * order provided, so a sequence that depends on another sequence of the
+     * batch has to be provided after it.
+     *
+     * @param device The device of the sequences
+     * @param syncPool The pool to acquire the fences of the batch from
+     * @param sequences The sequences to submit, which cannot be running unless
+     * these allow several submissions in flight
+     */
+    SubmissionBatch(std::shared_ptr<vk::Device> device,
+                    std::shared_ptr<SyncPool> syncPool,
+                    const std::vector<std::shared_ptr<Sequence>>& sequences);
+
+    /**
+     * Destructor for the batch. Fences are released back into the pool once
+     * neither the batch nor any of its sequences reference them.
+     */
+    ~SubmissionBatch();
+
+    /**
+     * Waits for all the sequences of the batch to finish processing and then
+     * runs the postEval of the operations of each sequence.
+     *
+     * @param waitFor Number of nanoseconds to wait before timing out.
+     * @return Boolean stating whether the batch finished before the timeout
+     */
+    bool evalAwait(uint64_t waitFor = UINT64_MAX);
+
+    /**
+     * Returns whether all the sequences of the batch finished executing on
+     * the device, without blocking.
+     *
+     * @return Boolean stating whether the batch finished
+     */
+    bool isCompleted();
+
+    /**
+     * Gets the sequences submitted in the batch.
+     *
+     * @return The sequences of the batch
+     */
+    const std::vector<std::shared_ptr<Sequence>>& getSequences();
+
+  private:
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<vk::Device> mDevice;
+    std::vector<std::shared_ptr<Sequence>> mSequences;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    std::vector<std::shared_ptr<vk::Fence>> mFences; // One per queue
+    std::vector<size_t> mSequenceFences; // Index in mFences per sequence
+};
+
+} // End namespace kp
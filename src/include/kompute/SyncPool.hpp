@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <mutex>
+
+#include "kompute/Core.hpp"
+#include "logger/Logger.hpp"
+
+namespace kp {
+
+/**
+ * Pool of synchronisation primitives that are recycled across submissions
+ * instead of being created and destroyed for every eval, which removes these
+ * driver calls from the latency critical path of small and frequent evals.
+ *
+ * Fences are handed out unsignaled and are reset with vkResetFences when
+ * released. Fences that are released before they signal, such as after an
+ * evalAwait that timed out, are only reused once they have signalled.
+ *
+ * Timeline semaphores are held by a sequence for its whole lifetime, so these
+ * are destroyed when released rather than recycled, as a signal that is still
+ * pending would otherwise advance the value seen by the next holder.
+ *
+ * The pool can be used by several threads at the same time.
+ */
+class SyncPool
+{
+  public:
+    /**
+     * Constructor for the pool, which creates primitives lazily as these are
+     * acquired.
+     *
+     * @param device The device to create the primitives from
+     * @param timelineSemaphores Whether the device was created with the
+     * VK_KHR_timeline_semaphore extension and feature enabled
+     */
+    SyncPool(std::shared_ptr<vk::Device> device,
+             bool timelineSemaphores = false);
+
+    /**
+     * Destructor which destroys all the primitives created by the pool.
+     */
+    ~SyncPool();
+
+    /**
+     * Acquires an unsignaled fence, which is created if none of the released
+     * fences can be reused.
+     *
+     * @return Fence that is held until released back into the pool
+     */
+    vk::Fence acquireFence();
+
+    /**
+     * Releases a fence back into the pool so it can be reused.
+     *
+     * @param fence The fence acquired from this pool
+     * @param signaled Whether the fence is known to be signaled, otherwise it
+     * is only reused after it signals
+     */
+    void releaseFence(vk::Fence fence, bool signaled = true);
+
+    /**
+     * Whether timeline semaphores can be acquired from the pool.
+     *
+     * @return Boolean stating whether timeline semaphores are supported
+     */
+    bool supportsTimelineSemaphores();
+
+    /**
+     * Acquires a timeline semaphore with an initial value of zero. An
+     * exception is thrown if timeline semaphores are not supported.
+     *
+     * @return Timeline semaphore that is held until released
+     */
+    vk::Semaphore acquireTimelineSemaphore();
+
+    /**
+     * Releases a timeline semaphore acquired from this pool, which destroys
+     * it so no submission that uses it may still be pending.
+     *
+     * @param semaphore The timeline semaphore acquired from this pool
+     */
+    void releaseTimelineSemaphore(vk::Semaphore semaphore);
+
+    /**
+     * Queries the current value of a timeline semaphore without blocking.
+     *
+     * @param semaphore The timeline semaphore acquired from this pool
+     * @return The value of the semaphore
+     */
+    uint64_t getTimelineSemaphoreValue(vk::Semaphore semaphore);
+
+    /**
+     * Destroys all the primitives created by the pool. Primitives that are
+     * still held become invalid.
+     */
+    void destroy();
+
+    /**
+     * Total number of fences created by the pool.
+     *
+     * @return Number of fences
+     */
+    uint32_t fenceCount();
+
+    /**
+     * Number of fences that are ready to be acquired without creating or
+     * resetting a fence.
+     *
+     * @return Number of available fences
+     */
+    uint32_t availableFenceCount();
+
+  private:
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<vk::Device> mDevice;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    std::vector<vk::Fence> mFences;
+    std::vector<vk::Fence> mAvailableFences;
+    std::vector<vk::Fence> mPendingFences; // Released but not yet signaled
+    std::vector<vk::Semaphore> mSemaphores;
+    std::mutex mMutex;
+    PFN_vkGetSemaphoreCounterValueKHR mGetSemaphoreCounterValue = nullptr;
+};
+
+} // End namespace kp
@@ -1,12 +1,27 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
+#include "kompute/BarrierBuilder.hpp"
 #include "kompute/Core.hpp"
+#include "kompute/MemoryPool.hpp"
+#include "kompute/StagingRing.hpp"
 #include "logger/Logger.hpp"
 #include <string>
 
 namespace kp {
 
+class TensorView;
+
+/**
+ * Contiguous range of elements within a tensor, which can be used to restrict
+ * transfers and barriers to the part of the tensor that is relevant.
+ */
+struct TensorRange
+{
+    uint64_t offset; ///< Index of the first element in the range
+    uint64_t size;   ///< Total number of elements in the range
+};
+
 /**
  * Structured data used in GPU operations.
  *
@@ -49,16 +64,34 @@ class Tensor
      *  @param physicalDevice The physical device to use to fetch properties
      *  @param device The device to use to create the buffer and memory from
      *  @param data Non-zero-sized vector of data that will be used by the
-     * tensor
+     * tensor, or nullptr to leave the memory of the tensor uninitialised
      *  @param tensorTypes Type for the tensor which is of type TensorTypes
+     *  @param memoryPool Optional pool to sub-allocate the memory from, which
+     * otherwise results in a dedicated allocation for each buffer
+     *  @param stagingRing Optional staging ring for device tensors to transfer
+     * data through, in which case no dedicated staging buffer is created and
+     * the host data is kept in regular host memory
+     *  @param unifiedMemory Whether device tensors use memory that is both
+     * device local and host visible when the device provides it, in which case
+     * the primary buffer is mapped directly and no staging copies are needed
+     *  @param importHostMemory Whether to import the data pointer provided as
+     * the host visible memory of the tensor instead of copying it, which
+     * requires the VK_EXT_external_memory_host extension to be enabled on the
+     * device and the pointer and size to be aligned to the import granularity.
+     * The data is copied as usual if any of these is not the case, otherwise
+     * the memory has to outlive the tensor
      */
     Tensor(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
            std::shared_ptr<vk::Device> device,
            void* data,
-           uint32_t elementTotalCount,
+           uint64_t elementTotalCount,
            uint32_t elementMemorySize,
            const TensorDataTypes& dataType,
-           const TensorTypes& tensorType = TensorTypes::eDevice);
+           const TensorTypes& tensorType = TensorTypes::eDevice,
+           std::shared_ptr<MemoryPool> memoryPool = nullptr,
+           std::shared_ptr<StagingRing> stagingRing = nullptr,
+           bool unifiedMemory = false,
+           bool importHostMemory = false);
 
     /**
      * Destructor which is in charge of freeing vulkan resources unless they
@@ -68,13 +101,23 @@ class Tensor
 
     /**
      * Function to trigger reinitialisation of the tensor buffer and memory with
-     * new data as well as new potential device type.
+     * new data as well as new potential device type. The existing buffers and
+     * memory are kept if the new data fits in the capacity of the tensor,
+     * otherwise these are reallocated with a capacity that grows
+     * geometrically. Sequences that use the tensor record their operations
+     * again when next evaluated, and algorithms update their descriptors when
+     * they are next recorded, so the tensor must not be rebuilt while a
+     * sequence that uses it is running. Views of the tensor are updated to
+     * the new resources, and views that no longer fit within the new size can
+     * no longer be used.
      *
-     * @param data Vector of data to use to initialise vector from
-     * @param tensorType The type to use for the tensor
+     * @param data Vector of data to use to initialise vector from, or nullptr
+     * to leave the memory uninitialised
+     * @param elementTotalCount The number of elements of the data
+     * @param elementMemorySize The size in bytes of each element
      */
     void rebuild(void* data,
-                 uint32_t elementTotalCount,
+                 uint64_t elementTotalCount,
                  uint32_t elementMemorySize);
 
     /**
@@ -107,6 +150,16 @@ class Tensor
     void recordCopyFrom(const vk::CommandBuffer& commandBuffer,
                         std::shared_ptr<Tensor> copyFromTensor);
 
+    /**
+     * Records a fill of the primary buffer of the tensor with the 32-bit value
+     * provided, which requires the offset and the memory size of the tensor to
+     * be multiples of 4 bytes.
+     *
+     * @param commandBuffer Vulkan Command Buffer to record the commands into
+     * @param value The 32-bit pattern to fill the buffer with
+     */
+    void recordFill(const vk::CommandBuffer& commandBuffer, uint32_t value);
+
     /**
      * Records a copy from the internal staging memory to the device memory
      * using an optional barrier to wait for the operation. This function would
@@ -116,6 +169,16 @@ class Tensor
      */
     void recordCopyFromStagingToDevice(const vk::CommandBuffer& commandBuffer);
 
+    /**
+     * Records a copy of only the element ranges provided from the internal
+     * staging memory to the device memory, with one copy region per range.
+     *
+     * @param commandBuffer Vulkan Command Buffer to record the commands into
+     * @param ranges Element ranges of the tensor to copy
+     */
+    void recordCopyFromStagingToDevice(const vk::CommandBuffer& commandBuffer,
+                                       const std::vector<TensorRange>& ranges);
+
     /**
      * Records a copy from the internal device memory to the staging memory
      * using an optional barrier to wait for the operation. This function would
@@ -125,6 +188,88 @@ class Tensor
      */
     void recordCopyFromDeviceToStaging(const vk::CommandBuffer& commandBuffer);
 
+    /**
+     * Records a copy of only the element ranges provided from the internal
+     * device memory to the staging memory, with one copy region per range.
+     *
+     * @param commandBuffer Vulkan Command Buffer to record the commands into
+     * @param ranges Element ranges of the tensor to copy
+     */
+    void recordCopyFromDeviceToStaging(const vk::CommandBuffer& commandBuffer,
+                                       const std::vector<TensorRange>& ranges);
+
+    /**
+     * Retrieve the staging ring that the data of the tensor is transferred
+     * through, which is only set for device tensors created with a ring.
+     *
+     * @return Shared pointer to the staging ring or nullptr if not used
+     */
+    std::shared_ptr<StagingRing> stagingRing();
+
+    /**
+     * Check whether the primary buffer of the device tensor is backed by
+     * memory that is both device local and host visible, in which case the
+     * host data maps the primary buffer and syncs only require barriers.
+     *
+     * @return Boolean stating whether the tensor uses unified memory
+     */
+    bool isUnifiedMemory();
+
+    /**
+     * Check whether the host visible memory of the tensor was imported from
+     * the data pointer it was created with, in which case the host data of the
+     * tensor is that same memory rather than a copy of it.
+     *
+     * @return Boolean stating whether the host memory was imported
+     */
+    bool isHostMemoryImported();
+
+    /**
+     * Records a copy of the element ranges provided from a staging ring slice
+     * into the device memory, where the ranges are packed contiguously in the
+     * slice in the order provided.
+     *
+     * @param commandBuffer Vulkan Command Buffer to record the commands into
+     * @param slice Staging ring slice to copy the data from
+     * @param ranges Element ranges of the tensor to copy
+     */
+    void recordCopyFromStagingRing(const vk::CommandBuffer& commandBuffer,
+                                   StagingRing::Slice& slice,
+                                   const std::vector<TensorRange>& ranges);
+
+    /**
+     * Records a copy of the element ranges provided from the device memory
+     * into a staging ring slice, where the ranges are packed contiguously in
+     * the slice in the order provided.
+     *
+     * @param commandBuffer Vulkan Command Buffer to record the commands into
+     * @param slice Staging ring slice to copy the data into
+     * @param ranges Element ranges of the tensor to copy
+     */
+    void recordCopyToStagingRing(const vk::CommandBuffer& commandBuffer,
+                                 StagingRing::Slice& slice,
+                                 const std::vector<TensorRange>& ranges);
+
+    /**
+     * Copies the host data of the element ranges provided into the mapped
+     * memory of a staging ring slice, packed in the order provided.
+     *
+     * @param slice Staging ring slice to write the data into
+     * @param ranges Element ranges of the tensor to write
+     */
+    void writeToStagingRing(StagingRing::Slice& slice,
+                            const std::vector<TensorRange>& ranges);
+
+    /**
+     * Copies the data of the element ranges provided from the mapped memory
+     * of a staging ring slice into the host data of the tensor.
+     *
+     * @param slice Staging ring slice to read the data from
+     * @param ranges Element ranges of the tensor to read
+     */
+    void readFromStagingRing(StagingRing::Slice& slice,
+                             const std::vector<TensorRange>& ranges);
+
     /**
      * Records the buffer memory barrier into the primary buffer and command
      * buffer which ensures that relevant data transfers are carried out
@@ -135,13 +280,16 @@ class Tensor
      * @param dstAccessMask Access flags for destination access mask
      * @param scrStageMask Pipeline stage flags for source stage mask
      * @param dstStageMask Pipeline stage flags for destination stage mask
+     * @param ranges (Optional) Element ranges to restrict the barrier to, which
+     * defaults to the whole tensor
      */
     void recordPrimaryBufferMemoryBarrier(
       const vk::CommandBuffer& commandBuffer,
       vk::AccessFlagBits srcAccessMask,
       vk::AccessFlagBits dstAccessMask,
       vk::PipelineStageFlagBits srcStageMask,
-      vk::PipelineStageFlagBits dstStageMask);
+      vk::PipelineStageFlagBits dstStageMask,
+      const std::vector<TensorRange>& ranges = {});
     /**
      * Records the buffer memory barrier into the staging buffer and command
      * buffer which ensures that relevant data transfers are carried out
@@ -152,13 +300,71 @@ class Tensor
      * @param dstAccessMask Access flags for destination access mask
      * @param scrStageMask Pipeline stage flags for source stage mask
      * @param dstStageMask Pipeline stage flags for destination stage mask
+     * @param ranges (Optional) Element ranges to restrict the barrier to, which
+     * defaults to the whole tensor
      */
     void recordStagingBufferMemoryBarrier(
       const vk::CommandBuffer& commandBuffer,
       vk::AccessFlagBits srcAccessMask,
       vk::AccessFlagBits dstAccessMask,
       vk::PipelineStageFlagBits srcStageMask,
-      vk::PipelineStageFlagBits dstStageMask);
+      vk::PipelineStageFlagBits dstStageMask,
+      const std::vector<TensorRange>& ranges = {});
+
+    /**
+     * Adds the buffer memory barrier for the primary buffer to a barrier
+     * builder, so the barriers of several tensors that share the same stage
+     * masks are recorded with a single pipeline barrier.
+     *
+     * @param barrierBuilder The barrier builder to add the barrier to
+     * @param srcAccessMask Access flags for source access mask
+     * @param dstAccessMask Access flags for destination access mask
+     * @param scrStageMask Pipeline stage flags for source stage mask
+     * @param dstStageMask Pipeline stage flags for destination stage mask
+     * @param ranges (Optional) Element ranges to restrict the barrier to, which
+     * defaults to the whole tensor
+     */
+    void addPrimaryBufferMemoryBarrier(
+      BarrierBuilder& barrierBuilder,
+      vk::AccessFlagBits srcAccessMask,
+      vk::AccessFlagBits dstAccessMask,
+      vk::PipelineStageFlagBits srcStageMask,
+      vk::PipelineStageFlagBits dstStageMask,
+      const std::vector<TensorRange>& ranges = {});
+
+    /**
+     * Adds the buffer memory barrier for the staging buffer to a barrier
+     * builder, so the barriers of several tensors that share the same stage
+     * masks are recorded with a single pipeline barrier.
+     *
+     * @param barrierBuilder The barrier builder to add the barrier to
+     * @param srcAccessMask Access flags for source access mask
+     * @param dstAccessMask Access flags for destination access mask
+     * @param scrStageMask Pipeline stage flags for source stage mask
+     * @param dstStageMask Pipeline stage flags for destination stage mask
+     * @param ranges (Optional) Element ranges to restrict the barrier to, which
+     * defaults to the whole tensor
+     */
+    void addStagingBufferMemoryBarrier(
+      BarrierBuilder& barrierBuilder,
+      vk::AccessFlagBits srcAccessMask,
+      vk::AccessFlagBits dstAccessMask,
+      vk::PipelineStageFlagBits srcStageMask,
+      vk::PipelineStageFlagBits dstStageMask,
+      const std::vector<TensorRange>& ranges = {});
+
+    /**
+     * Constructs a buffer memory barrier for the whole tensor in its primary
+     * buffer without recording it, so the barriers of several tensors can be
+     * recorded with a single pipeline barrier.
+     *
+     * @param srcAccessMask Access flags for source access mask
+     * @param dstAccessMask Access flags for destination access mask
+     * @return Buffer memory barrier for the primary buffer
+     */
+    vk::BufferMemoryBarrier constructPrimaryBufferMemoryBarrier(
+      vk::AccessFlags srcAccessMask,
+      vk::AccessFlags dstAccessMask);
 
     /**
      * Constructs a vulkan descriptor buffer info which can be used to specify
@@ -169,13 +375,49 @@ class Tensor
      */
     vk::DescriptorBufferInfo constructDescriptorBufferInfo();
 
+    /**
+     * Constructs the descriptor buffer infos used to bind the tensor as an
+     * array of descriptors, with one descriptor for each chunk of
+     * descriptorChunkSize() elements. Tensors that fit in the
+     * maxStorageBufferRange of the device are bound with a single descriptor.
+     *
+     * @return Descriptor buffer infos for each of the chunks of the tensor
+     */
+    std::vector<vk::DescriptorBufferInfo> constructDescriptorBufferInfos();
+
+    /**
+     * Returns the number of descriptors used to bind the tensor, which is
+     * larger than one when its memory size exceeds the maxStorageBufferRange
+     * of the device. Shaders access these tensors through a descriptor array
+     * of this size.
+     *
+     * @return Number of descriptors used to bind the tensor
+     */
+    uint32_t descriptorCount();
+
+    /**
+     * Returns the number of elements bound by each of the descriptors of the
+     * tensor, where the last descriptor can hold fewer elements.
+     *
+     * @return Number of elements per descriptor
+     */
+    uint64_t descriptorChunkSize();
+
+    /**
+     * Returns the offset in bytes at which the data of the tensor starts within
+     * its buffer, which is only non-zero for tensor views.
+     *
+     * @return Offset in bytes within the underlying buffer
+     */
+    vk::DeviceSize offset();
+
     /**
      * Returns the size/magnitude of the Tensor, which will be the total number
      * of elements across all dimensions
      *
      * @return Unsigned integer representing the total number of elements
      */
-    uint32_t size();
+    uint64_t size();
 
     /**
      * Returns the total size of a single element of the respective data type
@@ -193,7 +435,25 @@ class Tensor
      * @return Unsigned integer representing the memory of a single element of
      * the respective data type.
      */
-    uint32_t memorySize();
+    uint64_t memorySize();
+
+    /**
+     * Returns the number of elements of the current data type that fit in the
+     * buffers of the tensor, which can be larger than its size after a
+     * rebuild with a smaller size.
+     *
+     * @return Unsigned integer representing the capacity of the tensor
+     */
+    uint64_t capacity();
+
+    /**
+     * Counter increased every time the tensor is rebuilt, which allows users
+     * of the buffer such as algorithms to detect when the size or the buffer
+     * bound to their descriptors has changed.
+     *
+     * @return The number of times the tensor has been built
+     */
+    uint64_t generation();
 
     /**
      * Retrieve the data type of the tensor (host, device, storage)
@@ -213,10 +473,83 @@ class Tensor
 
     /**
      * Sets / resets the data of the tensor which is directly done on the GPU
-     * host visible memory available by the tensor.
+     * host visible memory available by the tensor. The whole tensor is marked
+     * as dirty.
      */
     void setRawData(const void* data);
 
+    /**
+     * Sets the data of a range of elements of the tensor, which is directly
+     * done on the GPU host visible memory, and marks only that range as dirty.
+     *
+     * @param data Pointer to the data to copy into the range
+     * @param elementOffset Index of the first element to write
+     * @param elementCount Total number of elements to write
+     */
+    void setRawData(const void* data,
+                    uint64_t elementOffset,
+                    uint64_t elementCount);
+
+    /**
+     * Marks a range of elements as modified on the host, so it is uploaded by
+     * the next OpTensorSyncDevice that only syncs dirty ranges. Writes through
+     * setData and set mark the tensor automatically, whereas writes through
+     * operator[] or the raw data pointers have to be marked explicitly.
+     *
+     * @param elementOffset Index of the first element modified
+     * @param elementCount Total number of elements modified
+     */
+    void markDirty(uint64_t elementOffset, uint64_t elementCount);
+
+    /**
+     * Marks the whole tensor as modified on the host.
+     */
+    void markDirty();
+
+    /**
+     * Clears all the dirty ranges of the tensor.
+     */
+    void clearDirty();
+
+    /**
+     * Clears the element ranges provided from the dirty ranges of the tensor.
+     *
+     * @param ranges Element ranges that are no longer dirty
+     */
+    void clearDirty(const std::vector<TensorRange>& ranges);
+
+    /**
+     * Check whether any element of the tensor has been modified on the host
+     * since the last time it was synced.
+     *
+     * @return Boolean stating whether the tensor has dirty ranges
+     */
+    bool isDirty();
+
+    /**
+     * Retrieve the sorted and coalesced element ranges that have been modified
+     * on the host since the last time they were synced.
+     *
+     * @return Vector with the dirty element ranges
+     */
+    const std::vector<TensorRange>& dirtyRanges();
+
+    /**
+     * Total bytes that have been uploaded from the staging to the device
+     * memory by OpTensorSyncDevice evaluations.
+     *
+     * @return Total bytes uploaded
+     */
+    uint64_t bytesUploaded();
+
+    /**
+     * Total bytes that OpTensorSyncDevice evaluations have not needed to
+     * upload, as these were outside of the ranges synced.
+     *
+     * @return Total bytes skipped
+     */
+    uint64_t bytesSkipped();
+
     /**
      * Template to return the pointer data converted by specific type, which
      * would be any of the supported types including float, double, int32,
@@ -247,14 +580,31 @@ class Tensor
     // -------------- ALWAYS OWNED RESOURCES
     TensorTypes mTensorType;
     TensorDataTypes mDataType;
-    uint32_t mSize;
+    uint64_t mSize;
     uint32_t mDataTypeMemorySize;
     void* mRawData;
+    vk::DeviceSize mOffset = 0;
+    vk::DeviceSize mCapacityMemorySize = 0;
+    uint64_t mGeneration = 0;
+    std::vector<TensorRange> mDirtyRanges;
+    uint64_t mBytesUploaded = 0;
+    uint64_t mBytesSkipped = 0;
+
+    /**
+     * Constructor without GPU resources, used by subclasses that bind to the
+     * resources of an existing tensor.
+     */
+    Tensor() = default;
 
   private:
+    friend class TensorView;
+    friend class OpTensorSyncDevice;
+
     // -------------- NEVER OWNED RESOURCES
     std::shared_ptr<vk::PhysicalDevice> mPhysicalDevice;
     std::shared_ptr<vk::Device> mDevice;
+    std::shared_ptr<MemoryPool> mMemoryPool;
+    std::shared_ptr<StagingRing> mStagingRing;
 
     // -------------- OPTIONALLY OWNED RESOURCES
     std::shared_ptr<vk::Buffer> mPrimaryBuffer;
@@ -265,26 +615,57 @@ class Tensor
     bool mFreePrimaryMemory = false;
     std::shared_ptr<vk::DeviceMemory> mStagingMemory;
     bool mFreeStagingMemory = false;
-
-    void allocateMemoryCreateGPUResources(); // Creates the vulkan buffer
+    MemoryPool::Allocation mPrimaryAllocation;
+    bool mFreePrimaryAllocation = false;
+    MemoryPool::Allocation mStagingAllocation;
+    bool mFreeStagingAllocation = false;
+    // Host data of device tensors that use a staging ring
+    std::vector<uint8_t> mHostData;
+    bool mUnifiedMemory = false;
+    bool mImportHostMemory = false;
+    void* mImportedHostData = nullptr;
+    // Views created from the tensor, which unregister themselves when
+    // destroyed and are updated whenever the resources of the tensor change
+    std::vector<TensorView*> mViews;
+
+    void refreshViews();
+    void allocateMemoryCreateGPUResources(
+      void* importData = nullptr); // Creates the vulkan buffer
+    void freeMemoryDestroyGPUResources();
+    bool importHostMemory(std::shared_ptr<vk::Buffer> buffer,
+                          std::shared_ptr<vk::DeviceMemory> memory,
+                          vk::BufferUsageFlags bufferUsageFlags,
+                          vk::MemoryPropertyFlags memoryPropertyFlags,
+                          void* data);
+    bool supportsUnifiedMemory(std::shared_ptr<vk::Buffer> buffer);
     void createBuffer(std::shared_ptr<vk::Buffer> buffer,
                       vk::BufferUsageFlags bufferUsageFlags);
     void allocateBindMemory(std::shared_ptr<vk::Buffer> buffer,
                             std::shared_ptr<vk::DeviceMemory> memory,
                             vk::MemoryPropertyFlags memoryPropertyFlags);
+    void allocateBindPoolMemory(std::shared_ptr<vk::Buffer> buffer,
+                                std::shared_ptr<vk::DeviceMemory> memory,
+                                vk::MemoryPropertyFlags memoryPropertyFlags,
+                                MemoryPool::Allocation& allocation);
     void recordCopyBuffer(const vk::CommandBuffer& commandBuffer,
                           std::shared_ptr<vk::Buffer> bufferFrom,
                           std::shared_ptr<vk::Buffer> bufferTo,
                           vk::DeviceSize bufferSize,
                           vk::BufferCopy copyRegion);
-    void recordBufferMemoryBarrier(const vk::CommandBuffer& commandBuffer,
-                                   const vk::Buffer& buffer,
-                                   vk::AccessFlagBits srcAccessMask,
-                                   vk::AccessFlagBits dstAccessMask,
-                                   vk::PipelineStageFlagBits srcStageMask,
-                                   vk::PipelineStageFlagBits dstStageMask);
+    void recordCopyBufferRanges(const vk::CommandBuffer& commandBuffer,
+                                std::shared_ptr<vk::Buffer> bufferFrom,
+                                std::shared_ptr<vk::Buffer> bufferTo,
+                                const std::vector<TensorRange>& ranges);
+    void addBufferMemoryBarrier(BarrierBuilder& barrierBuilder,
+                                const vk::Buffer& buffer,
+                                vk::AccessFlagBits srcAccessMask,
+                                vk::AccessFlagBits dstAccessMask,
+                                vk::PipelineStageFlagBits srcStageMask,
+                                vk::PipelineStageFlagBits dstStageMask,
+                                const std::vector<TensorRange>& ranges);
 
     // Private util functions
+    vk::DeviceSize getDescriptorChunkMemorySize();
     vk::BufferUsageFlags getPrimaryBufferUsageFlags();
     vk::MemoryPropertyFlags getPrimaryMemoryPropertyFlags();
     vk::BufferUsageFlags getStagingBufferUsageFlags();
@@ -294,6 +675,58 @@ class Tensor
     void unmapRawData();
 };
 
+/**
+ * View over a contiguous range of elements of an existing tensor.
+ *
+ * Views share the buffers and memory of the tensor they are created from, so
+ * they can be bound to algorithms and used in copy and sync operations without
+ * creating new buffers or copying the data. The data type and tensor type are
+ * the same as the ones of the original tensor, which the view keeps alive.
+ * Views used as storage buffers in algorithms require the offset to be a
+ * multiple of the minStorageBufferOffsetAlignment of the device.
+ */
+class TensorView : public Tensor
+{
+  public:
+    /**
+     * Constructor for the view which binds to the resources of the tensor.
+     * The view follows the tensor when its resources are reallocated by a
+     * rebuild, and throws when used once the tensor no longer covers the
+     * range of the view.
+     *
+     * @param tensor The tensor (or view) to create the view from
+     * @param elementOffset The index of the first element in the view
+     * @param elementCount The total number of elements in the view
+     */
+    TensorView(std::shared_ptr<Tensor> tensor,
+               uint64_t elementOffset,
+               uint64_t elementCount);
+
+    /**
+     * Destructor which does not free any resources as these are owned by the
+     * original tensor.
+     */
+    ~TensorView();
+
+    /**
+     * Retrieve the tensor that this view was created from.
+     *
+     * @return Shared pointer to the original tensor
+     */
+    std::shared_ptr<Tensor> tensor();
+
+  private:
+    friend class Tensor;
+
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<Tensor> mTensor;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    uint64_t mElementOffset;
+
+    void refresh();
+};
+
 template<typename T>
 class TensorT : public Tensor
 {
@@ -302,21 +735,65 @@ class TensorT : public Tensor
     TensorT(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
             std::shared_ptr<vk::Device> device,
             const std::vector<T>& data,
-            const TensorTypes& tensorType = TensorTypes::eDevice)
+            const TensorTypes& tensorType = TensorTypes::eDevice,
+            std::shared_ptr<MemoryPool> memoryPool = nullptr,
+            std::shared_ptr<StagingRing> stagingRing = nullptr,
+            bool unifiedMemory = false)
       : Tensor(physicalDevice,
                device,
                (void*)data.data(),
                data.size(),
                sizeof(T),
                this->dataType(),
-               tensorType)
+               tensorType,
+               memoryPool,
+               stagingRing,
+               unifiedMemory)
     {
         KP_LOG_DEBUG("Kompute TensorT constructor with data size {}",
                      data.size());
     }
 
+    TensorT(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+            std::shared_ptr<vk::Device> device,
+            uint64_t elementTotalCount,
+            const TensorTypes& tensorType = TensorTypes::eDevice,
+            std::shared_ptr<MemoryPool> memoryPool = nullptr,
+            std::shared_ptr<StagingRing> stagingRing = nullptr,
+            bool unifiedMemory = false)
+      : Tensor(physicalDevice,
+               device,
+               nullptr,
+               elementTotalCount,
+               sizeof(T),
+               this->dataType(),
+               tensorType,
+               memoryPool,
+               stagingRing,
+               unifiedMemory)
+    {
+        KP_LOG_DEBUG("Kompute TensorT uninitialised constructor with size {}",
+                     elementTotalCount);
+    }
+
     ~TensorT() { KP_LOG_DEBUG("Kompute TensorT destructor"); }
 
+    using Tensor::rebuild;
+
+    /**
+     * Rebuilds the tensor with the data provided, which can be of a different
+     * size than the current data of the tensor.
+     *
+     * @param data Vector of data to rebuild the tensor with
+     */
+    void rebuild(const std::vector<T>& data)
+    {
+        KP_LOG_DEBUG("Kompute TensorT rebuilding with data size {}",
+                     data.size());
+
+        Tensor::rebuild((void*)data.data(), data.size(), sizeof(T));
+    }
+
     T* data() { return (T*)this->mRawData; }
 
     std::vector<T> vector()
@@ -324,7 +801,38 @@ class TensorT : public Tensor
         return { (T*)this->mRawData, ((T*)this->mRawData) + this->size() };
     }
 
-    T& operator[](int index) { return *(((T*)this->mRawData) + index); }
+    /**
+     * Returns a reference to the element at the index provided. Element
+     * access does not track modifications, so writes through the reference
+     * have to be marked with markDirty or done through set instead.
+     *
+     * @param index The index of the element
+     * @return Reference to the element in the host data of the tensor
+     */
+    T& operator[](uint64_t index) { return *(((T*)this->mRawData) + index); }
+
+    const T& operator[](uint64_t index) const
+    {
+        return *(((const T*)this->mRawData) + index);
+    }
+
+    /**
+     * Sets the element at the index provided and marks only that element as
+     * dirty.
+     *
+     * @param index The index of the element
+     * @param value The value to write into the host data of the tensor
+     */
+    void set(uint64_t index, const T& value)
+    {
+        if (index >= this->mSize) {
+            throw std::runtime_error(
+              "Kompute TensorT Cannot set data out of bounds");
+        }
+
+        *(((T*)this->mRawData) + index) = value;
+        this->markDirty(index, 1);
+    }
 
     void setData(const std::vector<T>& data)
     {
@@ -340,6 +848,20 @@ class TensorT : public Tensor
         Tensor::setRawData(data.data());
     }
 
+    void setData(uint64_t offset, const std::vector<T>& data)
+    {
+        KP_LOG_DEBUG("Kompute TensorT setting data with offset {} and size {}",
+                     offset,
+                     data.size());
+
+        if (offset + data.size() > this->mSize) {
+            throw std::runtime_error(
+              "Kompute TensorT Cannot set data out of bounds");
+        }
+
+        Tensor::setRawData(data.data(), offset, data.size());
+    }
+
     TensorDataTypes dataType();
 };
 
@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+
+#include "kompute/Core.hpp"
+#include "logger/Logger.hpp"
+
+namespace kp {
+
+/**
+ * Fixed pool of worker threads that run the tasks submitted to it in order,
+ * which is used to create the resources of algorithms, and compile their
+ * pipelines, in parallel and off the calling thread.
+ *
+ * Tasks can be submitted by several threads at the same time.
+ */
+class WorkerPool
+{
+  public:
+    /**
+     * Constructor for the pool, which starts its worker threads.
+     *
+     * @param threadCount The number of worker threads, which defaults to the
+     * number of hardware threads if zero
+     */
+    WorkerPool(uint32_t threadCount = 0);
+
+    /**
+     * Destructor which runs the tasks that are still queued and then joins
+     * the worker threads.
+     */
+    ~WorkerPool();
+
+    /**
+     * Queues a task to be run by one of the worker threads.
+     *
+     * @param task The function to run
+     * @return Future that is ready once the task has run, which rethrows the
+     * exception thrown by the task if any
+     */
+    std::shared_future<void> submit(const std::function<void()>& task);
+
+    /**
+     * The number of worker threads of the pool.
+     *
+     * @return Number of threads
+     */
+    uint32_t threadCount() const;
+
+  private:
+    // -------------- ALWAYS OWNED RESOURCES
+    std::vector<std::thread> mThreads;
+    std::deque<std::packaged_task<void()>> mTasks;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    bool mStopping = false;
+
+    void run();
+};
+
+} // End namespace kp
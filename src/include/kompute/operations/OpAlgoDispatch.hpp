@@ -50,26 +50,44 @@ class OpAlgoDispatch : public OpBase
     virtual ~OpAlgoDispatch() override;
 
     /**
-     * This records the commands that are to be sent to the GPU. This includes
-     * the barriers that ensure the memory has been copied before going in and
-     * out of the shader, as well as the dispatch operation that sends the
-     * shader processing to the gpu. This function also records the GPU memory
-     * copy of the output data for the staging buffer so it can be read by the
-     * host.
+     * Declares that the shader reads and writes all the tensors of the
+     * algorithm.
+     *
+     * @param accesses The vector to add the accesses of the operation to
+     * @return Boolean stating whether the operation declares its accesses
+     */
+    virtual bool declareAccesses(std::vector<TensorAccess>& accesses) override;
+
+    /**
+     * This records the commands that are to be sent to the GPU, which is the
+     * dispatch operation that sends the shader processing to the gpu. The
+     * barriers that ensure the memory has been written before going in and
+     * out of the shader are recorded by the sequence from the accesses
+     * declared.
      *
      * @param commandBuffer The command buffer to record the command into.
      */
     virtual void record(const vk::CommandBuffer& commandBuffer) override;
 
     /**
-     * Does not perform any preEval commands.
+     * Whether the algorithm is being rebuilt, its descriptor set has been
+     * written again since it was recorded, or any of its tensors has been
+     * rebuilt since.
+     *
+     * @return Boolean stating whether the operation has to be recorded again
+     */
+    bool requiresRerecord() override;
+
+    /**
+     * Marks the start of a submission that uses the algorithm, so descriptor
+     * sets replaced while it is running are kept until it completes.
      *
      * @param commandBuffer The command buffer to record the command into.
      */
     virtual void preEval(const vk::CommandBuffer& commandBuffer) override;
 
     /**
-     * Does not perform any postEval commands.
+     * Marks the completion of a submission that used the algorithm.
      *
      * @param commandBuffer The command buffer to record the command into.
      */
@@ -81,6 +99,7 @@ class OpAlgoDispatch : public OpBase
     void* mPushConstantsData = nullptr;
     uint32_t mPushConstantsDataTypeMemorySize = 0;
     uint32_t mPushConstantsSize = 0;
+    uint64_t mDescriptorSetVersion = 0;
 };
 
 } // End namespace kp
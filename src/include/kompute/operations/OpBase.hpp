@@ -3,6 +3,7 @@
 
 #include "kompute/Algorithm.hpp"
 #include "kompute/Core.hpp"
+#include "kompute/HazardTracker.hpp"
 #include "kompute/Tensor.hpp"
 
 namespace kp {
@@ -25,6 +26,22 @@ class OpBase
      */
     virtual ~OpBase() { KP_LOG_DEBUG("Kompute OpBase destructor started"); }
 
+    /**
+     * Declares the reads and writes that the commands recorded by the
+     * operation perform on the primary buffers of the tensors, which the
+     * Sequence uses to record only the barriers required before the
+     * operation. Operations that do not declare their accesses, which is the
+     * default, have to record their own barriers, and the Sequence then
+     * synchronises the following operations with any previous device write.
+     *
+     * @param accesses The vector to add the accesses of the operation to
+     * @return Boolean stating whether the operation declares its accesses
+     */
+    virtual bool declareAccesses(std::vector<TensorAccess>& /*accesses*/)
+    {
+        return false;
+    }
+
     /**
      * The record function is intended to only send a record command or run
      * commands that are expected to record operations that are to be submitted
@@ -34,6 +51,30 @@ class OpBase
      */
     virtual void record(const vk::CommandBuffer& commandBuffer) = 0;
 
+    /**
+     * Whether the commands recorded by the operation no longer match the
+     * tensors or algorithms it uses, such as when the ranges or buffers it
+     * recorded have changed since. The Sequence records all its operations
+     * again before submitting them when any of them requires it, which by
+     * default none do.
+     *
+     * @return Boolean stating whether the operation has to be recorded again
+     */
+    virtual bool requiresRerecord() { return false; }
+
+    /**
+     * Version of the commands that the operation shares with every sequence
+     * that records it, such as a secondary command buffer, which changes
+     * whenever these are recorded again. The Sequence stores the version when
+     * recording the operation and records all its operations again before
+     * submitting them when it has changed, as the commands recorded into its
+     * command buffer are then no longer valid. By default operations do not
+     * share any commands and the version is always 0.
+     *
+     * @return The version of the commands shared by the operation
+     */
+    virtual uint64_t recordVersion() { return 0; }
+
     /**
      * Pre eval is called before the Sequence has called eval and submitted the
      * commands to the GPU for processing, and can be used to perform any
@@ -57,6 +98,46 @@ class OpBase
      * @param commandBuffer The command buffer to record the command into.
      */
     virtual void postEval(const vk::CommandBuffer& commandBuffer) = 0;
+
+  protected:
+    /**
+     * Stores the generations of the tensors that the commands being recorded
+     * reference, so tensorsRebuilt can detect later rebuilds.
+     *
+     * @param tensors The tensors referenced by the recorded commands
+     */
+    void storeTensorGenerations(
+      const std::vector<std::shared_ptr<Tensor>>& tensors)
+    {
+        this->mTensorGenerations.clear();
+        for (const std::shared_ptr<Tensor>& tensor : tensors) {
+            this->mTensorGenerations.push_back(tensor->generation());
+        }
+    }
+
+    /**
+     * Whether any of the tensors has been rebuilt since its generation was
+     * stored, in which case the recorded commands may reference buffers that
+     * have since been freed.
+     *
+     * @param tensors The tensors referenced by the recorded commands
+     * @return Boolean stating whether any of the tensors was rebuilt
+     */
+    bool tensorsRebuilt(const std::vector<std::shared_ptr<Tensor>>& tensors)
+    {
+        if (tensors.size() != this->mTensorGenerations.size()) {
+            return true;
+        }
+        for (size_t i = 0; i < tensors.size(); i++) {
+            if (tensors[i]->generation() != this->mTensorGenerations[i]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+  private:
+    std::vector<uint64_t> mTensorGenerations;
 };
 
 } // End namespace kp
@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/Core.hpp"
+
+#include "kompute/HazardTracker.hpp"
+
+#include "kompute/operations/OpBase.hpp"
+
+namespace kp {
+
+/**
+ * Operation that records a group of operations once into a secondary command
+ * buffer, which every sequence that records the block then executes through
+ * vkCmdExecuteCommands instead of recording the operations again. This is
+ * useful for sub-sequences that are shared by many sequences, such as a sync
+ * of the inputs followed by a dispatch or the operations of a layer of a
+ * model, as recording a block into a sequence only records one command.
+ *
+ * The barriers between the operations of the block are recorded into the
+ * secondary command buffer from the accesses that the operations declare,
+ * and the block declares the accesses of all its operations so the sequences
+ * synchronise it with the operations around it. The secondary command buffer
+ * can be executed by several sequences in flight at the same time. When the
+ * resources of its operations change, such as when tensors are rebuilt, the
+ * block is recorded again by the next sequence that records it, which must
+ * not happen while any sequence that executes the block is running. This
+ * changes the record version of the block, so the other sequences that
+ * execute it are recorded again when these are next evaluated.
+ */
+class OpBlock : public OpBase
+{
+  public:
+    /**
+     * Constructor that creates the secondary command buffer and records the
+     * operations provided into it.
+     *
+     * @param device Vulkan logical device
+     * @param queueIndex Vulkan compute queue family index of the sequences
+     * that execute the block
+     * @param operations The operations to record into the block, in order
+     */
+    OpBlock(std::shared_ptr<vk::Device> device,
+            uint32_t queueIndex,
+            const std::vector<std::shared_ptr<OpBase>>& operations);
+
+    /**
+     * Destructor which frees the command buffer and command pool of the
+     * block, unless these have been freed already through destroy.
+     */
+    ~OpBlock() override;
+
+    /**
+     * Declares the accesses of all the operations of the block in order.
+     *
+     * @param accesses The vector to add the accesses of the operation to
+     * @return Boolean stating whether all the operations of the block declare
+     * their accesses
+     */
+    bool declareAccesses(std::vector<TensorAccess>& accesses) override;
+
+    /**
+     * Records the execution of the secondary command buffer of the block,
+     * which is recorded again first if any of the operations of the block
+     * requires it.
+     *
+     * @param commandBuffer The command buffer to record the command into.
+     */
+    void record(const vk::CommandBuffer& commandBuffer) override;
+
+    /**
+     * Whether any of the operations of the block has to be recorded again.
+     *
+     * @return Boolean stating whether the operation has to be recorded again
+     */
+    bool requiresRerecord() override;
+
+    /**
+     * Version of the secondary command buffer, which is incremented each time
+     * the operations of the block are recorded into it.
+     *
+     * @return The number of times the block has been recorded
+     */
+    uint64_t recordVersion() override;
+
+    /**
+     * Calls the preEval of all the operations of the block with the
+     * secondary command buffer they were recorded into, so the state these
+     * keep per command buffer, such as staging ring slices, is shared by all
+     * the submissions that execute the block.
+     *
+     * @param commandBuffer The command buffer that is being submitted.
+     */
+    virtual void preEval(const vk::CommandBuffer& commandBuffer) override;
+
+    /**
+     * Calls the postEval of all the operations of the block with the
+     * secondary command buffer they were recorded into.
+     *
+     * @param commandBuffer The command buffer that finished executing.
+     */
+    virtual void postEval(const vk::CommandBuffer& commandBuffer) override;
+
+    /**
+     * Records the operations of the block into its secondary command buffer
+     * again, which must not be done while a sequence that executes the block
+     * is running. The sequences that execute the block are recorded again
+     * when these are next evaluated.
+     */
+    void rerecord();
+
+    /**
+     * Returns true if the block has been initialised, and it's based on the
+     * GPU resources being referenced.
+     *
+     * @return Boolean stating if is initialized
+     */
+    bool isInit() const;
+
+    /**
+     * Destroys and frees the GPU resources of the block, which are the
+     * secondary command buffer and its command pool.
+     */
+    void destroy();
+
+  private:
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<vk::Device> mDevice = nullptr;
+    uint32_t mQueueIndex = -1;
+
+    // -------------- OPTIONALLY OWNED RESOURCES
+    std::shared_ptr<vk::CommandPool> mCommandPool = nullptr;
+    bool mFreeCommandPool = false;
+    std::shared_ptr<vk::CommandBuffer> mCommandBuffer = nullptr;
+    bool mFreeCommandBuffer = false;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    std::vector<std::shared_ptr<OpBase>> mOperations;
+    HazardTracker mHazardTracker;
+    uint64_t mRecordVersion = 0;
+
+    // Create functions
+    void createCommandPool();
+    void createCommandBuffer();
+};
+
+} // End namespace kp
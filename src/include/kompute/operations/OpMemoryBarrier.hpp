@@ -33,13 +33,17 @@ class OpMemoryBarrier : public OpBase
      * stage mask
      * @param barrierOnPrimary Boolean to select primary or secondary buffers on
      * tensors
+     * @param globalBarrier Boolean to record a single global memory barrier,
+     * which covers the memory of all the tensors, instead of a buffer memory
+     * barrier for each tensor, which is cheaper when there are many tensors
      */
     OpMemoryBarrier(const std::vector<std::shared_ptr<Tensor>>& tensors,
                     const vk::AccessFlagBits& srcAccessMask,
                     const vk::AccessFlagBits& dstAccessMask,
                     const vk::PipelineStageFlagBits& srcStageMask,
                     const vk::PipelineStageFlagBits& dstStageMask,
-                    bool barrierOnPrimary = true);
+                    bool barrierOnPrimary = true,
+                    bool globalBarrier = false);
 
     /**
      * Default destructor, which is in charge of destroying the reference to the
@@ -49,12 +53,19 @@ class OpMemoryBarrier : public OpBase
 
     /**
      * This records the memory barrier with the access and stage masks provided
-     * across all relevant tensors.
+     * across all relevant tensors, as a single pipeline barrier.
      *
      * @param commandBuffer The command buffer to record the command into.
      */
     virtual void record(const vk::CommandBuffer& commandBuffer) override;
 
+    /**
+     * Whether any of the tensors has been rebuilt since it was recorded.
+     *
+     * @return Boolean stating whether the operation has to be recorded again
+     */
+    bool requiresRerecord() override;
+
     /**
      * Does not perform any preEval commands.
      *
@@ -75,6 +86,7 @@ class OpMemoryBarrier : public OpBase
     const vk::PipelineStageFlagBits mSrcStageMask;
     const vk::PipelineStageFlagBits mDstStageMask;
     const bool mBarrierOnPrimary;
+    const bool mGlobalBarrier;
     const std::vector<std::shared_ptr<Tensor>> mTensors;
 };
 
@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <functional>
+
+#include "kompute/Core.hpp"
+
+#include "kompute/HazardTracker.hpp"
+
+#include "kompute/operations/OpBase.hpp"
+
+namespace kp {
+
+/**
+ * Operation that records a body of operations several times in a row, so
+ * iterative workloads such as training loops run all their iterations in a
+ * single submission instead of one eval per iteration. The barriers between
+ * the operations of the body and between consecutive iterations are recorded
+ * from the accesses that the operations declare, in the same way as the
+ * Sequence does for the operations recorded into it.
+ *
+ * The operations of the body are recorded once per iteration, so operations
+ * that reserve resources when recorded, such as sync operations of tensors
+ * that use the staging ring, have to be recorded outside of the body. The
+ * preEval and postEval of the operations are called once per eval.
+ */
+class OpRepeat : public OpBase
+{
+  public:
+    /**
+     * Constructor with the body of operations to repeat and the number of
+     * iterations.
+     *
+     * @param operations The operations to record in each iteration, in order
+     * @param iterations The number of times the operations are recorded
+     * @param iterationCallback Optional function called with the index of the
+     * iteration before the operations of the iteration are recorded, which
+     * can be used to expose the index to the shaders through the push
+     * constants of the algorithms of the body
+     */
+    OpRepeat(const std::vector<std::shared_ptr<OpBase>>& operations,
+             uint32_t iterations,
+             const std::function<void(uint32_t)>& iterationCallback = nullptr);
+
+    /**
+     * Default destructor. This class does not manage memory so it won't be
+     * expecting the parent to perform a release.
+     */
+    ~OpRepeat() override;
+
+    /**
+     * Declares the accesses of all the operations of the body in order, so
+     * the Sequence synchronises the first iteration with the previous
+     * operations and the following operations with the last iteration.
+     *
+     * @param accesses The vector to add the accesses of the operation to
+     * @return Boolean stating whether all the operations of the body declare
+     * their accesses
+     */
+    bool declareAccesses(std::vector<TensorAccess>& accesses) override;
+
+    /**
+     * Records the operations of the body for each of the iterations, along
+     * with the barriers required between these.
+     *
+     * @param commandBuffer The command buffer to record the command into.
+     */
+    void record(const vk::CommandBuffer& commandBuffer) override;
+
+    /**
+     * Whether any of the operations of the body has to be recorded again.
+     *
+     * @return Boolean stating whether the operation has to be recorded again
+     */
+    bool requiresRerecord() override;
+
+    /**
+     * Combined record version of the operations of the body, which changes
+     * whenever the version of any of them changes.
+     *
+     * @return The version of the commands shared by the operations of the body
+     */
+    uint64_t recordVersion() override;
+
+    /**
+     * Calls the preEval of all the operations of the body.
+     *
+     * @param commandBuffer The command buffer to record the command into.
+     */
+    virtual void preEval(const vk::CommandBuffer& commandBuffer) override;
+
+    /**
+     * Calls the postEval of all the operations of the body.
+     *
+     * @param commandBuffer The command buffer to record the command into.
+     */
+    virtual void postEval(const vk::CommandBuffer& commandBuffer) override;
+
+  private:
+    // -------------- ALWAYS OWNED RESOURCES
+    std::vector<std::shared_ptr<OpBase>> mOperations;
+    uint32_t mIterations;
+    std::function<void(uint32_t)> mIterationCallback;
+    HazardTracker mHazardTracker;
+};
+
+} // End namespace kp
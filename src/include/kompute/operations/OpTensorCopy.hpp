@@ -32,6 +32,15 @@ class OpTensorCopy : public OpBase
      */
     ~OpTensorCopy() override;
 
+    /**
+     * Declares the transfer read of the first tensor and the transfer writes
+     * of all the other tensors.
+     *
+     * @param accesses The vector to add the accesses of the operation to
+     * @return Boolean stating whether the operation declares its accesses
+     */
+    bool declareAccesses(std::vector<TensorAccess>& accesses) override;
+
     /**
      * Records the copy commands from the first tensor into all the other
      * tensors provided. Also optionally records a barrier.
@@ -40,6 +49,13 @@ class OpTensorCopy : public OpBase
      */
     void record(const vk::CommandBuffer& commandBuffer) override;
 
+    /**
+     * Whether any of the tensors has been rebuilt since it was recorded.
+     *
+     * @return Boolean stating whether the operation has to be recorded again
+     */
+    bool requiresRerecord() override;
+
     /**
      * Does not perform any preEval commands.
      *
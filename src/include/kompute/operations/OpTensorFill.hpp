@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/Core.hpp"
+
+#include "kompute/Tensor.hpp"
+
+#include "kompute/operations/OpBase.hpp"
+
+namespace kp {
+
+/**
+ * Operation that fills the device memory of the tensors provided with a 32-bit
+ * value using vkCmdFillBuffer, which allows output tensors to be created
+ * uninitialised and cleared on the device instead of uploading host data. The
+ * host data of the tensors is set to the same value when the sequence is
+ * submitted, so operations later in the sequence that sync the tensors back
+ * to the host keep their results. This operation does not own/manage the
+ * memory of the tensors passed to it.
+ */
+class OpTensorFill : public OpBase
+{
+  public:
+    /**
+     * Default constructor with parameters that provides the tensors that will
+     * be filled and the value to fill them with.
+     *
+     * @param tensors Tensors that will be filled by the operation.
+     * @param value The 32-bit pattern to fill the tensors with, which by
+     * default clears the tensors to zero.
+     */
+    OpTensorFill(const std::vector<std::shared_ptr<Tensor>>& tensors,
+                 uint32_t value = 0);
+
+    /**
+     * Default destructor. This class does not manage memory so it won't be
+     * expecting the parent to perform a release.
+     */
+    ~OpTensorFill() override;
+
+    /**
+     * Declares the transfer writes of the fill commands.
+     *
+     * @param accesses The vector to add the accesses of the operation to
+     * @return Boolean stating whether the operation declares its accesses
+     */
+    bool declareAccesses(std::vector<TensorAccess>& accesses) override;
+
+    /**
+     * Records the fill commands for all the tensors.
+     *
+     * @param commandBuffer The command buffer to record the command into.
+     */
+    void record(const vk::CommandBuffer& commandBuffer) override;
+
+    /**
+     * Whether any of the tensors has been rebuilt since it was recorded.
+     *
+     * @return Boolean stating whether the operation has to be recorded again
+     */
+    bool requiresRerecord() override;
+
+    /**
+     * Fills the host data of the device tensors with the same value, so it
+     * matches the device memory once the fill commands have run.
+     *
+     * @param commandBuffer The command buffer to record the command into.
+     */
+    virtual void preEval(const vk::CommandBuffer& commandBuffer) override;
+
+    /**
+     * Does not perform any postEval commands.
+     *
+     * @param commandBuffer The command buffer to record the command into.
+     */
+    virtual void postEval(const vk::CommandBuffer& commandBuffer) override;
+
+  private:
+    // -------------- ALWAYS OWNED RESOURCES
+    std::vector<std::shared_ptr<Tensor>> mTensors;
+    uint32_t mValue;
+};
+
+} // End namespace kp
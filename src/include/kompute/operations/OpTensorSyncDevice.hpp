@@ -27,24 +27,74 @@ class OpTensorSyncDevice : public OpBase
      */
     OpTensorSyncDevice(const std::vector<std::shared_ptr<Tensor>>& tensors);
 
+    /**
+     * Constructor that restricts the sync to the element ranges provided,
+     * which are applied to each of the tensors. Only the bytes within the
+     * ranges are copied, and barriers are sized to match.
+     *
+     * @param tensors Tensors that will be used to create in operation.
+     * @param ranges Element ranges to sync, which must be within the bounds
+     * of all the tensors provided.
+     */
+    OpTensorSyncDevice(const std::vector<std::shared_ptr<Tensor>>& tensors,
+                       const std::vector<TensorRange>& ranges);
+
+    /**
+     * Constructor that allows for only the dirty ranges of each tensor to be
+     * synced. The dirty ranges are captured when the operation is recorded,
+     * and tensors without dirty ranges are skipped entirely. When the dirty
+     * ranges have changed by the time a recorded sequence is evaluated again,
+     * the sequence records the operation again to copy the new ranges.
+     *
+     * @param tensors Tensors that will be used to create in operation.
+     * @param syncDirtyOnly Whether to only sync the dirty ranges of tensors
+     */
+    OpTensorSyncDevice(const std::vector<std::shared_ptr<Tensor>>& tensors,
+                       bool syncDirtyOnly);
+
     /**
      * Default destructor. This class does not manage memory so it won't be
      * expecting the parent to perform a release.
      */
     ~OpTensorSyncDevice() override;
 
+    /**
+     * Declares the transfer writes into the device tensors that are copied
+     * from their staging memory.
+     *
+     * @param accesses The vector to add the accesses of the operation to
+     * @return Boolean stating whether the operation declares its accesses
+     */
+    bool declareAccesses(std::vector<TensorAccess>& accesses) override;
+
     /**
      * For device tensors, it records the copy command for the tensor to copy
-     * the data from its staging to device memory.
+     * the data from its staging to device memory. Tensors that use a staging
+     * ring reserve a slice of the ring for the command buffer provided, which
+     * is held until the operation is recorded again into the same command
+     * buffer or destroyed, so command buffers that are pending at the same
+     * time do not share slices.
      *
      * @param commandBuffer The command buffer to record the command into.
      */
     void record(const vk::CommandBuffer& commandBuffer) override;
 
     /**
-     * Does not perform any preEval commands.
+     * Whether any of the tensors has been rebuilt since it was recorded, or
+     * when only syncing dirty ranges, whether the dirty ranges of the device
+     * tensors differ from the ones that were recorded.
      *
-     * @param commandBuffer The command buffer to record the command into.
+     * @return Boolean stating whether the operation has to be recorded again
+     */
+    bool requiresRerecord() override;
+
+    /**
+     * Copies the host data of the tensors that use a staging ring into the
+     * slices of the command buffer being submitted, clears the dirty ranges
+     * that are synced by the recorded commands, and updates the uploaded and
+     * skipped byte counters of the tensors.
+     *
+     * @param commandBuffer The command buffer that is being submitted.
      */
     virtual void preEval(const vk::CommandBuffer& commandBuffer) override;
 
@@ -58,6 +108,15 @@ class OpTensorSyncDevice : public OpBase
   private:
     // -------------- ALWAYS OWNED RESOURCES
     std::vector<std::shared_ptr<Tensor>> mTensors;
+    std::vector<TensorRange> mRanges;
+    bool mSyncDirtyOnly = false;
+    // Ranges recorded for each of the tensors, empty when skipped
+    std::vector<std::vector<TensorRange>> mRecordedRanges;
+    // Staging ring slices for each of the tensors in each of the command
+    // buffers recorded into, null when not used
+    std::map<vk::CommandBuffer,
+             std::vector<std::shared_ptr<StagingRing::Slice>>>
+      mStagingSlices;
 };
 
 } // End namespace kp
@@ -29,20 +29,51 @@ class OpTensorSyncLocal : public OpBase
      */
     OpTensorSyncLocal(const std::vector<std::shared_ptr<Tensor>>& tensors);
 
+    /**
+     * Constructor that restricts the sync to the element ranges provided,
+     * which are applied to each of the tensors. Only the bytes within the
+     * ranges are copied, and barriers are sized to match.
+     *
+     * @param tensors Tensors that will be used to create in operation.
+     * @param ranges Element ranges to sync, which must be within the bounds
+     * of all the tensors provided.
+     */
+    OpTensorSyncLocal(const std::vector<std::shared_ptr<Tensor>>& tensors,
+                      const std::vector<TensorRange>& ranges);
+
     /**
      * Default destructor. This class does not manage memory so it won't be
      * expecting the parent to perform a release.
      */
     ~OpTensorSyncLocal() override;
 
+    /**
+     * Declares the transfer reads of the device tensors that are copied into
+     * their staging memory.
+     *
+     * @param accesses The vector to add the accesses of the operation to
+     * @return Boolean stating whether the operation declares its accesses
+     */
+    bool declareAccesses(std::vector<TensorAccess>& accesses) override;
+
     /**
      * For device tensors, it records the copy command for the tensor to copy
-     * the data from its device to staging memory.
+     * the data from its device to staging memory. Tensors that use a staging
+     * ring reserve a slice of the ring for the command buffer provided, which
+     * is held until the operation is recorded again into the same command
+     * buffer or destroyed.
      *
      * @param commandBuffer The command buffer to record the command into.
      */
     void record(const vk::CommandBuffer& commandBuffer) override;
 
+    /**
+     * Whether any of the tensors has been rebuilt since it was recorded.
+     *
+     * @return Boolean stating whether the operation has to be recorded again
+     */
+    bool requiresRerecord() override;
+
     /**
      * Does not perform any preEval commands.
      *
@@ -52,15 +83,22 @@ class OpTensorSyncLocal : public OpBase
 
     /**
      * For host tensors it performs the map command from the host memory into
-     * local memory.
+     * local memory, and for tensors that use a staging ring it copies the
+     * data from the slices of the command buffer that finished executing.
      *
-     * @param commandBuffer The command buffer to record the command into.
+     * @param commandBuffer The command buffer that finished executing.
      */
     virtual void postEval(const vk::CommandBuffer& commandBuffer) override;
 
   private:
     // -------------- ALWAYS OWNED RESOURCES
     std::vector<std::shared_ptr<Tensor>> mTensors;
+    std::vector<TensorRange> mRanges;
+    // Staging ring slices for each of the tensors in each of the command
+    // buffers recorded into, null when not used
+    std::map<vk::CommandBuffer,
+             std::vector<std::shared_ptr<StagingRing::Slice>>>
+      mStagingSlices;
 };
 
 } // End namespace kp
@@ -0,0 +1,287 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <chrono>
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+static const std::string MULTIPLY_SHADER(R"(
+    #version 450
+
+    layout (local_size_x = 1) in;
+
+    layout(set = 0, binding = 0) buffer bina { float tina[]; };
+    layout(set = 0, binding = 1) buffer binb { float tinb[]; };
+    layout(set = 0, binding = 2) buffer bout { float tout[]; };
+
+    void main() {
+        uint index = gl_GlobalInvocationID.x;
+        tout[index] = tina[index] * tinb[index];
+    }
+)");
+
+TEST(TestAlgorithm, SetTensorsRewritesDescriptorSet)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 2, 2, 2 });
+    std::shared_ptr<kp::TensorT<float>> tensorC = mgr.tensor({ 3, 3, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorOutA = mgr.emptyTensor(3);
+    std::shared_ptr<kp::TensorT<float>> tensorOutB = mgr.emptyTensor(3);
+
+    std::shared_ptr<kp::Algorithm> algo = mgr.algorithm(
+      { tensorA, tensorB, tensorOutA }, compileSource(MULTIPLY_SHADER));
+
+    std::shared_ptr<kp::Sequence> sq = mgr.sequence();
+    sq->record<kp::OpTensorSyncDevice>({ tensorA, tensorB, tensorC })
+      ->record<kp::OpAlgoDispatch>(algo)
+      ->record<kp::OpTensorSyncLocal>({ tensorOutA })
+      ->eval();
+    EXPECT_EQ(tensorOutA->vector(), std::vector<float>({ 2, 4, 6 }));
+
+    algo->setTensors({ tensorA, tensorC, tensorOutB });
+    EXPECT_EQ(algo->getTensors()[2], tensorOutB);
+
+    sq->record<kp::OpAlgoDispatch>(algo)
+      ->record<kp::OpTensorSyncLocal>({ tensorOutB })
+      ->eval();
+    EXPECT_EQ(tensorOutB->vector(), std::vector<float>({ 3, 6, 9 }));
+}
+
+TEST(TestAlgorithm, SetTensorsWhileSubmissionRunning)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::DescriptorAllocator> allocator =
+      mgr.getDescriptorAllocator();
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 2, 2, 2 });
+    std::shared_ptr<kp::TensorT<float>> tensorC = mgr.tensor({ 3, 3, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorOutA = mgr.emptyTensor(3);
+    std::shared_ptr<kp::TensorT<float>> tensorOutB = mgr.emptyTensor(3);
+
+    std::shared_ptr<kp::Algorithm> algo = mgr.algorithm(
+      { tensorA, tensorB, tensorOutA }, compileSource(MULTIPLY_SHADER));
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()
+        ->record<kp::OpTensorSyncDevice>({ tensorA, tensorB, tensorC })
+        ->record<kp::OpAlgoDispatch>(algo)
+        ->record<kp::OpTensorSyncLocal>({ tensorOutA, tensorOutB })
+        ->evalAsync();
+
+    // The running submission keeps the current set, which is only recycled
+    // once it completes
+    algo->setTensors({ tensorA, tensorC, tensorOutB });
+    EXPECT_EQ(allocator->availableSetCount(), 0);
+    EXPECT_ANY_THROW(algo->setTensors({ tensorA, tensorB }));
+
+    sq->evalAwait();
+    EXPECT_EQ(tensorOutA->vector(), std::vector<float>({ 2, 4, 6 }));
+    EXPECT_EQ(allocator->availableSetCount(), 1);
+
+    sq->eval();
+    EXPECT_EQ(tensorOutB->vector(), std::vector<float>({ 3, 6, 9 }));
+}
+
+TEST(TestAlgorithm, SetTensorsWithOtherBindings)
+{
+    std::string shader(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) buffer a { float pa[]; };
+      void main() {
+          uint index = gl_GlobalInvocationID.x;
+          pa[index] = pa[index] + 1.0;
+      })");
+
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 0, 0, 0 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 5, 5, 5 });
+    std::shared_ptr<kp::TensorT<float>> tensorC = mgr.tensor({ 7, 7, 7 });
+
+    std::shared_ptr<kp::Algorithm> algo =
+      mgr.algorithm({ tensorA }, compileSource(shader));
+
+    // The extra binding is not used by the shader but changes the layout
+    algo->setTensors({ tensorB, tensorC });
+    EXPECT_TRUE(algo->isInit());
+
+    mgr.sequence()
+      ->record<kp::OpTensorSyncDevice>({ tensorA, tensorB, tensorC })
+      ->record<kp::OpAlgoDispatch>(algo)
+      ->record<kp::OpTensorSyncLocal>({ tensorA, tensorB, tensorC })
+      ->eval();
+
+    EXPECT_EQ(tensorA->vector(), std::vector<float>({ 0, 0, 0 }));
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 6, 6, 6 }));
+    EXPECT_EQ(tensorC->vector(), std::vector<float>({ 7, 7, 7 }));
+}
+
+TEST(TestAlgorithm, BenchmarkSetTensorsAgainstRebuild)
+{
+    uint32_t iterations = 100;
+
+    kp::Manager mgr;
+
+    std::vector<std::shared_ptr<kp::Tensor>> tensorsA = {
+        mgr.tensor({ 1, 2, 3 }), mgr.tensor({ 2, 2, 2 }), mgr.emptyTensor(3)
+    };
+    std::vector<std::shared_ptr<kp::Tensor>> tensorsB = {
+        mgr.tensor({ 4, 5, 6 }), mgr.tensor({ 3, 3, 3 }), mgr.emptyTensor(3)
+    };
+    std::vector<uint32_t> spirv = compileSource(MULTIPLY_SHADER);
+
+    std::shared_ptr<kp::Algorithm> algo = mgr.algorithm(tensorsA, spirv);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        algo->rebuild(i % 2 ? tensorsA : tensorsB, spirv);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    int64_t rebuildDuration =
+      std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+        .count();
+
+    start = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        algo->setTensors(i % 2 ? tensorsA : tensorsB);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    int64_t setTensorsDuration =
+      std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+        .count();
+
+    KP_LOG_INFO("Swapping tensors {} times: rebuild {} us, setTensors {} us",
+                iterations,
+                rebuildDuration,
+                setTensorsDuration);
+
+    algo->setTensors(tensorsB);
+
+    mgr.sequence()
+      ->record<kp::OpTensorSyncDevice>(tensorsB)
+      ->record<kp::OpAlgoDispatch>(algo)
+      ->record<kp::OpTensorSyncLocal>({ tensorsB[2] })
+      ->eval();
+    EXPECT_EQ(std::dynamic_pointer_cast<kp::TensorT<float>>(tensorsB[2])
+                ->vector(),
+              std::vector<float>({ 12, 15, 18 }));
+}
+
+static const std::string SPECIALIZED_SHADER(R"(
+    #version 450
+
+    layout (constant_id = 0) const float increment = 0;
+
+    layout (local_size_x = 1) in;
+
+    layout(set = 0, binding = 0) buffer a { float pa[]; };
+
+    void main() {
+        uint index = gl_GlobalInvocationID.x;
+        pa[index] = pa[index] + increment;
+    }
+)");
+
+TEST(TestAlgorithm, AsyncBuildAwaitedWhenRecorded)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 0, 0, 0 });
+    std::vector<uint32_t> spirv = compileSource(SPECIALIZED_SHADER);
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()->record<kp::OpTensorSyncDevice>({ tensor });
+    for (uint32_t i = 1; i <= 10; i++) {
+        sq->record<kp::OpAlgoDispatch>(mgr.algorithmAsync<float, float>(
+          { tensor }, spirv, kp::Workgroup(), { (float)i }));
+    }
+    sq->record<kp::OpTensorSyncLocal>({ tensor })->eval();
+
+    EXPECT_EQ(tensor->vector(), std::vector<float>({ 55, 55, 55 }));
+}
+
+TEST(TestAlgorithm, AsyncBuildAwaitedExplicitly)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 0, 0, 0 });
+
+    std::shared_ptr<kp::Algorithm> algo = mgr.algorithmAsync<float, float>(
+      { tensor }, compileSource(SPECIALIZED_SHADER), kp::Workgroup(), { 2 });
+    algo->wait();
+    EXPECT_TRUE(algo->isBuilt());
+    EXPECT_TRUE(algo->isInit());
+
+    // Rebuilding waits for the previous build
+    algo->rebuildAsync<float, float>(mgr.getWorkerPool(),
+                                     { tensor },
+                                     compileSource(SPECIALIZED_SHADER),
+                                     kp::Workgroup(),
+                                     { 3 });
+    algo->rebuild<float, float>(
+      { tensor }, compileSource(SPECIALIZED_SHADER), kp::Workgroup(), { 4 });
+    EXPECT_TRUE(algo->isBuilt());
+
+    mgr.sequence()
+      ->record<kp::OpTensorSyncDevice>({ tensor })
+      ->record<kp::OpAlgoDispatch>(algo)
+      ->record<kp::OpTensorSyncLocal>({ tensor })
+      ->eval();
+
+    EXPECT_EQ(tensor->vector(), std::vector<float>({ 4, 4, 4 }));
+}
+
+// Builds the algorithms on a new manager so no pipeline is cached, returning
+// the time taken in microseconds
+static int64_t
+buildAlgorithms(const std::vector<uint32_t>& spirv,
+                uint32_t algorithmCount,
+                bool async)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 0, 0, 0 });
+    std::vector<std::shared_ptr<kp::Algorithm>> algorithms;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < algorithmCount; i++) {
+        if (async) {
+            algorithms.push_back(mgr.algorithmAsync<float, float>(
+              { tensor }, spirv, kp::Workgroup(), { (float)i }));
+        } else {
+            algorithms.push_back(mgr.algorithm<float, float>(
+              { tensor }, spirv, kp::Workgroup(), { (float)i }, {}));
+        }
+    }
+    for (const std::shared_ptr<kp::Algorithm>& algorithm : algorithms) {
+        algorithm->wait();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+      .count();
+}
+
+TEST(TestAlgorithm, BenchmarkParallelPipelineBuilds)
+{
+    uint32_t algorithmCount = 50;
+
+    std::vector<uint32_t> spirv = compileSource(SPECIALIZED_SHADER);
+
+    int64_t serialDuration = buildAlgorithms(spirv, algorithmCount, false);
+    int64_t asyncDuration = buildAlgorithms(spirv, algorithmCount, true);
+
+    KP_LOG_INFO("Building {} algorithms: serial {} us, async {} us",
+                algorithmCount,
+                serialDuration,
+                asyncDuration);
+}
@@ -259,3 +259,120 @@ TEST(TestAsyncOperations, TestManagerAsyncExecutionTimeout)
     EXPECT_EQ(tensorA->vector(), resultAsync);
     EXPECT_EQ(tensorB->vector(), resultAsync);
 }
+
+TEST(TestAsyncOperations, TestSequencePipelinedSubmissions)
+{
+    std::string shader(R"(
+        #version 450
+
+        layout (local_size_x = 1) in;
+
+        layout(set = 0, binding = 0) buffer b { float pb[]; };
+
+        void main() {
+            uint index = gl_GlobalInvocationID.x;
+            pb[index] = pb[index] + 1.0;
+        }
+    )");
+
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor =
+      mgr.tensor(std::vector<float>(16, 0));
+
+    std::shared_ptr<kp::Algorithm> algo =
+      mgr.algorithm({ tensor }, compileSource(shader));
+
+    mgr.sequence()->eval<kp::OpTensorSyncDevice>({ tensor });
+
+    std::shared_ptr<kp::Sequence> sq = mgr.sequence();
+    sq->setMaxInFlight(3);
+    sq->record<kp::OpAlgoDispatch>(algo);
+
+    for (uint32_t i = 0; i < 10; i++) {
+        EXPECT_NO_THROW(sq->evalAsync());
+        EXPECT_LE(sq->inFlightCount(), 3);
+    }
+    EXPECT_TRUE(sq->isRunning());
+
+    sq->evalAwait();
+    EXPECT_EQ(sq->inFlightCount(), 0);
+
+    // Only as many fences as submissions in flight are created
+    EXPECT_LE(mgr.getSyncPool()->fenceCount(), 3);
+
+    mgr.sequence()->eval<kp::OpTensorSyncLocal>({ tensor });
+
+    // Submissions of the same sequence do not overlap
+    EXPECT_EQ(tensor->vector(), std::vector<float>(16, 10));
+
+    // Without pipelining the sequence cannot be submitted while running
+    sq->setMaxInFlight(1);
+    sq->evalAsync();
+    EXPECT_ANY_THROW(sq->evalAsync());
+    sq->evalAwait();
+}
+
+TEST(TestAsyncOperations, TestSequencePipelinedCommandBuffers)
+{
+    std::string shader(R"(
+        #version 450
+
+        layout (local_size_x = 1) in;
+
+        layout(set = 0, binding = 0) buffer a { float pa[]; };
+        layout(set = 0, binding = 1) buffer b { float pb[]; };
+
+        void main() {
+            uint index = gl_GlobalInvocationID.x;
+            pb[index] = pb[index] + pa[index];
+        }
+    )");
+
+    kp::Manager mgr;
+
+    // The host data of staging ring tensors is copied when submitted
+    mgr.setUnifiedMemory(false);
+    mgr.enableStagingRing(1024 * 1024);
+
+    std::shared_ptr<kp::TensorT<float>> tensorIn =
+      mgr.tensor(std::vector<float>(16, 0));
+    std::shared_ptr<kp::TensorT<float>> tensorOut =
+      mgr.tensor(std::vector<float>(16, 0));
+
+    std::shared_ptr<kp::Algorithm> algo =
+      mgr.algorithm({ tensorIn, tensorOut }, compileSource(shader));
+
+    mgr.sequence()->eval<kp::OpTensorSyncDevice>({ tensorOut });
+
+    std::shared_ptr<kp::Sequence> sq = mgr.sequence();
+    sq->setMaxInFlight(3);
+    sq->record<kp::OpTensorSyncDevice>({ tensorIn })
+      ->record<kp::OpAlgoDispatch>(algo);
+
+    for (uint32_t i = 1; i <= 3; i++) {
+        tensorIn->setData(std::vector<float>(16, i));
+        sq->evalAsync();
+    }
+
+    // Each submission in flight uploads from the slice of its command buffer
+    EXPECT_EQ(mgr.getStagingRing()->usedSize(), 3 * 16 * sizeof(float));
+    sq->evalAwait();
+
+    mgr.sequence()->eval<kp::OpTensorSyncLocal>({ tensorOut });
+    EXPECT_EQ(tensorOut->vector(), std::vector<float>(16, 6));
+
+    // The command buffers of the ring are recorded again after a new
+    // recording, and the ones no longer used are freed
+    sq->clear();
+    sq->record<kp::OpTensorSyncDevice>({ tensorIn })
+      ->record<kp::OpAlgoDispatch>(algo);
+    sq->setMaxInFlight(2);
+    for (uint32_t i = 0; i < 4; i++) {
+        sq->evalAsync();
+    }
+    sq->evalAwait();
+
+    mgr.sequence()->eval<kp::OpTensorSyncLocal>({ tensorOut });
+    EXPECT_EQ(tensorOut->vector(), std::vector<float>(16, 18));
+}
@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+TEST(TestBarrierBuilder, BarriersAreGroupedByStageMasks)
+{
+    kp::BarrierBuilder barrierBuilder;
+    EXPECT_TRUE(barrierBuilder.empty());
+
+    barrierBuilder
+      .addBufferMemoryBarrier(vk::PipelineStageFlagBits::eTransfer,
+                              vk::PipelineStageFlagBits::eComputeShader,
+                              vk::BufferMemoryBarrier())
+      .addBufferMemoryBarrier(vk::PipelineStageFlagBits::eComputeShader,
+                              vk::PipelineStageFlagBits::eTransfer,
+                              vk::BufferMemoryBarrier())
+      .addBufferMemoryBarrier(vk::PipelineStageFlagBits::eTransfer,
+                              vk::PipelineStageFlagBits::eComputeShader,
+                              vk::BufferMemoryBarrier())
+      .addMemoryBarrier(vk::PipelineStageFlagBits::eComputeShader,
+                        vk::PipelineStageFlagBits::eTransfer,
+                        vk::MemoryBarrier());
+
+    EXPECT_FALSE(barrierBuilder.empty());
+    EXPECT_EQ(barrierBuilder.pipelineBarrierCount(), 2);
+    EXPECT_EQ(barrierBuilder.bufferMemoryBarrierCount(), 3);
+
+    barrierBuilder.clear();
+    EXPECT_TRUE(barrierBuilder.empty());
+    EXPECT_EQ(barrierBuilder.pipelineBarrierCount(), 0);
+}
+
+TEST(TestBarrierBuilder, TensorBarriersShareOnePipelineBarrier)
+{
+    kp::Manager mgr;
+
+    kp::BarrierBuilder barrierBuilder;
+    for (uint32_t i = 0; i < 9; i++) {
+        mgr.tensor({ 1, 2, 3 })->addPrimaryBufferMemoryBarrier(
+          barrierBuilder,
+          vk::AccessFlagBits::eShaderWrite,
+          vk::AccessFlagBits::eShaderRead,
+          vk::PipelineStageFlagBits::eComputeShader,
+          vk::PipelineStageFlagBits::eComputeShader);
+    }
+
+    EXPECT_EQ(barrierBuilder.pipelineBarrierCount(), 1);
+    EXPECT_EQ(barrierBuilder.bufferMemoryBarrierCount(), 9);
+}
+
+TEST(TestBarrierBuilder, OpMemoryBarrierGlobalBarrier)
+{
+    kp::Manager mgr;
+
+    std::vector<std::shared_ptr<kp::Tensor>> tensors;
+    for (uint32_t i = 0; i < 9; i++) {
+        tensors.push_back(mgr.tensor({ 0, 0, 0 }));
+    }
+
+    std::string shader(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) buffer a { float pa[]; };
+      void main() {
+          uint index = gl_GlobalInvocationID.x;
+          pa[index] = pa[index] + 1;
+      })");
+
+    std::vector<uint32_t> spirv = compileSource(shader);
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()->record<kp::OpTensorSyncDevice>(tensors);
+    for (const std::shared_ptr<kp::Tensor>& tensor : tensors) {
+        sq->record<kp::OpAlgoDispatch>(mgr.algorithm({ tensor }, spirv));
+    }
+    sq->record<kp::OpMemoryBarrier>(tensors,
+                                    vk::AccessFlagBits::eShaderWrite,
+                                    vk::AccessFlagBits::eShaderRead,
+                                    vk::PipelineStageFlagBits::eComputeShader,
+                                    vk::PipelineStageFlagBits::eComputeShader,
+                                    true,
+                                    true);
+    for (const std::shared_ptr<kp::Tensor>& tensor : tensors) {
+        sq->record<kp::OpAlgoDispatch>(mgr.algorithm({ tensor }, spirv));
+    }
+    sq->record<kp::OpTensorSyncLocal>(tensors)->eval();
+
+    for (const std::shared_ptr<kp::Tensor>& tensor : tensors) {
+        EXPECT_EQ(tensor->vector<float>(), std::vector<float>({ 2, 2, 2 }));
+    }
+}
@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <chrono>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+static const std::string INCREMENT_SHADER(R"(
+    #version 450
+
+    layout (local_size_x = 1) in;
+
+    layout(set = 0, binding = 0) buffer a { float pa[]; };
+
+    void main() {
+        uint index = gl_GlobalInvocationID.x;
+        pa[index] = pa[index] + 1.0;
+    }
+)");
+
+// Creates, records and evaluates its own resources, returning the result
+static std::vector<float>
+runWorker(kp::Manager& mgr,
+          const std::vector<uint32_t>& spirv,
+          uint32_t iterations)
+{
+    std::shared_ptr<kp::TensorT<float>> tensor =
+      mgr.tensor(std::vector<float>(16, 0));
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()
+        ->record<kp::OpTensorSyncDevice>({ tensor })
+        ->record<kp::OpAlgoDispatch>(mgr.algorithm({ tensor }, spirv))
+        ->record<kp::OpTensorSyncLocal>({ tensor });
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        sq->eval();
+    }
+
+    return tensor->vector();
+}
+
+// Runs the workers in parallel and returns the total time in microseconds
+static int64_t
+runWorkers(kp::Manager& mgr,
+           const std::vector<uint32_t>& spirv,
+           uint32_t threadCount,
+           uint32_t iterations)
+{
+    std::vector<std::vector<float>> results(threadCount);
+    std::vector<std::thread> threads;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < threadCount; i++) {
+        threads.emplace_back([&mgr, &spirv, &results, i, iterations]() {
+            results[i] = runWorker(mgr, spirv, iterations);
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    for (const std::vector<float>& result : results) {
+        EXPECT_EQ(result, std::vector<float>(16, iterations));
+    }
+
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+      .count();
+}
+
+TEST(TestConcurrency, RecordAndSubmitFromSeveralThreads)
+{
+    kp::Manager mgr;
+    mgr.setConcurrentMode(true);
+
+    runWorkers(mgr, compileSource(INCREMENT_SHADER), 8, 10);
+}
+
+TEST(TestConcurrency, SequencesOfAThreadShareCommandPool)
+{
+    kp::Manager mgr;
+    mgr.setConcurrentMode(true);
+    EXPECT_TRUE(mgr.getConcurrentMode());
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 0, 0, 0 });
+
+    std::vector<std::shared_ptr<kp::Sequence>> sequences;
+    for (uint32_t i = 0; i < 16; i++) {
+        sequences.push_back(
+          mgr.sequence()->record<kp::OpTensorSyncDevice>({ tensor }));
+    }
+    for (const std::shared_ptr<kp::Sequence>& sq : sequences) {
+        sq->eval();
+        EXPECT_TRUE(sq->isInit());
+    }
+}
+
+TEST(TestConcurrency, BenchmarkConcurrentSubmissionScaling)
+{
+    uint32_t iterations = 100;
+    uint32_t maxThreadCount = std::max(2u, std::thread::hardware_concurrency());
+
+    kp::Manager mgr;
+    mgr.setConcurrentMode(true);
+
+    std::vector<uint32_t> spirv = compileSource(INCREMENT_SHADER);
+
+    for (uint32_t threadCount = 1; threadCount <= maxThreadCount;
+         threadCount *= 2) {
+        int64_t duration = runWorkers(mgr, spirv, threadCount, iterations);
+
+        KP_LOG_INFO("Concurrent evals with {} threads: {} evals per second",
+                    threadCount,
+                    threadCount * iterations * 1000000.0 / duration);
+    }
+}
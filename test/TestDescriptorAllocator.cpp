@@ -0,0 +1,126 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <chrono>
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+static const std::string INCREMENT_SHADER(R"(
+    #version 450
+
+    layout (local_size_x = 1) in;
+
+    layout(set = 0, binding = 0) buffer a { float pa[]; };
+
+    void main() {
+        uint index = gl_GlobalInvocationID.x;
+        pa[index] = pa[index] + 1.0;
+    }
+)");
+
+TEST(TestDescriptorAllocator, AlgorithmsShareOnePool)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 0, 0, 0 });
+    std::vector<uint32_t> spirv = compileSource(INCREMENT_SHADER);
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()->record<kp::OpTensorSyncDevice>({ tensor });
+    std::vector<std::shared_ptr<kp::Algorithm>> algorithms;
+    for (uint32_t i = 0; i < 100; i++) {
+        algorithms.push_back(mgr.algorithm({ tensor }, spirv));
+        sq->record<kp::OpAlgoDispatch>(algorithms.back());
+    }
+    sq->record<kp::OpTensorSyncLocal>({ tensor })->eval();
+
+    EXPECT_EQ(tensor->vector(), std::vector<float>({ 100, 100, 100 }));
+    EXPECT_EQ(mgr.getDescriptorAllocator()->poolCount(), 1);
+}
+
+TEST(TestDescriptorAllocator, SetsRecycledOnAlgorithmDestroy)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::DescriptorAllocator> allocator =
+      mgr.getDescriptorAllocator();
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 0, 0, 0 });
+    std::vector<uint32_t> spirv = compileSource(INCREMENT_SHADER);
+
+    mgr.sequence()->eval<kp::OpTensorSyncDevice>({ tensor });
+
+    for (uint32_t i = 0; i < 1000; i++) {
+        std::shared_ptr<kp::Algorithm> algo = mgr.algorithm({ tensor }, spirv);
+        mgr.sequence()->eval<kp::OpAlgoDispatch>(algo);
+        algo->destroy();
+        EXPECT_EQ(allocator->availableSetCount(), 1);
+    }
+
+    mgr.sequence()->eval<kp::OpTensorSyncLocal>({ tensor });
+
+    EXPECT_EQ(tensor->vector(), std::vector<float>({ 1000, 1000, 1000 }));
+    EXPECT_EQ(allocator->poolCount(), 1);
+}
+
+TEST(TestDescriptorAllocator, PoolsGrowAndLayoutsAreCached)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::DescriptorAllocator> allocator =
+      mgr.getDescriptorAllocator();
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 0, 0, 0 });
+    std::vector<uint32_t> spirv = compileSource(INCREMENT_SHADER);
+
+    std::vector<std::shared_ptr<kp::Algorithm>> algorithms;
+    for (uint32_t i = 0; i < KP_DEFAULT_DESCRIPTOR_POOL_SETS + 1; i++) {
+        algorithms.push_back(mgr.algorithm({ tensor }, spirv));
+    }
+
+    EXPECT_EQ(allocator->poolCount(), 2);
+    EXPECT_EQ(allocator->layout({ 1 }), allocator->layout({ 1 }));
+    EXPECT_NE(allocator->layout({ 1 }), allocator->layout({ 1, 1 }));
+
+    mgr.sequence()
+      ->record<kp::OpTensorSyncDevice>({ tensor })
+      ->record<kp::OpAlgoDispatch>(algorithms.front())
+      ->record<kp::OpAlgoDispatch>(algorithms.back())
+      ->record<kp::OpTensorSyncLocal>({ tensor })
+      ->eval();
+
+    EXPECT_EQ(tensor->vector(), std::vector<float>({ 2, 2, 2 }));
+}
+
+TEST(TestDescriptorAllocator, BenchmarkAlgorithmCreateDestroy)
+{
+    uint32_t iterations = 1000;
+
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 0, 0, 0 });
+    std::vector<uint32_t> spirv = compileSource(INCREMENT_SHADER);
+
+    // The first algorithm creates the pipeline and the pool
+    mgr.algorithm({ tensor }, spirv)->destroy();
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        mgr.algorithm({ tensor }, spirv)->destroy();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    int64_t duration =
+      std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+        .count();
+
+    KP_LOG_INFO("Creating and destroying {} algorithms took {} us",
+                iterations,
+                duration);
+
+    EXPECT_EQ(mgr.getDescriptorAllocator()->poolCount(), 1);
+    EXPECT_EQ(mgr.getDescriptorAllocator()->availableSetCount(), 1);
+}
@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+static const std::string INCREMENT_SHADER(R"(
+    #version 450
+
+    layout (local_size_x = 1) in;
+
+    layout(set = 0, binding = 0) buffer b { float pb[]; };
+
+    void main() {
+        uint index = gl_GlobalInvocationID.x;
+        pb[index] = pb[index] + 1.0;
+    }
+)");
+
+static kp::TensorAccess
+shaderReadWrite(std::shared_ptr<kp::Tensor> tensor)
+{
+    return { tensor,
+             vk::PipelineStageFlagBits::eComputeShader,
+             vk::AccessFlagBits::eShaderRead |
+               vk::AccessFlagBits::eShaderWrite };
+}
+
+static kp::TensorAccess
+transferRead(std::shared_ptr<kp::Tensor> tensor)
+{
+    return { tensor,
+             vk::PipelineStageFlagBits::eTransfer,
+             vk::AccessFlagBits::eTransferRead };
+}
+
+static kp::TensorAccess
+transferWrite(std::shared_ptr<kp::Tensor> tensor)
+{
+    return { tensor,
+             vk::PipelineStageFlagBits::eTransfer,
+             vk::AccessFlagBits::eTransferWrite };
+}
+
+TEST(TestHazardTracker, ComputeWriteThenComputeRead)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 1, 2, 3 });
+
+    kp::HazardTracker tracker;
+    tracker.track({ transferWrite(tensor) });
+
+    kp::HazardTracker::Barriers barriers =
+      tracker.track({ shaderReadWrite(tensor) });
+    EXPECT_TRUE(barriers.srcStageMask ==
+                vk::PipelineStageFlags(vk::PipelineStageFlagBits::eTransfer));
+    ASSERT_EQ(barriers.bufferMemoryBarriers.size(), 1);
+    EXPECT_TRUE(barriers.bufferMemoryBarriers[0].srcAccessMask ==
+                vk::AccessFlags(vk::AccessFlagBits::eTransferWrite));
+
+    // The second dispatch has to wait for the writes of the first one
+    barriers = tracker.track({ shaderReadWrite(tensor) });
+    EXPECT_TRUE(
+      barriers.srcStageMask ==
+      vk::PipelineStageFlags(vk::PipelineStageFlagBits::eComputeShader));
+    ASSERT_EQ(barriers.bufferMemoryBarriers.size(), 1);
+    EXPECT_TRUE(barriers.bufferMemoryBarriers[0].srcAccessMask ==
+                vk::AccessFlags(vk::AccessFlagBits::eShaderWrite));
+}
+
+TEST(TestHazardTracker, ReadsOnlyRequireOneBarrier)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 4, 5, 6 });
+
+    kp::HazardTracker tracker;
+    tracker.track({ transferWrite(tensorA) });
+
+    EXPECT_EQ(tracker.track({ transferRead(tensorA), transferWrite(tensorB) })
+                .bufferMemoryBarriers.size(),
+              2);
+
+    // The write is already visible to the transfer reads
+    EXPECT_TRUE(
+      tracker.track({ transferRead(tensorA) }).bufferMemoryBarriers.empty());
+
+    // Writing after the reads only requires an execution dependency
+    kp::HazardTracker::Barriers barriers =
+      tracker.track({ transferWrite(tensorA) });
+    ASSERT_EQ(barriers.bufferMemoryBarriers.size(), 1);
+    EXPECT_TRUE(barriers.srcStageMask ==
+                vk::PipelineStageFlags(vk::PipelineStageFlagBits::eTransfer));
+    EXPECT_TRUE(barriers.bufferMemoryBarriers[0].srcAccessMask ==
+                vk::AccessFlags());
+}
+
+TEST(TestHazardTracker, BarriersOfAnOperationAreMerged)
+{
+    kp::Manager mgr;
+
+    std::vector<std::shared_ptr<kp::Tensor>> tensors;
+    std::vector<kp::TensorAccess> writes;
+    std::vector<kp::TensorAccess> dispatch;
+    for (uint32_t i = 0; i < 9; i++) {
+        tensors.push_back(mgr.tensor({ 1, 2, 3 }));
+        writes.push_back(transferWrite(tensors.back()));
+        dispatch.push_back(shaderReadWrite(tensors.back()));
+    }
+
+    kp::HazardTracker tracker;
+    tracker.track(writes);
+
+    kp::HazardTracker::Barriers barriers = tracker.track(dispatch);
+    EXPECT_EQ(barriers.bufferMemoryBarriers.size(), 9);
+    EXPECT_TRUE(
+      barriers.dstStageMask ==
+      vk::PipelineStageFlags(vk::PipelineStageFlagBits::eComputeShader));
+}
+
+TEST(TestHazardTracker, OverlappingViewsAreSynchronised)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor =
+      mgr.tensor({ 0, 1, 2, 3, 4, 5 });
+    std::shared_ptr<kp::TensorView> view{ new kp::TensorView(tensor, 2, 3) };
+
+    kp::HazardTracker tracker;
+    tracker.track({ transferWrite(tensor) });
+    tracker.track({ transferRead(tensor) });
+
+    // The view overwrites data read through the whole tensor
+    kp::HazardTracker::Barriers barriers =
+      tracker.track({ shaderReadWrite(view) });
+    EXPECT_EQ(barriers.bufferMemoryBarriers.size(), 1);
+
+    // The whole tensor reads data written through the view
+    barriers = tracker.track({ transferRead(tensor) });
+    ASSERT_EQ(barriers.bufferMemoryBarriers.size(), 1);
+    EXPECT_TRUE(barriers.bufferMemoryBarriers[0].srcAccessMask ==
+                vk::AccessFlags(vk::AccessFlagBits::eShaderWrite));
+
+    // Nothing is known about the accesses before a new recording
+    tracker.clear();
+    barriers = tracker.track({ transferRead(tensor) });
+    EXPECT_EQ(barriers.bufferMemoryBarriers.size(), 1);
+}
+
+TEST(TestHazardTracker, ConsecutiveDispatchesOnTheSameTensor)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor =
+      mgr.tensor(std::vector<float>(16, 0));
+
+    std::shared_ptr<kp::Algorithm> algo =
+      mgr.algorithm({ tensor }, compileSource(INCREMENT_SHADER));
+
+    mgr.sequence()
+      ->record<kp::OpTensorSyncDevice>({ tensor })
+      ->record<kp::OpAlgoDispatch>(algo)
+      ->record<kp::OpAlgoDispatch>(algo)
+      ->record<kp::OpAlgoDispatch>(algo)
+      ->record<kp::OpTensorSyncLocal>({ tensor })
+      ->eval();
+
+    EXPECT_EQ(tensor->vector(), std::vector<float>(16, 3));
+}
@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <memory>
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+// Large enough for the import granularity of the devices tested against
+static const size_t IMPORT_ALIGNMENT = 64 * 1024;
+
+static float*
+alignedData(std::vector<float>& storage, size_t count)
+{
+    storage.resize(count + IMPORT_ALIGNMENT / sizeof(float));
+    void* data = storage.data();
+    size_t space = storage.size() * sizeof(float);
+    return (float*)std::align(
+      IMPORT_ALIGNMENT, count * sizeof(float), data, space);
+}
+
+TEST(TestHostMemoryImport, ImportedHostTensorSharesMemory)
+{
+    kp::Manager mgr;
+
+    uint32_t size = IMPORT_ALIGNMENT / sizeof(float);
+    std::vector<float> storage;
+    float* data = alignedData(storage, size);
+    for (uint32_t i = 0; i < size; i++) {
+        data[i] = i;
+    }
+
+    std::shared_ptr<kp::Tensor> tensor =
+      mgr.importTensor(data,
+                       size,
+                       sizeof(float),
+                       kp::Tensor::TensorDataTypes::eFloat,
+                       kp::Tensor::TensorTypes::eHost);
+
+    KP_LOG_INFO("Host memory imported: {}", tensor->isHostMemoryImported());
+
+    std::string shader(R"(
+        #version 450
+
+        layout (local_size_x = 1) in;
+
+        layout(set = 0, binding = 0) buffer buf { float pa[]; };
+
+        void main() {
+            uint index = gl_GlobalInvocationID.x;
+            pa[index] = pa[index] * 2;
+        }
+    )");
+
+    mgr.sequence()
+      ->record<kp::OpAlgoDispatch>(mgr.algorithm(
+        { tensor }, compileSource(shader), kp::Workgroup({ size, 1, 1 })))
+      ->eval()
+      ->eval<kp::OpTensorSyncLocal>({ tensor });
+
+    std::vector<float> result = tensor->vector<float>();
+    EXPECT_EQ(result[0], 0);
+    EXPECT_EQ(result[size - 1], (size - 1) * 2);
+
+    // The results are written straight into the memory that was imported
+    if (tensor->isHostMemoryImported()) {
+        EXPECT_EQ(tensor->data<float>(), data);
+        EXPECT_EQ(data[size - 1], (size - 1) * 2);
+    }
+}
+
+TEST(TestHostMemoryImport, ImportedDeviceTensorSyncs)
+{
+    kp::Manager mgr;
+
+    uint32_t size = IMPORT_ALIGNMENT / sizeof(float);
+    std::vector<float> storage;
+    float* data = alignedData(storage, size);
+    for (uint32_t i = 0; i < size; i++) {
+        data[i] = i;
+    }
+
+    std::shared_ptr<kp::Tensor> tensorIn = mgr.importTensor(
+      data, size, sizeof(float), kp::Tensor::TensorDataTypes::eFloat);
+    std::shared_ptr<kp::TensorT<float>> tensorOut =
+      mgr.tensor(std::vector<float>(size, 0));
+
+    mgr.sequence()
+      ->eval<kp::OpTensorSyncDevice>({ tensorIn, tensorOut })
+      ->eval<kp::OpTensorCopy>({ tensorIn, tensorOut })
+      ->eval<kp::OpTensorSyncLocal>({ tensorOut });
+
+    EXPECT_EQ(tensorOut->vector(), std::vector<float>(data, data + size));
+}
+
+TEST(TestHostMemoryImport, UnalignedMemoryIsCopied)
+{
+    kp::Manager mgr;
+
+    std::vector<float> storage;
+    float* data = alignedData(storage, 1025) + 1;
+    for (uint32_t i = 0; i < 1024; i++) {
+        data[i] = 1;
+    }
+
+    std::shared_ptr<kp::Tensor> tensor =
+      mgr.importTensor(data,
+                       1023,
+                       sizeof(float),
+                       kp::Tensor::TensorDataTypes::eFloat,
+                       kp::Tensor::TensorTypes::eHost);
+
+    EXPECT_FALSE(tensor->isHostMemoryImported());
+    EXPECT_NE(tensor->data<float>(), data);
+
+    data[0] = 2;
+    EXPECT_EQ(tensor->vector<float>(), std::vector<float>(1023, 1));
+}
@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+TEST(TestMemoryPool, TensorsSubAllocatedFromSharedBlocks)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::MemoryPool> pool = mgr.getMemoryPool();
+    ASSERT_TRUE(pool != nullptr);
+
+    std::vector<std::shared_ptr<kp::Tensor>> tensors;
+    for (uint32_t i = 0; i < 100; i++) {
+        tensors.push_back(mgr.tensor({ 1.0f * i, 2.0f * i, 3.0f * i }));
+    }
+
+    // Device tensors need device local and host visible memory, so at most a
+    // block for each of the two memory types is expected
+    EXPECT_LE(pool->blockCount(), 2);
+
+    mgr.sequence()
+      ->eval<kp::OpTensorSyncDevice>(tensors)
+      ->eval<kp::OpTensorSyncLocal>(tensors);
+
+    for (uint32_t i = 0; i < tensors.size(); i++) {
+        EXPECT_EQ(tensors[i]->vector<float>(),
+                  std::vector<float>({ 1.0f * i, 2.0f * i, 3.0f * i }));
+    }
+}
+
+TEST(TestMemoryPool, ReleasedMemoryIsReused)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::MemoryPool> pool = mgr.getMemoryPool();
+
+    {
+        std::vector<std::shared_ptr<kp::Tensor>> tensors;
+        for (uint32_t i = 0; i < 1000; i++) {
+            tensors.push_back(mgr.tensor(std::vector<float>(256, i)));
+        }
+    }
+
+    uint32_t blockCount = pool->blockCount();
+
+    std::vector<std::shared_ptr<kp::Tensor>> tensors;
+    for (uint32_t i = 0; i < 1000; i++) {
+        tensors.push_back(mgr.tensor(std::vector<float>(256, i)));
+    }
+
+    EXPECT_EQ(pool->blockCount(), blockCount);
+
+    mgr.sequence()
+      ->eval<kp::OpTensorSyncDevice>(tensors)
+      ->eval<kp::OpTensorSyncLocal>(tensors);
+
+    for (uint32_t i = 0; i < tensors.size(); i++) {
+        EXPECT_EQ(tensors[i]->vector<float>(), std::vector<float>(256, i));
+    }
+}
+
+TEST(TestMemoryPool, LargeTensorUsesDedicatedBlock)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::MemoryPool> pool = mgr.getMemoryPool();
+
+    uint32_t blockCount = pool->blockCount();
+
+    {
+        std::shared_ptr<kp::TensorT<float>> tensor =
+          mgr.tensorT<float>(std::vector<float>(16 * 1024 * 1024, 1.0),
+                             kp::Tensor::TensorTypes::eHost);
+        EXPECT_EQ(pool->blockCount(), blockCount + 1);
+        EXPECT_EQ((*tensor)[16 * 1024 * 1024 - 1], 1.0);
+    }
+
+    EXPECT_EQ(pool->blockCount(), blockCount);
+}
+
+TEST(TestMemoryPool, PoolDisabledFallsBackToDedicatedAllocations)
+{
+    kp::Manager mgr;
+
+    mgr.setMemoryPool(nullptr);
+    EXPECT_TRUE(mgr.getMemoryPool() == nullptr);
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 1, 2, 3 });
+
+    mgr.sequence()
+      ->eval<kp::OpTensorSyncDevice>({ tensor })
+      ->eval<kp::OpTensorSyncLocal>({ tensor });
+
+    EXPECT_EQ(tensor->vector(), std::vector<float>({ 1, 2, 3 }));
+}
+
+TEST(TestMemoryPool, BenchmarkManySmallTensors)
+{
+    // Creates 10k small tensors with and without the memory pool. Each device
+    // tensor requires two buffers, so the unpooled run issues 20k memory
+    // allocations which is above the maxMemoryAllocationCount (4096) of many
+    // drivers, hence the unpooled run is capped to the device limit. Timings
+    // are only logged as wall clock comparisons are unreliable on shared CI.
+    uint32_t totalTensors = 10000;
+
+    kp::Manager mgr;
+
+    uint32_t maxAllocations =
+      mgr.getDeviceProperties().limits.maxMemoryAllocationCount;
+    uint32_t totalUnpooledTensors =
+      std::min(totalTensors, (maxAllocations - 100) / 2);
+
+    std::vector<float> data(64, 1.0);
+
+    auto startPooled = std::chrono::high_resolution_clock::now();
+    {
+        std::vector<std::shared_ptr<kp::Tensor>> tensors;
+        for (uint32_t i = 0; i < totalTensors; i++) {
+            tensors.push_back(mgr.tensor(data));
+        }
+    }
+    auto endPooled = std::chrono::high_resolution_clock::now();
+    auto durationPooled = std::chrono::duration_cast<std::chrono::microseconds>(
+                            endPooled - startPooled)
+                            .count();
+
+    std::shared_ptr<kp::MemoryPool> pool = mgr.getMemoryPool();
+    mgr.setMemoryPool(nullptr);
+
+    auto startUnpooled = std::chrono::high_resolution_clock::now();
+    {
+        std::vector<std::shared_ptr<kp::Tensor>> tensors;
+        for (uint32_t i = 0; i < totalUnpooledTensors; i++) {
+            tensors.push_back(mgr.tensor(data));
+        }
+    }
+    auto endUnpooled = std::chrono::high_resolution_clock::now();
+    auto durationUnpooled =
+      std::chrono::duration_cast<std::chrono::microseconds>(endUnpooled -
+                                                            startUnpooled)
+        .count();
+
+    mgr.setMemoryPool(pool);
+
+    KP_LOG_INFO("Pooled: {} tensors in {}us, unpooled: {} tensors in {}us",
+                totalTensors,
+                durationPooled,
+                totalUnpooledTensors,
+                durationUnpooled);
+}
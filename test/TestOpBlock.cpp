@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+static const std::string INCREMENT_SHADER(R"(
+    #version 450
+
+    layout (local_size_x = 1) in;
+
+    layout(set = 0, binding = 0) buffer a { float pa[]; };
+
+    void main() {
+        uint index = gl_GlobalInvocationID.x;
+        pa[index] = pa[index] + 1.0;
+    }
+)");
+
+TEST(TestOpBlock, BlockExecutedFromSeveralSequences)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 0, 0, 0 });
+    std::shared_ptr<kp::Algorithm> algo =
+      mgr.algorithm({ tensor }, compileSource(INCREMENT_SHADER));
+
+    std::shared_ptr<kp::OpBlock> block = mgr.block(
+      { std::make_shared<kp::OpTensorSyncDevice>(
+          std::vector<std::shared_ptr<kp::Tensor>>{ tensor }),
+        std::make_shared<kp::OpAlgoDispatch>(algo),
+        std::make_shared<kp::OpTensorSyncLocal>(
+          std::vector<std::shared_ptr<kp::Tensor>>{ tensor }) });
+    EXPECT_TRUE(block->isInit());
+
+    std::shared_ptr<kp::Sequence> sqA = mgr.sequence()->record(block);
+    std::shared_ptr<kp::Sequence> sqB = mgr.sequence()->record(block);
+
+    sqA->eval();
+    EXPECT_EQ(tensor->vector(), std::vector<float>({ 1, 1, 1 }));
+
+    sqB->eval();
+    EXPECT_EQ(tensor->vector(), std::vector<float>({ 2, 2, 2 }));
+
+    sqA->eval();
+    EXPECT_EQ(tensor->vector(), std::vector<float>({ 3, 3, 3 }));
+}
+
+TEST(TestOpBlock, SequencesFollowBlockRecordedAgain)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 0, 0, 0, 0 });
+    std::shared_ptr<kp::Algorithm> algo =
+      mgr.algorithm({ tensor }, compileSource(INCREMENT_SHADER));
+
+    std::shared_ptr<kp::OpBlock> block = mgr.block(
+      { std::make_shared<kp::OpTensorSyncDevice>(
+          std::vector<std::shared_ptr<kp::Tensor>>{ tensor }),
+        std::make_shared<kp::OpAlgoDispatch>(algo),
+        std::make_shared<kp::OpTensorSyncLocal>(
+          std::vector<std::shared_ptr<kp::Tensor>>{ tensor }) });
+    uint64_t version = block->recordVersion();
+
+    std::shared_ptr<kp::Sequence> sqA = mgr.sequence()->record(block)->eval();
+    std::shared_ptr<kp::Sequence> sqB = mgr.sequence()->record(block)->eval();
+    EXPECT_EQ(tensor->vector(), std::vector<float>({ 2, 2, 2, 2 }));
+    EXPECT_EQ(block->recordVersion(), version);
+
+    // Growing past the capacity frees the buffers the block was recorded
+    // with, so the first sequence records the block again
+    tensor->rebuild(std::vector<float>(8, 10));
+
+    sqA->eval();
+    EXPECT_EQ(tensor->vector(),
+              std::vector<float>({ 11, 11, 11, 11, 10, 10, 10, 10 }));
+    EXPECT_GT(block->recordVersion(), version);
+
+    // The command buffer of the second sequence executed the previous
+    // recording of the block, so it is recorded again as well
+    sqB->eval();
+    EXPECT_EQ(tensor->vector(),
+              std::vector<float>({ 12, 12, 12, 12, 10, 10, 10, 10 }));
+}
+
+TEST(TestOpBlock, BlockSynchronisedWithSequenceOperations)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 0, 0, 0 });
+    std::shared_ptr<kp::Algorithm> algo =
+      mgr.algorithm({ tensor }, compileSource(INCREMENT_SHADER));
+
+    std::shared_ptr<kp::OpBlock> block =
+      mgr.block({ std::make_shared<kp::OpAlgoDispatch>(algo),
+                  std::make_shared<kp::OpAlgoDispatch>(algo) });
+
+    mgr.sequence()
+      ->record<kp::OpTensorSyncDevice>({ tensor })
+      ->record(block)
+      ->record<kp::OpAlgoDispatch>(algo)
+      ->record(block)
+      ->record<kp::OpTensorSyncLocal>({ tensor })
+      ->eval();
+
+    EXPECT_EQ(tensor->vector(), std::vector<float>({ 5, 5, 5 }));
+}
+
+TEST(TestOpBlock, BlockDestroyedByManager)
+{
+    std::shared_ptr<kp::OpBlock> block = nullptr;
+
+    {
+        kp::Manager mgr;
+
+        std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 0, 0, 0 });
+
+        block = mgr.block({ std::make_shared<kp::OpTensorFill>(
+          std::vector<std::shared_ptr<kp::Tensor>>{ tensor }) });
+        EXPECT_TRUE(block->isInit());
+    }
+
+    EXPECT_FALSE(block->isInit());
+}
@@ -0,0 +1,126 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+TEST(TestOpRepeat, RepeatDispatchInOneSubmission)
+{
+    std::string shader(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) buffer a { float pa[]; };
+      void main() {
+          uint index = gl_GlobalInvocationID.x;
+          pa[index] = pa[index] + 1.0;
+      })");
+
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 0, 0, 0 });
+    std::shared_ptr<kp::Algorithm> algo =
+      mgr.algorithm({ tensor }, compileSource(shader));
+
+    std::shared_ptr<kp::OpBase> dispatch{ new kp::OpAlgoDispatch(algo) };
+    std::shared_ptr<kp::OpBase> repeat{ new kp::OpRepeat({ dispatch }, 1000) };
+
+    mgr.sequence()
+      ->record<kp::OpTensorSyncDevice>({ tensor })
+      ->record(repeat)
+      ->record<kp::OpTensorSyncLocal>({ tensor })
+      ->eval();
+
+    EXPECT_EQ(tensor->vector(), std::vector<float>({ 1000, 1000, 1000 }));
+}
+
+TEST(TestOpRepeat, DependenciesAcrossIterations)
+{
+    std::string shaderA(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) buffer a { float pa[]; };
+      void main() {
+          uint index = gl_GlobalInvocationID.x;
+          pa[index] = pa[index] + 1.0;
+      })");
+
+    std::string shaderB(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) buffer a { float pa[]; };
+      layout(set = 0, binding = 1) buffer b { float pb[]; };
+      void main() {
+          uint index = gl_GlobalInvocationID.x;
+          pb[index] = pb[index] + pa[index];
+      })");
+
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 0, 0 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0 });
+
+    std::shared_ptr<kp::OpBase> dispatchA{ new kp::OpAlgoDispatch(
+      mgr.algorithm({ tensorA }, compileSource(shaderA))) };
+    std::shared_ptr<kp::OpBase> dispatchB{ new kp::OpAlgoDispatch(
+      mgr.algorithm({ tensorA, tensorB }, compileSource(shaderB))) };
+
+    mgr.sequence()
+      ->record<kp::OpTensorSyncDevice>({ tensorA, tensorB })
+      ->record(std::make_shared<kp::OpRepeat>(
+        std::vector<std::shared_ptr<kp::OpBase>>{ dispatchA, dispatchB }, 4))
+      ->record<kp::OpTensorSyncLocal>({ tensorA, tensorB })
+      ->eval();
+
+    EXPECT_EQ(tensorA->vector(), std::vector<float>({ 4, 4 }));
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 10, 10 }));
+}
+
+TEST(TestOpRepeat, IterationIndexThroughPushConstants)
+{
+    std::string shader(R"(
+      #version 450
+      layout(push_constant) uniform PushConstants {
+        float iteration;
+      } pcs;
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) buffer a { float pa[]; };
+      void main() {
+          uint index = gl_GlobalInvocationID.x;
+          pa[index] = pa[index] + pcs.iteration;
+      })");
+
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 0, 0, 0 });
+    std::shared_ptr<kp::Algorithm> algo = mgr.algorithm(
+      { tensor }, compileSource(shader), kp::Workgroup(), {}, { 0.0 });
+
+    std::shared_ptr<kp::OpBase> dispatch{ new kp::OpAlgoDispatch(algo) };
+    std::shared_ptr<kp::OpBase> repeat{ new kp::OpRepeat(
+      { dispatch }, 5, [algo](uint32_t iteration) {
+          algo->setPushConstants<float>({ (float)iteration });
+      }) };
+
+    mgr.sequence()
+      ->record<kp::OpTensorSyncDevice>({ tensor })
+      ->record(repeat)
+      ->record<kp::OpTensorSyncLocal>({ tensor })
+      ->eval();
+
+    EXPECT_EQ(tensor->vector(), std::vector<float>({ 10, 10, 10 }));
+}
+
+TEST(TestOpRepeat, InvalidParameters)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::OpBase> fill{ new kp::OpTensorFill(
+      { mgr.tensor({ 0, 0 }) }) };
+
+    EXPECT_THROW(kp::OpRepeat({}, 2), std::runtime_error);
+    EXPECT_THROW(kp::OpRepeat({ fill }, 0), std::runtime_error);
+    EXPECT_THROW(kp::OpRepeat({ nullptr }, 2), std::runtime_error);
+}
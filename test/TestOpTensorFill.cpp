@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+TEST(TestOpTensorFill, EmptyTensorsAreNotDirty)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.emptyTensor(100);
+    std::shared_ptr<kp::Tensor> tensorInt =
+      mgr.emptyTensor(100, sizeof(int32_t), kp::Tensor::TensorDataTypes::eInt);
+
+    EXPECT_TRUE(tensor->isInit());
+    EXPECT_EQ(tensor->size(), 100);
+    EXPECT_FALSE(tensor->isDirty());
+    EXPECT_EQ(tensorInt->dataType(), kp::Tensor::TensorDataTypes::eInt);
+}
+
+TEST(TestOpTensorFill, FillDeviceAndHostTensors)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorDevice = mgr.emptyTensor(64);
+    std::shared_ptr<kp::TensorT<float>> tensorHost =
+      mgr.emptyTensor(64, kp::Tensor::TensorTypes::eHost);
+    std::shared_ptr<kp::TensorT<uint32_t>> tensorPattern =
+      mgr.emptyTensorT<uint32_t>(64);
+
+    mgr.sequence()
+      ->eval<kp::OpTensorFill>({ tensorDevice, tensorHost })
+      ->eval<kp::OpTensorFill>({ tensorPattern }, 7);
+
+    EXPECT_EQ(tensorDevice->vector(), std::vector<float>(64, 0));
+    EXPECT_EQ(tensorHost->vector(), std::vector<float>(64, 0));
+    EXPECT_EQ(tensorPattern->vector(), std::vector<uint32_t>(64, 7));
+
+    // The device memory holds the value rather than just the host data
+    tensorDevice->setData(std::vector<float>(64, 1));
+    tensorDevice->clearDirty();
+    mgr.sequence()->eval<kp::OpTensorSyncLocal>({ tensorDevice });
+    EXPECT_EQ(tensorDevice->vector(), std::vector<float>(64, 0));
+}
+
+TEST(TestOpTensorFill, GeneratedTensorAsShaderInput)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorIn = mgr.tensorT<float>(
+      16, [](float* data, uint64_t size) {
+          for (uint64_t i = 0; i < size; i++) {
+              data[i] = i;
+          }
+      });
+    std::shared_ptr<kp::TensorT<float>> tensorOut = mgr.emptyTensor(16);
+
+    EXPECT_TRUE(tensorIn->isDirty());
+
+    std::string shader(R"(
+        #version 450
+
+        layout (local_size_x = 1) in;
+
+        layout(set = 0, binding = 0) buffer bina { float tina[]; };
+        layout(set = 0, binding = 1) buffer bout { float tout[]; };
+
+        void main() {
+            uint index = gl_GlobalInvocationID.x;
+            tout[index] += tina[index] * 2;
+        }
+    )");
+
+    std::shared_ptr<kp::Algorithm> algo =
+      mgr.algorithm({ tensorIn, tensorOut }, compileSource(shader));
+
+    mgr.sequence()
+      ->record<kp::OpTensorSyncDevice>({ tensorIn })
+      ->record<kp::OpTensorFill>({ tensorOut })
+      ->record<kp::OpAlgoDispatch>(algo)
+      ->record<kp::OpTensorSyncLocal>({ tensorOut })
+      ->eval();
+
+    std::vector<float> expected;
+    for (uint32_t i = 0; i < 16; i++) {
+        expected.push_back(i * 2);
+    }
+    EXPECT_EQ(tensorOut->vector(), expected);
+}
+
+TEST(TestOpTensorFill, FillRequiresFourByteAlignment)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::Tensor> tensor =
+      mgr.emptyTensor(3, sizeof(bool), kp::Tensor::TensorDataTypes::eBool);
+
+    EXPECT_ANY_THROW(mgr.sequence()->eval<kp::OpTensorFill>({ tensor }));
+}
@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+TEST(TestOpTensorSyncRange, SyncDeviceOnlyCopiesRanges)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA =
+      mgr.tensor({ 0, 0, 0, 0, 0, 0, 0, 0 });
+    std::shared_ptr<kp::TensorT<float>> tensorB =
+      mgr.tensor({ 0, 0, 0, 0, 0, 0, 0, 0 });
+
+    mgr.sequence()->eval<kp::OpTensorSyncDevice>({ tensorA, tensorB });
+
+    tensorA->setData({ 1, 2, 3, 4, 5, 6, 7, 8 });
+
+    // Only elements [1, 3) and [6, 7) are transferred to the device
+    mgr.sequence()
+      ->eval<kp::OpTensorSyncDevice>(
+        std::vector<std::shared_ptr<kp::Tensor>>{ tensorA },
+        std::vector<kp::TensorRange>{ { 1, 2 }, { 6, 1 } })
+      ->eval<kp::OpTensorCopy>({ tensorA, tensorB });
+
+    mgr.sequence()->eval<kp::OpTensorSyncLocal>({ tensorB });
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 0, 2, 3, 0, 0, 0, 7, 0 }));
+}
+
+TEST(TestOpTensorSyncRange, SyncLocalOnlyCopiesRanges)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor =
+      mgr.tensor({ 1, 2, 3, 4, 5, 6 });
+
+    mgr.sequence()->eval<kp::OpTensorSyncDevice>({ tensor });
+
+    tensor->setData({ 0, 0, 0, 0, 0, 0 });
+
+    mgr.sequence()->eval<kp::OpTensorSyncLocal>(
+      std::vector<std::shared_ptr<kp::Tensor>>{ tensor },
+      std::vector<kp::TensorRange>{ { 4, 2 } });
+
+    EXPECT_EQ(tensor->vector(), std::vector<float>({ 0, 0, 0, 0, 5, 6 }));
+}
+
+TEST(TestOpTensorSyncRange, RangeOutOfBoundsThrows)
+{
+    kp::Manager mgr;
+
+    std::vector<std::shared_ptr<kp::Tensor>> tensors{ mgr.tensor(
+      { 1, 2, 3 }) };
+
+    EXPECT_ANY_THROW(kp::OpTensorSyncDevice(
+      tensors, std::vector<kp::TensorRange>{ { 2, 2 } }));
+    EXPECT_ANY_THROW(kp::OpTensorSyncLocal(
+      tensors, std::vector<kp::TensorRange>{ { 0, 0 } }));
+    EXPECT_ANY_THROW(
+      kp::OpTensorSyncLocal(tensors, std::vector<kp::TensorRange>{}));
+}
+
+TEST(TestOpTensorSyncRange, BenchmarkRangedVersusFullSync)
+{
+    // Streaming style workload where only 1 KB of a 4 MB tensor changes.
+    // Timings are only logged as wall clock comparisons are unreliable on CI.
+    uint32_t size = 1024 * 1024;
+    uint32_t iterations = 20;
+
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor =
+      mgr.tensor(std::vector<float>(size, 0));
+
+    std::shared_ptr<kp::Sequence> sqFull =
+      mgr.sequence()->record<kp::OpTensorSyncDevice>({ tensor });
+    std::shared_ptr<kp::Sequence> sqRange =
+      mgr.sequence()->record<kp::OpTensorSyncDevice>(
+        std::vector<std::shared_ptr<kp::Tensor>>{ tensor },
+        std::vector<kp::TensorRange>{ { size / 2, 256 } });
+
+    auto startFull = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        sqFull->eval();
+    }
+    auto endFull = std::chrono::high_resolution_clock::now();
+    auto durationFull =
+      std::chrono::duration_cast<std::chrono::microseconds>(endFull - startFull)
+        .count();
+
+    auto startRange = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        sqRange->eval();
+    }
+    auto endRange = std::chrono::high_resolution_clock::now();
+    auto durationRange = std::chrono::duration_cast<std::chrono::microseconds>(
+                           endRange - startRange)
+                           .count();
+
+    KP_LOG_INFO("Full sync: {}us, ranged sync: {}us for {} iterations",
+                durationFull,
+                durationRange,
+                iterations);
+}
@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+struct StepParameters
+{
+    float learningRate;
+    uint32_t iteration;
+};
+
+TEST(TestParameterBlock, SetAndGetValue)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::ParameterBlock<StepParameters>> params =
+      mgr.parameterBlock<StepParameters>({ 0.5, 3 });
+
+    EXPECT_EQ(params->tensorType(), kp::Tensor::TensorTypes::eHost);
+    EXPECT_EQ(params->memorySize(), sizeof(StepParameters));
+    EXPECT_EQ(params->get().learningRate, 0.5);
+    EXPECT_EQ(params->get().iteration, 3);
+
+    params->set({ 0.25, 4 });
+    EXPECT_EQ(params->get().learningRate, 0.25);
+    EXPECT_EQ(params->get().iteration, 4);
+}
+
+TEST(TestParameterBlock, UpdateParametersWithoutRerecord)
+{
+    std::string shader(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) buffer a { float pa[]; };
+      layout(set = 0, binding = 1) readonly buffer b {
+          float learningRate;
+          uint iteration;
+      };
+      void main() {
+          uint index = gl_GlobalInvocationID.x;
+          pa[index] = pa[index] + learningRate * float(iteration);
+      })");
+
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 0, 0, 0 });
+    std::shared_ptr<kp::ParameterBlock<StepParameters>> params =
+      mgr.parameterBlock<StepParameters>();
+
+    std::shared_ptr<kp::Algorithm> algo =
+      mgr.algorithm({ tensor, params }, compileSource(shader));
+
+    mgr.sequence()->eval<kp::OpTensorSyncDevice>({ tensor });
+
+    // The sequence is recorded once and only submitted in the loop
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()
+        ->record<kp::OpAlgoDispatch>(algo)
+        ->record<kp::OpTensorSyncLocal>({ tensor });
+
+    float expected = 0;
+    for (uint32_t i = 1; i <= 4; i++) {
+        params->set({ 1.0f / i, i * i });
+        sq->eval();
+        expected += i;
+
+        EXPECT_EQ(tensor->vector(),
+                  std::vector<float>({ expected, expected, expected }));
+    }
+}
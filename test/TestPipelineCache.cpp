@@ -0,0 +1,215 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+static const std::string CACHE_PATH("kompute_test_pipeline_cache.bin");
+
+static const std::string SPECIALIZED_SHADER(R"(
+    #version 450
+
+    layout (constant_id = 0) const float increment = 0;
+
+    layout (local_size_x = 1) in;
+
+    layout(set = 0, binding = 0) buffer a { float pa[]; };
+
+    void main() {
+        uint index = gl_GlobalInvocationID.x;
+        pa[index] = pa[index] + increment;
+    }
+)");
+
+// Creates a manager and an algorithm for each increment, returning the time
+// taken in microseconds
+static int64_t
+startup(const std::vector<uint32_t>& spirv,
+        uint32_t algorithmCount,
+        bool& loaded)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+
+    kp::Manager mgr;
+    mgr.enablePersistentPipelineCache(CACHE_PATH);
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 0, 0, 0 });
+    for (uint32_t i = 0; i < algorithmCount; i++) {
+        mgr.algorithm({ tensor }, spirv, kp::Workgroup(), { (float)i }, {});
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+
+    loaded = mgr.getPipelineCache()->isLoaded();
+
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+      .count();
+}
+
+TEST(TestPipelineCache, SharedByAlgorithmsAndRebuilds)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 0, 0, 0 });
+    std::vector<uint32_t> spirv = compileSource(SPECIALIZED_SHADER);
+
+    std::shared_ptr<kp::Algorithm> algoA =
+      mgr.algorithm({ tensor }, spirv, kp::Workgroup(), { 1.0 }, {});
+    std::shared_ptr<kp::Algorithm> algoB =
+      mgr.algorithm({ tensor }, spirv, kp::Workgroup(), { 2.0 }, {});
+    algoB->rebuild<float, float>({ tensor }, spirv, kp::Workgroup(), { 2.0 });
+
+    mgr.sequence()
+      ->record<kp::OpTensorSyncDevice>({ tensor })
+      ->record<kp::OpAlgoDispatch>(algoA)
+      ->record<kp::OpAlgoDispatch>(algoB)
+      ->record<kp::OpTensorSyncLocal>({ tensor })
+      ->eval();
+
+    EXPECT_EQ(tensor->vector(), std::vector<float>({ 3, 3, 3 }));
+    EXPECT_FALSE(mgr.getPipelineCache()->isLoaded());
+    EXPECT_EQ(mgr.getPipelineCache()->getPath(), "");
+}
+
+TEST(TestPipelineCache, IdenticalAlgorithmsSharePipeline)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 0, 0, 0 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+    std::vector<uint32_t> spirv = compileSource(SPECIALIZED_SHADER);
+
+    std::shared_ptr<kp::Algorithm> algoA =
+      mgr.algorithm({ tensorA }, spirv, kp::Workgroup(), { 1.0 }, {});
+    std::shared_ptr<kp::Algorithm> algoB =
+      mgr.algorithm({ tensorB }, spirv, kp::Workgroup(), { 1.0 }, {});
+    EXPECT_EQ(mgr.getPipelineCache()->pipelineCount(), 1);
+
+    std::shared_ptr<kp::Algorithm> algoC =
+      mgr.algorithm({ tensorB }, spirv, kp::Workgroup(), { 2.0 }, {});
+    EXPECT_EQ(mgr.getPipelineCache()->pipelineCount(), 2);
+
+    mgr.sequence()
+      ->record<kp::OpTensorSyncDevice>({ tensorA, tensorB })
+      ->record<kp::OpAlgoDispatch>(algoA)
+      ->record<kp::OpAlgoDispatch>(algoB)
+      ->record<kp::OpAlgoDispatch>(algoC)
+      ->record<kp::OpTensorSyncLocal>({ tensorA, tensorB })
+      ->eval();
+
+    EXPECT_EQ(tensorA->vector(), std::vector<float>({ 1, 1, 1 }));
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 3, 3, 3 }));
+
+    // The pipeline is released with the last algorithm that uses it
+    algoA->destroy();
+    EXPECT_EQ(mgr.getPipelineCache()->pipelineCount(), 2);
+    algoB->destroy();
+    EXPECT_EQ(mgr.getPipelineCache()->pipelineCount(), 1);
+    algoC->destroy();
+    EXPECT_EQ(mgr.getPipelineCache()->pipelineCount(), 0);
+}
+
+TEST(TestPipelineCache, PersistedToFile)
+{
+    std::remove(CACHE_PATH.c_str());
+
+    std::vector<uint32_t> spirv = compileSource(SPECIALIZED_SHADER);
+    bool loaded = true;
+
+    startup(spirv, 1, loaded);
+    EXPECT_FALSE(loaded);
+    EXPECT_TRUE(std::ifstream(CACHE_PATH).good());
+
+    startup(spirv, 1, loaded);
+    EXPECT_TRUE(loaded);
+
+    std::remove(CACHE_PATH.c_str());
+}
+
+TEST(TestPipelineCache, InvalidFileIgnored)
+{
+    {
+        std::ofstream file(CACHE_PATH, std::ios::binary | std::ios::trunc);
+        file << "not a pipeline cache";
+    }
+
+    kp::Manager mgr;
+    mgr.enablePersistentPipelineCache(CACHE_PATH);
+    EXPECT_FALSE(mgr.getPipelineCache()->isLoaded());
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 0, 0, 0 });
+    mgr.sequence()
+      ->record<kp::OpTensorSyncDevice>({ tensor })
+      ->record<kp::OpAlgoDispatch>(
+        mgr.algorithm<float, float>({ tensor },
+                                    compileSource(SPECIALIZED_SHADER),
+                                    kp::Workgroup(),
+                                    { 1.0 },
+                                    {}))
+      ->record<kp::OpTensorSyncLocal>({ tensor })
+      ->eval();
+
+    EXPECT_EQ(tensor->vector(), std::vector<float>({ 1, 1, 1 }));
+
+    mgr.destroy();
+    std::remove(CACHE_PATH.c_str());
+}
+
+TEST(TestPipelineCache, CorruptedDataSizeIgnored)
+{
+    std::remove(CACHE_PATH.c_str());
+
+    std::vector<uint32_t> spirv = compileSource(SPECIALIZED_SHADER);
+    bool loaded = true;
+
+    startup(spirv, 1, loaded);
+    EXPECT_FALSE(loaded);
+
+    // Overwrites the data size stored at the end of the file header
+    {
+        std::fstream file(CACHE_PATH,
+                          std::ios::binary | std::ios::in | std::ios::out);
+        uint64_t dataSize = UINT64_MAX / 2;
+        file.seekp(4 * sizeof(uint32_t) + VK_UUID_SIZE);
+        file.write((const char*)&dataSize, sizeof(dataSize));
+    }
+
+    startup(spirv, 1, loaded);
+    EXPECT_FALSE(loaded);
+
+    // The corrupted file was replaced by a valid one on destroy
+    startup(spirv, 1, loaded);
+    EXPECT_TRUE(loaded);
+
+    std::remove(CACHE_PATH.c_str());
+}
+
+TEST(TestPipelineCache, BenchmarkColdAndWarmStartup)
+{
+    uint32_t algorithmCount = 50;
+
+    std::remove(CACHE_PATH.c_str());
+
+    std::vector<uint32_t> spirv = compileSource(SPECIALIZED_SHADER);
+    bool loaded = true;
+
+    int64_t cold = startup(spirv, algorithmCount, loaded);
+    EXPECT_FALSE(loaded);
+
+    int64_t warm = startup(spirv, algorithmCount, loaded);
+    EXPECT_TRUE(loaded);
+
+    KP_LOG_INFO("Startup with {} pipelines: cold {} us, warm {} us",
+                algorithmCount,
+                cold,
+                warm);
+
+    std::remove(CACHE_PATH.c_str());
+}
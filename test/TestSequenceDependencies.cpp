@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+static const std::string INCREMENT_SHADER(R"(
+    #version 450
+
+    layout (local_size_x = 1) in;
+
+    layout(set = 0, binding = 0) buffer b { float pb[]; };
+
+    void main() {
+        uint index = gl_GlobalInvocationID.x;
+        pb[index] = pb[index] + 1.0;
+    }
+)");
+
+TEST(TestSequenceDependencies, SequencesRunBackToBack)
+{
+    kp::Manager mgr;
+
+    if (!mgr.getSyncPool()->supportsTimelineSemaphores()) {
+        GTEST_SKIP() << "Timeline semaphores are not supported";
+    }
+
+    std::shared_ptr<kp::TensorT<float>> tensorA =
+      mgr.tensor(std::vector<float>(16, 1));
+    std::shared_ptr<kp::TensorT<float>> tensorB =
+      mgr.tensor(std::vector<float>(16, 0));
+
+    std::shared_ptr<kp::Algorithm> algo =
+      mgr.algorithm({ tensorA }, compileSource(INCREMENT_SHADER));
+
+    std::shared_ptr<kp::Sequence> sqA =
+      mgr.sequence()
+        ->record<kp::OpTensorSyncDevice>({ tensorA })
+        ->record<kp::OpAlgoDispatch>(algo);
+    std::shared_ptr<kp::Sequence> sqB =
+      mgr.sequence()
+        ->record<kp::OpTensorCopy>({ tensorA, tensorB })
+        ->record<kp::OpTensorSyncLocal>({ tensorB });
+
+    sqB->addDependency(sqA);
+
+    EXPECT_EQ(sqA->getTimelineValue(), 0);
+
+    // Sequence B only starts on the device once sequence A has finished
+    sqA->evalAsync();
+    sqB->evalAsync();
+    sqB->evalAwait();
+    sqA->evalAwait();
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>(16, 2));
+
+    EXPECT_EQ(sqA->getTimelineValue(), 1);
+    EXPECT_EQ(sqA->getCompletedTimelineValue(), 1);
+    EXPECT_TRUE(sqA->isCompleted());
+    EXPECT_TRUE(sqB->isCompleted());
+
+    sqA->evalAsync();
+    sqB->evalAsync();
+    sqB->evalAwait();
+    sqA->evalAwait();
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>(16, 2));
+    EXPECT_EQ(sqA->getTimelineValue(), 2);
+}
+
+TEST(TestSequenceDependencies, InvalidDependenciesThrow)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::Sequence> sq = mgr.sequence();
+
+    EXPECT_ANY_THROW(sq->addDependency(sq));
+    EXPECT_ANY_THROW(sq->addDependency(nullptr));
+
+    if (!mgr.getSyncPool()->supportsTimelineSemaphores()) {
+        EXPECT_ANY_THROW(sq->addDependency(mgr.sequence()));
+    }
+}
+
+TEST(TestSequenceDependencies, CompletionIsQueriedWithoutBlocking)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor =
+      mgr.tensor(std::vector<float>(16, 0));
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()->record<kp::OpTensorSyncDevice>({ tensor });
+
+    EXPECT_TRUE(sq->isCompleted());
+
+    sq->evalAsync();
+    while (!sq->isCompleted()) {
+    }
+    EXPECT_TRUE(sq->isRunning());
+
+    sq->evalAwait();
+    EXPECT_FALSE(sq->isRunning());
+    EXPECT_TRUE(sq->isCompleted());
+}
@@ -0,0 +1,188 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+TEST(TestStagingRing, SlicesAreReclaimedInAnyOrder)
+{
+    kp::Manager mgr;
+
+    mgr.enableStagingRing(1024);
+    std::shared_ptr<kp::StagingRing> ring = mgr.getStagingRing();
+
+    std::shared_ptr<kp::StagingRing::Slice> sliceA = ring->allocate(400);
+    std::shared_ptr<kp::StagingRing::Slice> sliceB = ring->allocate(400);
+    EXPECT_EQ(sliceA->offset(), 0);
+    EXPECT_EQ(sliceB->offset(), 400);
+
+    // Not enough contiguous space left at the end or the start of the ring,
+    // so the slice gets a dedicated buffer
+    std::shared_ptr<kp::StagingRing::Slice> sliceDedicated =
+      ring->allocate(400);
+    EXPECT_TRUE(sliceDedicated->isDedicated());
+    EXPECT_EQ(sliceDedicated->offset(), 0);
+    EXPECT_NE(sliceDedicated->buffer(), sliceA->buffer());
+    EXPECT_EQ(ring->usedSize(), 800);
+    EXPECT_EQ(ring->dedicatedCount(), 1);
+    sliceDedicated = nullptr;
+    EXPECT_EQ(ring->dedicatedCount(), 0);
+
+    // The space of a slice is reused while older and newer slices are held
+    std::shared_ptr<kp::StagingRing::Slice> sliceC = ring->allocate(100);
+    sliceB = nullptr;
+    std::shared_ptr<kp::StagingRing::Slice> sliceD = ring->allocate(400);
+    EXPECT_EQ(sliceD->offset(), 400);
+    EXPECT_EQ(ring->usedSize(), 912);
+
+    // Released neighbours are merged into a single free region
+    sliceA = nullptr;
+    sliceD = nullptr;
+    std::shared_ptr<kp::StagingRing::Slice> sliceE = ring->allocate(800);
+    EXPECT_EQ(sliceE->offset(), 0);
+
+    sliceC = nullptr;
+    sliceE = nullptr;
+    EXPECT_EQ(ring->usedSize(), 0);
+
+    // Slices larger than the whole ring also get a dedicated buffer
+    sliceE = ring->allocate(2048);
+    EXPECT_TRUE(sliceE->isDedicated());
+    EXPECT_EQ(ring->usedSize(), 0);
+}
+
+TEST(TestStagingRing, DeviceTensorsTransferThroughRing)
+{
+    kp::Manager mgr;
+
+    // Unified memory tensors do not use the ring
+    mgr.setUnifiedMemory(false);
+    mgr.enableStagingRing(1024 * 1024);
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 2, 2, 2 });
+    std::shared_ptr<kp::TensorT<float>> tensorOut = mgr.tensor({ 0, 0, 0 });
+
+    EXPECT_EQ(tensorA->stagingRing(), mgr.getStagingRing());
+
+    std::string shader(R"(
+        #version 450
+
+        layout (local_size_x = 1) in;
+
+        layout(set = 0, binding = 0) buffer bina { float tina[]; };
+        layout(set = 0, binding = 1) buffer binb { float tinb[]; };
+        layout(set = 0, binding = 2) buffer bout { float tout[]; };
+
+        void main() {
+            uint index = gl_GlobalInvocationID.x;
+            tout[index] = tina[index] * tinb[index];
+        }
+    )");
+
+    std::shared_ptr<kp::Algorithm> algo =
+      mgr.algorithm({ tensorA, tensorB, tensorOut }, compileSource(shader));
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()
+        ->record<kp::OpTensorSyncDevice>({ tensorA, tensorB })
+        ->record<kp::OpAlgoDispatch>(algo)
+        ->record<kp::OpTensorSyncLocal>({ tensorOut });
+
+    sq->eval();
+    EXPECT_EQ(tensorOut->vector(), std::vector<float>({ 2, 4, 6 }));
+
+    // Host data is copied into the ring on every evaluation
+    tensorA->setData({ 3, 4, 5 });
+    sq->eval();
+    EXPECT_EQ(tensorOut->vector(), std::vector<float>({ 6, 8, 10 }));
+
+    // Slices are released once the sequence is cleared and destroyed
+    sq = nullptr;
+    EXPECT_EQ(mgr.getStagingRing()->usedSize(), 0);
+}
+
+TEST(TestStagingRing, RingSmallerThanTotalTensorSize)
+{
+    kp::Manager mgr;
+
+    mgr.setUnifiedMemory(false);
+
+    // Each sync only holds the ring for its own recording, so the total size
+    // of the tensors can exceed the size of the ring
+    mgr.enableStagingRing(64 * 1024);
+
+    std::vector<std::shared_ptr<kp::TensorT<float>>> tensors;
+    for (uint32_t i = 0; i < 16; i++) {
+        tensors.push_back(mgr.tensor(std::vector<float>(4096, i)));
+    }
+
+    std::shared_ptr<kp::Sequence> sq = mgr.sequence();
+    for (uint32_t i = 0; i < tensors.size(); i++) {
+        sq->eval<kp::OpTensorSyncDevice>({ tensors[i] });
+        tensors[i]->setData(std::vector<float>(4096, 0));
+        sq->eval<kp::OpTensorSyncLocal>({ tensors[i] });
+        EXPECT_EQ(tensors[i]->vector(), std::vector<float>(4096, i));
+    }
+}
+
+TEST(TestStagingRing, PersistentSequenceDoesNotBlockTransientSyncs)
+{
+    kp::Manager mgr;
+
+    mgr.setUnifiedMemory(false);
+    mgr.enableStagingRing(64 * 1024);
+
+    std::shared_ptr<kp::TensorT<float>> tensorPersistent =
+      mgr.tensor(std::vector<float>(1024, 1));
+    std::shared_ptr<kp::TensorT<float>> tensorTransient =
+      mgr.tensor(std::vector<float>(1024, 0));
+
+    // The slice of the first sync is held for as long as the sequence lives
+    std::shared_ptr<kp::Sequence> sqPersistent =
+      mgr.sequence()->record<kp::OpTensorSyncDevice>({ tensorPersistent });
+    sqPersistent->eval();
+
+    // Many times the size of the ring goes through transient syncs
+    for (uint32_t i = 0; i < 256; i++) {
+        tensorTransient->setData(std::vector<float>(1024, i));
+        mgr.sequence()->eval<kp::OpTensorSyncDevice>({ tensorTransient });
+        tensorTransient->setData(std::vector<float>(1024, 0));
+        mgr.sequence()->eval<kp::OpTensorSyncLocal>({ tensorTransient });
+        EXPECT_EQ(tensorTransient->vector(), std::vector<float>(1024, i));
+    }
+
+    EXPECT_EQ(mgr.getStagingRing()->usedSize(), 1024 * sizeof(float));
+
+    sqPersistent->eval();
+    sqPersistent = nullptr;
+    EXPECT_EQ(mgr.getStagingRing()->usedSize(), 0);
+}
+
+TEST(TestStagingRing, TensorLargerThanRing)
+{
+    kp::Manager mgr;
+
+    mgr.setUnifiedMemory(false);
+    mgr.enableStagingRing(1024);
+
+    std::shared_ptr<kp::TensorT<float>> tensor =
+      mgr.tensor(std::vector<float>(4096, 1));
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()->record<kp::OpTensorSyncDevice>({ tensor });
+    sq->eval();
+    EXPECT_EQ(mgr.getStagingRing()->dedicatedCount(), 1);
+
+    tensor->setData(std::vector<float>(4096, 0));
+    mgr.sequence()->eval<kp::OpTensorSyncLocal>({ tensor });
+    EXPECT_EQ(tensor->vector(), std::vector<float>(4096, 1));
+
+    // The dedicated buffers are destroyed along with the operations
+    sq = nullptr;
+    EXPECT_EQ(mgr.getStagingRing()->dedicatedCount(), 0);
+    EXPECT_EQ(mgr.getStagingRing()->usedSize(), 0);
+}
@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+static const std::string INCREMENT_SHADER(R"(
+    #version 450
+
+    layout (local_size_x = 1) in;
+
+    layout(set = 0, binding = 0) buffer b { float pb[]; };
+
+    void main() {
+        uint index = gl_GlobalInvocationID.x;
+        pb[index] = pb[index] + 1.0;
+    }
+)");
+
+TEST(TestSubmissionBatch, SequencesAreSubmittedTogether)
+{
+    uint32_t numSequences = 8;
+
+    kp::Manager mgr;
+
+    std::vector<uint32_t> spirv = compileSource(INCREMENT_SHADER);
+
+    std::vector<std::shared_ptr<kp::TensorT<float>>> tensors;
+    std::vector<std::shared_ptr<kp::Sequence>> sequences;
+    for (uint32_t i = 0; i < numSequences; i++) {
+        std::shared_ptr<kp::TensorT<float>> tensor =
+          mgr.tensor(std::vector<float>(16, i));
+        std::shared_ptr<kp::Algorithm> algo = mgr.algorithm({ tensor }, spirv);
+
+        tensors.push_back(tensor);
+        sequences.push_back(mgr.sequence()
+                              ->record<kp::OpTensorSyncDevice>({ tensor })
+                              ->record<kp::OpAlgoDispatch>(algo)
+                              ->record<kp::OpTensorSyncLocal>({ tensor }));
+    }
+
+    std::shared_ptr<kp::SubmissionBatch> batch = mgr.submit(sequences);
+
+    EXPECT_TRUE(batch->evalAwait());
+    EXPECT_TRUE(batch->isCompleted());
+    EXPECT_EQ(batch->getSequences().size(), numSequences);
+
+    for (uint32_t i = 0; i < numSequences; i++) {
+        EXPECT_FALSE(sequences[i]->isRunning());
+        EXPECT_EQ(tensors[i]->vector(), std::vector<float>(16, i + 1));
+    }
+
+    // All the sequences share the queue so a single fence is used
+    EXPECT_EQ(mgr.getSyncPool()->fenceCount(), 1);
+
+    // Sequences can be submitted again once the batch finished
+    batch = mgr.submit(sequences);
+    batch->evalAwait();
+
+    for (uint32_t i = 0; i < numSequences; i++) {
+        EXPECT_EQ(tensors[i]->vector(), std::vector<float>(16, i + 2));
+    }
+}
+
+TEST(TestSubmissionBatch, SequencesCanBeAwaitedIndividually)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 4, 5, 6 });
+
+    std::shared_ptr<kp::Sequence> sqA =
+      mgr.sequence()
+        ->record<kp::OpTensorSyncDevice>({ tensorA })
+        ->record<kp::OpTensorSyncLocal>({ tensorA });
+    std::shared_ptr<kp::Sequence> sqB =
+      mgr.sequence()
+        ->record<kp::OpTensorSyncDevice>({ tensorB })
+        ->record<kp::OpTensorSyncLocal>({ tensorB });
+
+    std::shared_ptr<kp::SubmissionBatch> batch = mgr.submit({ sqA, sqB });
+
+    sqA->evalAwait();
+    EXPECT_FALSE(sqA->isRunning());
+
+    // Sequence B was not awaited so the batch still runs its postEval
+    EXPECT_TRUE(batch->evalAwait());
+    EXPECT_FALSE(sqB->isRunning());
+
+    EXPECT_EQ(tensorA->vector(), std::vector<float>({ 1, 2, 3 }));
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 4, 5, 6 }));
+}
+
+TEST(TestSubmissionBatch, DependenciesWithinTheBatch)
+{
+    kp::Manager mgr;
+
+    if (!mgr.getSyncPool()->supportsTimelineSemaphores()) {
+        GTEST_SKIP() << "Timeline semaphores are not supported";
+    }
+
+    std::shared_ptr<kp::TensorT<float>> tensorA =
+      mgr.tensor(std::vector<float>(16, 1));
+    std::shared_ptr<kp::TensorT<float>> tensorB =
+      mgr.tensor(std::vector<float>(16, 0));
+
+    std::shared_ptr<kp::Algorithm> algo =
+      mgr.algorithm({ tensorA }, compileSource(INCREMENT_SHADER));
+
+    std::shared_ptr<kp::Sequence> sqA =
+      mgr.sequence()
+        ->record<kp::OpTensorSyncDevice>({ tensorA })
+        ->record<kp::OpAlgoDispatch>(algo);
+    std::shared_ptr<kp::Sequence> sqB =
+      mgr.sequence()
+        ->record<kp::OpTensorCopy>({ tensorA, tensorB })
+        ->record<kp::OpTensorSyncLocal>({ tensorB });
+
+    sqB->addDependency(sqA);
+
+    mgr.submit({ sqA, sqB })->evalAwait();
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>(16, 2));
+    EXPECT_EQ(sqA->getCompletedTimelineValue(), 1);
+}
+
+TEST(TestSubmissionBatch, InvalidBatchesThrow)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 1, 2, 3 });
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()->record<kp::OpTensorSyncDevice>({ tensor });
+
+    EXPECT_ANY_THROW(mgr.submit({ sq, sq }));
+    EXPECT_ANY_THROW(mgr.submit({ sq, nullptr }));
+
+    // Nothing was submitted by the batches that failed
+    EXPECT_FALSE(sq->isRunning());
+
+    sq->evalAsync();
+    EXPECT_ANY_THROW(mgr.submit({ sq }));
+    sq->evalAwait();
+}
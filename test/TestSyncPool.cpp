@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <chrono>
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+TEST(TestSyncPool, FencesAreReusedAcrossEvals)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 1, 2, 3 });
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()->record<kp::OpTensorSyncDevice>({ tensor });
+
+    for (uint32_t i = 0; i < 10; i++) {
+        sq->eval();
+    }
+
+    EXPECT_EQ(mgr.getSyncPool()->fenceCount(), 1);
+    EXPECT_EQ(mgr.getSyncPool()->availableFenceCount(), 1);
+}
+
+TEST(TestSyncPool, SequencesShareTheManagerPool)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 4, 5, 6 });
+
+    std::shared_ptr<kp::Sequence> sqA =
+      mgr.sequence()->record<kp::OpTensorSyncDevice>({ tensorA });
+    std::shared_ptr<kp::Sequence> sqB =
+      mgr.sequence()->record<kp::OpTensorSyncDevice>({ tensorB });
+
+    for (uint32_t i = 0; i < 5; i++) {
+        sqA->evalAsync();
+        sqB->evalAsync();
+        sqA->evalAwait();
+        sqB->evalAwait();
+    }
+
+    // Only as many fences as evals running at the same time are created
+    EXPECT_EQ(mgr.getSyncPool()->fenceCount(), 2);
+    EXPECT_EQ(mgr.getSyncPool()->availableFenceCount(), 2);
+}
+
+TEST(TestSyncPool, UnsignaledFencesAreNotReused)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::SyncPool> syncPool = mgr.getSyncPool();
+
+    // The fence is never submitted so it does not signal
+    vk::Fence fence = syncPool->acquireFence();
+    syncPool->releaseFence(fence, false);
+
+    EXPECT_EQ(syncPool->availableFenceCount(), 0);
+    EXPECT_TRUE(syncPool->acquireFence() != fence);
+    EXPECT_EQ(syncPool->fenceCount(), 2);
+}
+
+TEST(TestSyncPool, BenchmarkEvalRoundTripLatency)
+{
+    uint32_t iterations = 1000;
+
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 0 });
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()->record<kp::OpTensorSyncDevice>({ tensor });
+
+    // The first eval creates the fence that the following evals reuse
+    sq->eval();
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        sq->eval();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration =
+      std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+        .count();
+
+    KP_LOG_INFO("Eval round trip: {}us average over {} iterations",
+                (double)duration / iterations,
+                iterations);
+
+    EXPECT_EQ(mgr.getSyncPool()->fenceCount(), 1);
+}
@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+TEST(TestTensorChunking, SmallTensorsUseSingleDescriptor)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor =
+      mgr.tensor(std::vector<float>(1024, 1));
+
+    EXPECT_EQ(tensor->descriptorCount(), 1);
+    EXPECT_EQ(tensor->descriptorChunkSize(), tensor->size());
+
+    std::vector<vk::DescriptorBufferInfo> descriptorBufferInfos =
+      tensor->constructDescriptorBufferInfos();
+    EXPECT_EQ(descriptorBufferInfos.size(), 1);
+    EXPECT_EQ(descriptorBufferInfos[0].range, tensor->memorySize());
+}
+
+TEST(TestTensorChunking, SizesAreNotTruncated)
+{
+    kp::Manager mgr;
+
+    std::vector<std::shared_ptr<kp::Tensor>> tensors{ mgr.tensor(
+      std::vector<float>(1024, 1)) };
+
+    // Ranges past the 32 bit limit are reported out of bounds instead of
+    // wrapping around to a valid range
+    uint64_t largeOffset = 1ull << 32;
+    EXPECT_ANY_THROW(kp::OpTensorSyncDevice(
+      tensors, std::vector<kp::TensorRange>{ { largeOffset, 1 } }));
+    EXPECT_ANY_THROW(kp::TensorView(tensors[0], largeOffset, 1));
+}
+
+TEST(TestTensorChunking, LargeTensorIsBoundAsDescriptorArray)
+{
+    kp::Manager mgr;
+
+    uint64_t maxRange = mgr.getDeviceProperties().limits.maxStorageBufferRange;
+    if (maxRange > 256 * 1024 * 1024) {
+        GTEST_SKIP() << "maxStorageBufferRange of " << maxRange
+                     << " bytes is too large to allocate in a test";
+    }
+
+    std::shared_ptr<kp::TensorT<float>> tensor =
+      mgr.emptyTensorT<float>(maxRange / sizeof(float) + 1024);
+
+    ASSERT_EQ(tensor->descriptorCount(), 2);
+    uint64_t chunkSize = tensor->descriptorChunkSize();
+    EXPECT_LE(chunkSize * sizeof(float), maxRange);
+
+    std::string shader(R"(
+        #version 450
+
+        layout (local_size_x = 1) in;
+
+        layout(set = 0, binding = 0) buffer Chunk { float data[]; } chunks[2];
+
+        void main() {
+            chunks[0].data[0] = 1.0;
+            chunks[1].data[0] = 2.0;
+        }
+    )");
+
+    kp::Workgroup workgroup = { 1, 1, 1 };
+    std::shared_ptr<kp::Algorithm> algo =
+      mgr.algorithm({ tensor }, compileSource(shader), workgroup);
+
+    mgr.sequence()
+      ->record<kp::OpTensorFill>({ tensor })
+      ->record<kp::OpAlgoDispatch>(algo)
+      ->record<kp::OpTensorSyncLocal>({ tensor })
+      ->eval();
+
+    EXPECT_EQ(tensor->data()[0], 1.0f);
+    EXPECT_EQ(tensor->data()[1], 0.0f);
+    EXPECT_EQ(tensor->data()[chunkSize], 2.0f);
+}
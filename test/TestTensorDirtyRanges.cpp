@@ -0,0 +1,168 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+static std::vector<std::pair<uint64_t, uint64_t>>
+toPairs(const std::vector<kp::TensorRange>& ranges)
+{
+    std::vector<std::pair<uint64_t, uint64_t>> pairs;
+    for (const kp::TensorRange& range : ranges) {
+        pairs.push_back({ range.offset, range.size });
+    }
+    return pairs;
+}
+
+TEST(TestTensorDirtyRanges, RangesAreCoalesced)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor =
+      mgr.tensor(std::vector<float>(100, 0));
+
+    // The whole tensor is dirty after creation
+    EXPECT_EQ(toPairs(tensor->dirtyRanges()),
+              (std::vector<std::pair<uint64_t, uint64_t>>{ { 0, 100 } }));
+
+    tensor->clearDirty();
+    EXPECT_FALSE(tensor->isDirty());
+
+    tensor->markDirty(10, 5);
+    tensor->markDirty(50, 10);
+    tensor->markDirty(15, 5);
+    tensor->markDirty(0, 2);
+    EXPECT_EQ(toPairs(tensor->dirtyRanges()),
+              (std::vector<std::pair<uint64_t, uint64_t>>{
+                { 0, 2 }, { 10, 10 }, { 50, 10 } }));
+
+    tensor->markDirty(5, 50);
+    EXPECT_EQ(toPairs(tensor->dirtyRanges()),
+              (std::vector<std::pair<uint64_t, uint64_t>>{ { 0, 2 },
+                                                           { 5, 55 } }));
+
+    tensor->clearDirty({ { 20, 10 } });
+    EXPECT_EQ(toPairs(tensor->dirtyRanges()),
+              (std::vector<std::pair<uint64_t, uint64_t>>{
+                { 0, 2 }, { 5, 15 }, { 30, 30 } }));
+}
+
+TEST(TestTensorDirtyRanges, TypedSettersMarkDirty)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor =
+      mgr.tensor(std::vector<float>(10, 0));
+    tensor->clearDirty();
+
+    tensor->set(3, 1);
+    tensor->set(4, 1);
+    tensor->setData(8, { 2, 2 });
+
+    EXPECT_EQ(toPairs(tensor->dirtyRanges()),
+              (std::vector<std::pair<uint64_t, uint64_t>>{ { 3, 2 },
+                                                           { 8, 2 } }));
+    EXPECT_ANY_THROW(tensor->set(10, 1));
+
+    // Element access does not mark the elements as dirty
+    float sum = 0;
+    for (uint64_t i = 0; i < tensor->size(); i++) {
+        sum += (*tensor)[i];
+    }
+    EXPECT_EQ(sum, 6);
+    (*tensor)[6] = 5;
+    EXPECT_EQ(toPairs(tensor->dirtyRanges()),
+              (std::vector<std::pair<uint64_t, uint64_t>>{ { 3, 2 },
+                                                           { 8, 2 } }));
+
+    tensor->setData(std::vector<float>(10, 3));
+    EXPECT_EQ(toPairs(tensor->dirtyRanges()),
+              (std::vector<std::pair<uint64_t, uint64_t>>{ { 0, 10 } }));
+}
+
+TEST(TestTensorDirtyRanges, SyncDirtyOnlyUploadsModifiedBytes)
+{
+    kp::Manager mgr;
+
+    // Unified memory tensors do not upload any bytes
+    mgr.setUnifiedMemory(false);
+
+    uint32_t size = 1024;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA =
+      mgr.tensor(std::vector<float>(size, 0));
+    std::shared_ptr<kp::TensorT<float>> tensorB =
+      mgr.tensor(std::vector<float>(size, 0));
+
+    std::shared_ptr<kp::Sequence> sq = mgr.sequence();
+
+    sq->eval<kp::OpTensorSyncDevice>({ tensorA, tensorB }, true);
+
+    EXPECT_FALSE(tensorA->isDirty());
+    EXPECT_EQ(tensorA->bytesUploaded(), size * sizeof(float));
+    EXPECT_EQ(tensorA->bytesSkipped(), 0);
+
+    tensorA->set(10, 1);
+    tensorA->setData(500, { 2, 3 });
+
+    sq->eval<kp::OpTensorSyncDevice>({ tensorA, tensorB }, true)
+      ->eval<kp::OpTensorCopy>({ tensorA, tensorB });
+
+    EXPECT_EQ(tensorA->bytesUploaded(), (size + 3) * sizeof(float));
+    EXPECT_EQ(tensorA->bytesSkipped(), (size - 3) * sizeof(float));
+
+    // Clean tensors are skipped entirely
+    EXPECT_EQ(tensorB->bytesUploaded(), size * sizeof(float));
+    EXPECT_EQ(tensorB->bytesSkipped(), size * sizeof(float));
+
+    tensorB->setData(std::vector<float>(size, 0));
+    tensorB->clearDirty();
+    sq->eval<kp::OpTensorSyncLocal>({ tensorB });
+
+    std::vector<float> expected(size, 0);
+    expected[10] = 1;
+    expected[500] = 2;
+    expected[501] = 3;
+    EXPECT_EQ(tensorB->vector(), expected);
+}
+
+TEST(TestTensorDirtyRanges, SyncDirtyOnlyReplaysNewRanges)
+{
+    kp::Manager mgr;
+
+    // Unified memory tensors do not upload any bytes
+    mgr.setUnifiedMemory(false);
+
+    uint32_t size = 1024;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA =
+      mgr.tensor(std::vector<float>(size, 0));
+    std::shared_ptr<kp::TensorT<float>> tensorB =
+      mgr.tensor(std::vector<float>(size, 0));
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()
+        ->record<kp::OpTensorSyncDevice>({ tensorA }, true)
+        ->record<kp::OpTensorCopy>({ tensorA, tensorB })
+        ->eval();
+
+    // The recorded sequence is replayed after different writes, which have
+    // to be uploaded rather than the ranges dirty when it was recorded
+    tensorA->set(10, 1);
+    sq->eval();
+    tensorA->setData(500, { 2, 3 });
+    sq->eval();
+
+    EXPECT_FALSE(tensorA->isDirty());
+    EXPECT_EQ(tensorA->bytesUploaded(), (size + 3) * sizeof(float));
+    EXPECT_EQ(tensorA->bytesSkipped(), (2 * size - 3) * sizeof(float));
+
+    mgr.sequence()->eval<kp::OpTensorSyncLocal>({ tensorB });
+
+    std::vector<float> expected(size, 0);
+    expected[10] = 1;
+    expected[500] = 2;
+    expected[501] = 3;
+    EXPECT_EQ(tensorB->vector(), expected);
+}
@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+TEST(TestTensorRebuild, SmallerDataReusesBuffers)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor =
+      mgr.tensor({ 1, 2, 3, 4, 5, 6, 7, 8 });
+    void* rawData = tensor->rawData();
+
+    EXPECT_EQ(tensor->capacity(), 8);
+
+    tensor->rebuild({ 9, 10 });
+
+    EXPECT_TRUE(tensor->isInit());
+    EXPECT_EQ(tensor->size(), 2);
+    EXPECT_EQ(tensor->capacity(), 8);
+    EXPECT_EQ(tensor->rawData(), rawData);
+    EXPECT_EQ(tensor->vector(), std::vector<float>({ 9, 10 }));
+
+    mgr.sequence()->eval<kp::OpTensorSyncDevice>({ tensor });
+    tensor->setData({ 0, 0 });
+    mgr.sequence()->eval<kp::OpTensorSyncLocal>({ tensor });
+    EXPECT_EQ(tensor->vector(), std::vector<float>({ 9, 10 }));
+}
+
+TEST(TestTensorRebuild, CapacityGrowsGeometrically)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor =
+      mgr.tensor(std::vector<float>(10, 1));
+
+    tensor->rebuild(std::vector<float>(11, 2));
+    EXPECT_EQ(tensor->size(), 11);
+    EXPECT_EQ(tensor->capacity(), 20);
+    EXPECT_EQ(tensor->vector(), std::vector<float>(11, 2));
+
+    void* rawData = tensor->rawData();
+    tensor->rebuild(std::vector<float>(20, 3));
+    EXPECT_EQ(tensor->capacity(), 20);
+    EXPECT_EQ(tensor->rawData(), rawData);
+
+    tensor->rebuild(std::vector<float>(100, 4));
+    EXPECT_EQ(tensor->capacity(), 100);
+}
+
+TEST(TestTensorRebuild, AlgorithmDescriptorsFollowRebuild)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3, 4 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 2, 2, 2, 2 });
+    std::shared_ptr<kp::TensorT<float>> tensorOut = mgr.emptyTensor(4);
+
+    std::string shader(R"(
+        #version 450
+
+        layout (local_size_x = 1) in;
+
+        layout(set = 0, binding = 0) buffer bina { float tina[]; };
+        layout(set = 0, binding = 1) buffer binb { float tinb[]; };
+        layout(set = 0, binding = 2) buffer bout { float tout[]; };
+
+        void main() {
+            uint index = gl_GlobalInvocationID.x;
+            tout[index] = tina[index] * tinb[index];
+        }
+    )");
+
+    std::shared_ptr<kp::Algorithm> algo = mgr.algorithm(
+      { tensorA, tensorB, tensorOut }, compileSource(shader));
+
+    std::shared_ptr<kp::Sequence> sq = mgr.sequence();
+
+    sq->record<kp::OpTensorSyncDevice>({ tensorA, tensorB })
+      ->record<kp::OpAlgoDispatch>(algo)
+      ->record<kp::OpTensorSyncLocal>({ tensorOut })
+      ->eval();
+    EXPECT_EQ(tensorOut->vector(), std::vector<float>({ 2, 4, 6, 8 }));
+
+    // Growing reallocates the buffers bound to the algorithm
+    tensorA->rebuild({ 1, 2, 3, 4, 5, 6, 7, 8 });
+    tensorB->rebuild(std::vector<float>(8, 3));
+    tensorOut->rebuild(std::vector<float>(8, 0));
+    algo->setWorkgroup({ 8, 1, 1 });
+
+    sq->record<kp::OpTensorSyncDevice>({ tensorA, tensorB, tensorOut })
+      ->record<kp::OpAlgoDispatch>(algo)
+      ->record<kp::OpTensorSyncLocal>({ tensorOut })
+      ->eval();
+    EXPECT_EQ(tensorOut->vector(),
+              std::vector<float>({ 3, 6, 9, 12, 15, 18, 21, 24 }));
+
+    // Shrinking keeps the buffers but changes the bound range
+    tensorA->rebuild({ 5, 6 });
+    tensorB->rebuild({ 2, 2 });
+    tensorOut->rebuild({ 0, 0 });
+    algo->setWorkgroup({ 2, 1, 1 });
+
+    sq->record<kp::OpTensorSyncDevice>({ tensorA, tensorB })
+      ->record<kp::OpAlgoDispatch>(algo)
+      ->record<kp::OpTensorSyncLocal>({ tensorOut })
+      ->eval();
+    EXPECT_EQ(tensorOut->vector(), std::vector<float>({ 10, 12 }));
+}
+
+TEST(TestTensorRebuild, RecordedSequencesFollowRebuild)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3, 4 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 2, 2, 2, 2 });
+    std::shared_ptr<kp::TensorT<float>> tensorOut = mgr.emptyTensor(4);
+
+    std::string shader(R"(
+        #version 450
+
+        layout (local_size_x = 1) in;
+
+        layout(set = 0, binding = 0) buffer bina { float tina[]; };
+        layout(set = 0, binding = 1) buffer binb { float tinb[]; };
+        layout(set = 0, binding = 2) buffer bout { float tout[]; };
+
+        void main() {
+            uint index = gl_GlobalInvocationID.x;
+            tout[index] = tina[index] * tinb[index];
+        }
+    )");
+
+    std::shared_ptr<kp::Algorithm> algo = mgr.algorithm(
+      { tensorA, tensorB, tensorOut }, compileSource(shader));
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()
+        ->record<kp::OpTensorSyncDevice>({ tensorA, tensorB })
+        ->record<kp::OpAlgoDispatch>(algo)
+        ->record<kp::OpTensorSyncLocal>({ tensorOut })
+        ->eval();
+    EXPECT_EQ(tensorOut->vector(), std::vector<float>({ 2, 4, 6, 8 }));
+
+    std::shared_ptr<kp::Sequence> sqOther =
+      mgr.sequence()
+        ->record<kp::OpAlgoDispatch>(algo)
+        ->record<kp::OpTensorSyncLocal>({ tensorOut })
+        ->eval();
+
+    // Growing past the capacity frees the buffers that both sequences were
+    // recorded with, so these are recorded again when evaluated
+    uint64_t capacity = tensorA->capacity();
+    tensorA->rebuild({ 1, 2, 3, 4, 5, 6, 7, 8 });
+    tensorB->rebuild(std::vector<float>(8, 3));
+    tensorOut->rebuild(std::vector<float>(8, 0));
+    EXPECT_GT(tensorA->capacity(), capacity);
+
+    sq->eval();
+    EXPECT_EQ(tensorOut->vector(),
+              std::vector<float>({ 3, 6, 9, 12, 0, 0, 0, 0 }));
+
+    // The descriptor set was written again by the first sequence
+    tensorOut->setData(std::vector<float>(8, 1));
+    sqOther->eval();
+    EXPECT_EQ(tensorOut->vector(),
+              std::vector<float>({ 3, 6, 9, 12, 0, 0, 0, 0 }));
+}
@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+// Offset of 256 elements (1024 bytes) which satisfies the maximum allowed
+// minStorageBufferOffsetAlignment of 256 bytes
+static const uint32_t HALF_SIZE = 256;
+
+TEST(TestTensorView, ViewSharesDataWithTensor)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor =
+      mgr.tensor({ 0, 1, 2, 3, 4, 5 });
+
+    std::shared_ptr<kp::TensorView> view{ new kp::TensorView(tensor, 2, 3) };
+
+    EXPECT_TRUE(view->isInit());
+    EXPECT_EQ(view->size(), 3);
+    EXPECT_EQ(view->offset(), 2 * sizeof(float));
+    EXPECT_EQ(view->dataType(), tensor->dataType());
+    EXPECT_EQ(view->vector<float>(), std::vector<float>({ 2, 3, 4 }));
+
+    view->data<float>()[0] = 10;
+    EXPECT_EQ(tensor->vector(), std::vector<float>({ 0, 1, 10, 3, 4, 5 }));
+
+    std::shared_ptr<kp::TensorView> subView{ new kp::TensorView(view, 1, 2) };
+    EXPECT_EQ(subView->offset(), 3 * sizeof(float));
+    EXPECT_EQ(subView->vector<float>(), std::vector<float>({ 3, 4 }));
+}
+
+TEST(TestTensorView, ViewOutOfBoundsThrows)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 0, 1, 2 });
+
+    EXPECT_ANY_THROW(kp::TensorView(tensor, 2, 2));
+    EXPECT_ANY_THROW(kp::TensorView(tensor, 0, 0));
+}
+
+TEST(TestTensorView, SyncAndCopyViews)
+{
+    kp::Manager mgr;
+
+    std::vector<float> data(2 * HALF_SIZE, 0);
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor(data);
+
+    std::shared_ptr<kp::Tensor> viewA{ new kp::TensorView(
+      tensor, 0, HALF_SIZE) };
+    std::shared_ptr<kp::Tensor> viewB{ new kp::TensorView(
+      tensor, HALF_SIZE, HALF_SIZE) };
+
+    mgr.sequence()->eval<kp::OpTensorSyncDevice>({ tensor });
+
+    // Only the first half is synced to the device and copied to the second
+    for (uint32_t i = 0; i < HALF_SIZE; i++) {
+        viewA->data<float>()[i] = i;
+    }
+
+    mgr.sequence()
+      ->eval<kp::OpTensorSyncDevice>({ viewA })
+      ->eval<kp::OpTensorCopy>({ viewA, viewB });
+
+    // Reset the host memory to ensure the data comes back from the device
+    tensor->setData(data);
+
+    mgr.sequence()->eval<kp::OpTensorSyncLocal>({ tensor });
+
+    for (uint32_t i = 0; i < HALF_SIZE; i++) {
+        EXPECT_EQ(tensor->data()[i], i);
+        EXPECT_EQ(tensor->data()[HALF_SIZE + i], i);
+    }
+}
+
+TEST(TestTensorView, AlgorithmBindsViewsOfSameTensor)
+{
+    kp::Manager mgr;
+
+    std::string shader(R"(
+        #version 450
+
+        layout (local_size_x = 1) in;
+
+        layout(set = 0, binding = 0) buffer a { float pa[]; };
+        layout(set = 0, binding = 1) buffer b { float pb[]; };
+
+        void main() {
+            uint index = gl_GlobalInvocationID.x;
+            pb[index] = pa[index] + pb[index];
+        }
+    )");
+
+    std::vector<float> data(2 * HALF_SIZE, 1);
+    for (uint32_t i = HALF_SIZE; i < 2 * HALF_SIZE; i++) {
+        data[i] = 2;
+    }
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor(data);
+
+    std::shared_ptr<kp::Tensor> viewA{ new kp::TensorView(
+      tensor, 0, HALF_SIZE) };
+    std::shared_ptr<kp::Tensor> viewB{ new kp::TensorView(
+      tensor, HALF_SIZE, HALF_SIZE) };
+
+    std::shared_ptr<kp::Algorithm> algo =
+      mgr.algorithm({ viewA, viewB }, compileSource(shader));
+
+    mgr.sequence()
+      ->record<kp::OpTensorSyncDevice>({ tensor })
+      ->record<kp::OpAlgoDispatch>(algo)
+      ->record<kp::OpTensorSyncLocal>({ tensor })
+      ->eval();
+
+    for (uint32_t i = 0; i < HALF_SIZE; i++) {
+        EXPECT_EQ(tensor->data()[i], 1);
+        EXPECT_EQ(tensor->data()[HALF_SIZE + i], 3);
+    }
+}
+
+TEST(TestTensorView, ViewFollowsRebuiltTensor)
+{
+    kp::Manager mgr;
+
+    std::string shader(R"(
+        #version 450
+
+        layout (local_size_x = 1) in;
+
+        layout(set = 0, binding = 0) buffer a { float pa[]; };
+
+        void main() {
+            uint index = gl_GlobalInvocationID.x;
+            pa[index] = pa[index] * 2;
+        }
+    )");
+
+    std::shared_ptr<kp::TensorT<float>> tensor =
+      mgr.tensor(std::vector<float>(2 * HALF_SIZE, 0));
+
+    std::shared_ptr<kp::Tensor> view{ new kp::TensorView(
+      tensor, HALF_SIZE, HALF_SIZE) };
+
+    std::shared_ptr<kp::Algorithm> algo =
+      mgr.algorithm({ view }, compileSource(shader));
+
+    // Growing past the capacity reallocates the resources of the tensor,
+    // which the view has to bind instead of the freed ones
+    uint64_t generation = view->generation();
+    tensor->rebuild(std::vector<float>(4 * HALF_SIZE, 1));
+    EXPECT_NE(view->generation(), generation);
+    EXPECT_EQ(view->vector<float>(), std::vector<float>(HALF_SIZE, 1));
+
+    mgr.sequence()
+      ->record<kp::OpTensorSyncDevice>({ tensor })
+      ->record<kp::OpAlgoDispatch>(algo)
+      ->record<kp::OpTensorSyncLocal>({ tensor })
+      ->eval();
+
+    std::vector<float> expected(4 * HALF_SIZE, 1);
+    for (uint32_t i = HALF_SIZE; i < 2 * HALF_SIZE; i++) {
+        expected[i] = 2;
+    }
+    EXPECT_EQ(tensor->vector(), expected);
+
+    // The view can no longer be used once the tensor does not cover it
+    tensor->rebuild(std::vector<float>(HALF_SIZE, 1));
+    EXPECT_FALSE(view->isInit());
+    EXPECT_ANY_THROW(mgr.sequence()->eval<kp::OpTensorSyncDevice>({ view }));
+}
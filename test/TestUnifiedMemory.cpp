@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+static const std::string MULTIPLY_SHADER(R"(
+    #version 450
+
+    layout (local_size_x = 1) in;
+
+    layout(set = 0, binding = 0) buffer bina { float tina[]; };
+    layout(set = 0, binding = 1) buffer binb { float tinb[]; };
+    layout(set = 0, binding = 2) buffer bout { float tout[]; };
+
+    void main() {
+        uint index = gl_GlobalInvocationID.x;
+        tout[index] = tina[index] * tinb[index];
+    }
+)");
+
+TEST(TestUnifiedMemory, EnabledByDefault)
+{
+    kp::Manager mgr;
+
+    EXPECT_TRUE(mgr.getUnifiedMemory());
+
+    mgr.setUnifiedMemory(false);
+    EXPECT_FALSE(mgr.getUnifiedMemory());
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 1, 2, 3 });
+    EXPECT_FALSE(tensor->isUnifiedMemory());
+}
+
+TEST(TestUnifiedMemory, DeviceTensorsSyncThroughBarriers)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 2, 2, 2 });
+    std::shared_ptr<kp::TensorT<float>> tensorOut = mgr.tensor({ 0, 0, 0 });
+
+    // Host and storage tensors are not affected
+    std::shared_ptr<kp::TensorT<float>> tensorHost =
+      mgr.tensor({ 0, 0, 0 }, kp::Tensor::TensorTypes::eHost);
+    EXPECT_FALSE(tensorHost->isUnifiedMemory());
+
+    KP_LOG_INFO("Unified memory available: {}", tensorA->isUnifiedMemory());
+
+    std::shared_ptr<kp::Algorithm> algo = mgr.algorithm(
+      { tensorA, tensorB, tensorOut }, compileSource(MULTIPLY_SHADER));
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()
+        ->record<kp::OpTensorSyncDevice>({ tensorA, tensorB })
+        ->record<kp::OpAlgoDispatch>(algo)
+        ->record<kp::OpTensorSyncLocal>({ tensorOut });
+
+    sq->eval();
+    EXPECT_EQ(tensorOut->vector(), std::vector<float>({ 2, 4, 6 }));
+
+    tensorA->setData({ 3, 4, 5 });
+    sq->eval();
+    EXPECT_EQ(tensorOut->vector(), std::vector<float>({ 6, 8, 10 }));
+
+    // Nothing is transferred when the primary buffer is mapped directly
+    if (tensorA->isUnifiedMemory()) {
+        EXPECT_EQ(tensorA->bytesUploaded(), 0);
+    }
+}
+
+TEST(TestUnifiedMemory, StagingRingIsBypassed)
+{
+    kp::Manager mgr;
+
+    mgr.enableStagingRing(1024 * 1024);
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()
+        ->record<kp::OpTensorSyncDevice>({ tensorA })
+        ->record<kp::OpTensorCopy>({ tensorA, tensorB })
+        ->record<kp::OpTensorSyncLocal>({ tensorB });
+
+    if (tensorA->isUnifiedMemory()) {
+        EXPECT_EQ(mgr.getStagingRing()->usedSize(), 0);
+    }
+
+    sq->eval();
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 1, 2, 3 }));
+}
+
+TEST(TestUnifiedMemory, ViewsOfUnifiedTensors)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor =
+      mgr.tensor(std::vector<float>(512, 1));
+    std::shared_ptr<kp::TensorView> view{ new kp::TensorView(
+      tensor, 256, 256) };
+
+    EXPECT_EQ(view->isUnifiedMemory(), tensor->isUnifiedMemory());
+
+    std::shared_ptr<kp::TensorT<float>> tensorOut =
+      mgr.tensor(std::vector<float>(256, 0));
+
+    mgr.sequence()
+      ->record<kp::OpTensorSyncDevice>({ tensor })
+      ->record<kp::OpTensorCopy>({ view, tensorOut })
+      ->record<kp::OpTensorSyncLocal>({ tensorOut })
+      ->eval();
+
+    EXPECT_EQ(tensorOut->vector(), std::vector<float>(256, 1));
+}